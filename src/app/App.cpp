@@ -22,6 +22,7 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <fstream>
 #include <functional>
 
 #include <QDockWidget>
@@ -32,6 +33,9 @@
 #include <di/core/Connection.h>
 #include <di/core/Filesystem.h>
 #include <di/core/StringUtils.h>
+#include <di/core/Trace.h>
+#include <di/core/AllocationTracker.h>
+#include <di/core/FrameStatistics.h>
 
 #include <di/algorithms/SurfaceLIC.h>
 #include <di/algorithms/RenderTriangles.h>
@@ -39,6 +43,7 @@
 #include <di/algorithms/RenderIllustrativeLines.h>
 #include <di/algorithms/RenderPoints.h>
 #include <di/algorithms/ExtractRegions.h>
+#include <di/algorithms/ExtractSubmesh.h>
 #include <di/algorithms/Voxelize.h>
 #include <di/algorithms/Dilatate.h>
 #include <di/algorithms/GaussSmooth.h>
@@ -50,8 +55,10 @@
 #include <di/gui/AlgorithmStrategies.h>
 #include <di/gui/AlgorithmStrategy.h>
 #include <di/gui/AlgorithmWidget.h>
+#include <di/gui/CommandObserverQt.h>
 #include <di/gui/DataWidget.h>
 #include <di/gui/FileWidget.h>
+#include <di/gui/LabelSeriesWidget.h>
 #include <di/gui/MainWindow.h>
 
 #include <di/core/Logger.h>
@@ -94,6 +101,46 @@ namespace di
                     m_screenShotPath = argument.substr( len, argument.length() - len );
                     LogD << "Commandline: screenshot-path set to \"" << m_screenShotPath << "\"." << LogEnd;
                 }
+                else if( argument.find( "--log-level=" ) == 0 )
+                {
+                    auto len = std::string( "--log-level=" ).length();
+                    auto level = di::core::Logger::getLevel();
+                    if( di::core::Logger::parseLevel( argument.substr( len, argument.length() - len ), level ) )
+                    {
+                        di::core::Logger::setLevel( level );
+                    }
+                    else
+                    {
+                        LogW << "Commandline: unknown log level in \"" << arg << "\". Use debug, info, warning or error." << LogEnd;
+                    }
+                }
+                else if( argument.find( "--trace=" ) == 0 )
+                {
+                    // NOTE: use the original arg, no lower case path.
+                    auto len = std::string( "--trace=" ).length();
+                    m_tracePath = arg.substr( len, arg.length() - len );
+                    di::core::Trace::setEnabled( true );
+                    di::core::Trace::setThreadName( "UI" );
+                    LogD << "Commandline: tracing to \"" << m_tracePath << "\"." << LogEnd;
+                }
+                else if( argument.find( "--frame-stats=" ) == 0 )
+                {
+                    // NOTE: use the original arg, no lower case path.
+                    auto len = std::string( "--frame-stats=" ).length();
+                    m_frameStatsPath = arg.substr( len, arg.length() - len );
+                    LogD << "Commandline: writing frame statistics to \"" << m_frameStatsPath << "\"." << LogEnd;
+                }
+                else if( argument.find( "--allocation-stats=" ) == 0 )
+                {
+                    // NOTE: use the original arg, no lower case path.
+                    auto len = std::string( "--allocation-stats=" ).length();
+                    m_allocationStatsPath = arg.substr( len, arg.length() - len );
+                    if( !di::core::AllocationTracker::isEnabled() )
+                    {
+                        LogW << "Commandline: allocation statistics need a build with DI_ALLOCATION_TRACKING. Counts will be zero." << LogEnd;
+                    }
+                    LogD << "Commandline: writing allocation statistics to \"" << m_allocationStatsPath << "\"." << LogEnd;
+                }
                 else
                 {
                     // We assume all arguments to be filenames
@@ -121,7 +168,8 @@ namespace di
             else
             {
                 LogD << "Network marked dirty. Requesting update." << LogEnd;
-                getProcessingNetwork()->runNetwork();
+                // The main window shows the progress in its status bar.
+                getProcessingNetwork()->runNetwork( std::make_shared< di::gui::CommandObserverQt >( getMainWindow() ) );
             }
         }
 
@@ -153,12 +201,16 @@ namespace di
             algoWidget->setLayout( layout );
             m_tbDock->setWidget( algoWidget );
 
+            // Restrict everything to the region of interest
+            m_extractSubmesh = new di::gui::AlgorithmWidget( SPtr< di::core::Algorithm >( new di::algorithms::ExtractSubmesh ) );
+
             // Take the mesh data and extract the region information needed
             m_extractRegions = new di::gui::AlgorithmWidget( SPtr< di::core::Algorithm >( new di::algorithms::ExtractRegions ) );
 
             // Handle different vis strategies here
             m_algorithmStrategies = new di::gui::AlgorithmStrategies( algoWidget );
 
+            layout->addWidget( m_extractSubmesh );
             layout->addWidget( m_extractRegions );
             layout->addWidget( m_algorithmStrategies );
 
@@ -195,6 +247,10 @@ namespace di
                                                         QString( "Region Label Order File (*.labelorder)" ) );
             m_dataWidget->addFileWidget( m_labelOrderFile );
 
+            // Play time series of labels through the label file widget
+            m_labelSeries = new di::gui::LabelSeriesWidget( m_labelFile );
+            m_dataWidget->addWidget( m_labelSeries );
+
             // Create the strategies:
             // Strategy 1:
             auto s = m_algorithmStrategies->addStrategy( new di::gui::AlgorithmStrategy( "Surface with Region Boundaries" ) );
@@ -216,22 +272,31 @@ namespace di
             m_extractRegions->prepareProcessingNetwork();
             m_algorithmStrategies->prepareProcessingNetwork();
 
+            // Added last to keep the runtime names of the other algorithms and thus existing project files.
+            m_extractSubmesh->prepareProcessingNetwork();
+
             // Connect everything in strategy 1
             // getProcessingNetwork()->connectAlgorithms( algo1->getAlgorithm(), "Neighbour Arrows", algo10->getAlgorithm(), "Lines" );
 
-            // Connect all modules with a "Triangle Mesh" input.
+            // Connect all modules with a "Triangle Mesh" input. They get the region of interest.
             getProcessingNetwork()->connectAlgorithms( m_meshFile->getDataInject(), "Data",
-                                                       m_extractRegions->getAlgorithm(), "Triangle Mesh" );
+                                                       m_extractSubmesh->getAlgorithm(), "Triangle Mesh" );
             getProcessingNetwork()->connectAlgorithms( m_labelFile->getDataInject(), "Data",
+                                                       m_extractSubmesh->getAlgorithm(), "Triangle Labels" );
+
+            getProcessingNetwork()->connectAlgorithms( m_extractSubmesh->getAlgorithm(), "Triangle Mesh",
+                                                       m_extractRegions->getAlgorithm(), "Triangle Mesh" );
+            getProcessingNetwork()->connectAlgorithms( m_extractSubmesh->getAlgorithm(), "Triangle Labels",
                                                        m_extractRegions->getAlgorithm(), "Triangle Labels" );
             getProcessingNetwork()->connectAlgorithms( m_labelOrderFile->getDataInject(), "Data",
                                                        m_extractRegions->getAlgorithm(), "Label Ordering" );
 
-            getProcessingNetwork()->connectAlgorithms( m_labelFile->getDataInject(), "Data",
+            getProcessingNetwork()->connectAlgorithms( m_extractSubmesh->getAlgorithm(), "Triangle Labels",
                                                        renderArrows->getAlgorithm(), "Labels" );
 
-            getProcessingNetwork()->connectAlgorithms( m_meshFile->getDataInject(), "Data", renderArrows->getAlgorithm(), "Triangle Mesh" );
-            getProcessingNetwork()->connectAlgorithms( m_meshFile->getDataInject(), "Data", lic->getAlgorithm(), "Triangle Mesh" );
+            getProcessingNetwork()->connectAlgorithms( m_extractSubmesh->getAlgorithm(), "Triangle Mesh",
+                                                       renderArrows->getAlgorithm(), "Triangle Mesh" );
+            getProcessingNetwork()->connectAlgorithms( m_extractSubmesh->getAlgorithm(), "Triangle Mesh", lic->getAlgorithm(), "Triangle Mesh" );
             getProcessingNetwork()->connectAlgorithms( m_extractRegions->getAlgorithm(), "Directionality",
                                                        renderArrows->getAlgorithm(), "Directions" );
             // getProcessingNetwork()->connectAlgorithms( m_extractRegions->getAlgorithm(), "Region Mesh as Lines",
@@ -293,6 +358,34 @@ namespace di
 
         void App::close()
         {
+            if( !m_tracePath.empty() )
+            {
+                di::core::Trace::writeChromeTrace( m_tracePath );
+            }
+            if( !m_frameStatsPath.empty() )
+            {
+                std::ofstream file( m_frameStatsPath );
+                if( file )
+                {
+                    di::core::FrameStatistics::write( file );
+                }
+                else
+                {
+                    LogE << "Could not write frame statistics to \"" << m_frameStatsPath << "\"." << LogEnd;
+                }
+            }
+            if( !m_allocationStatsPath.empty() )
+            {
+                std::ofstream file( m_allocationStatsPath );
+                if( file )
+                {
+                    di::core::AllocationTracker::write( file );
+                }
+                else
+                {
+                    LogE << "Could not write allocation statistics to \"" << m_allocationStatsPath << "\"." << LogEnd;
+                }
+            }
             LogD << "Shutdown. Bye!" << LogEnd;
         }
 
@@ -42,6 +42,7 @@ namespace di
         class ViewWidget;
         class AlgorithmWidget;
         class FileWidget;
+        class LabelSeriesWidget;
     }
 
     namespace app
@@ -147,6 +148,11 @@ namespace di
              */
             di::gui::AlgorithmWidget* m_extractRegions = nullptr;
 
+            /**
+             * The region of interest selection.
+             */
+            di::gui::AlgorithmWidget* m_extractSubmesh = nullptr;
+
             /**
              * Algorithm property dock
              */
@@ -172,6 +178,11 @@ namespace di
              */
             gui::FileWidget* m_labelFile = nullptr;
 
+            /**
+             * Widget to play label time series.
+             */
+            gui::LabelSeriesWidget* m_labelSeries = nullptr;
+
             /**
              * Widget to handle mesh files.
              */
@@ -186,6 +197,21 @@ namespace di
              * The path where to store the screenshots. Needs to be absolute.
              */
             std::string m_screenShotPath;
+
+            /**
+             * If not empty, tracing is enabled and the Chrome trace gets written to this file on shutdown.
+             */
+            std::string m_tracePath;
+
+            /**
+             * If not empty, the frame and render pass timings get written to this file on shutdown.
+             */
+            std::string m_frameStatsPath;
+
+            /**
+             * If not empty, the heap allocations per algorithm run and visualization update get written to this file on shutdown.
+             */
+            std::string m_allocationStatsPath;
         };
     }
 }
@@ -0,0 +1,235 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include <di/core/AllocationTracker.h>
+
+#include "Benchmark.h"
+
+namespace di
+{
+    namespace bench
+    {
+        namespace
+        {
+            /**
+             * Escape a string for use as JSON string value.
+             *
+             * \param str the string
+             *
+             * \return the escaped string, without quotes.
+             */
+            std::string escapeJSON( const std::string& str )
+            {
+                std::string result;
+                result.reserve( str.size() );
+                for( auto c : str )
+                {
+                    if( ( c == '"' ) || ( c == '\\' ) )
+                    {
+                        result.push_back( '\\' );
+                    }
+                    result.push_back( c );
+                }
+                return result;
+            }
+        }
+
+        BenchmarkRunner::BenchmarkRunner()
+        {
+        }
+
+        BenchmarkRunner::~BenchmarkRunner()
+        {
+        }
+
+        void BenchmarkRunner::setMinRepetitions( size_t repetitions )
+        {
+            m_minRepetitions = std::max< size_t >( 1, repetitions );
+        }
+
+        void BenchmarkRunner::setMinTime( double seconds )
+        {
+            m_minTime = std::max( 0.0, seconds );
+        }
+
+        void BenchmarkRunner::setFilter( const std::string& filter )
+        {
+            m_filter = filter;
+        }
+
+        bool BenchmarkRunner::isSelected( const std::string& name ) const
+        {
+            return m_filter.empty() || ( name.find( m_filter ) != std::string::npos );
+        }
+
+        void BenchmarkRunner::run( const std::string& name, size_t size, size_t items, std::function< void() > function )
+        {
+            if( !isSelected( name ) )
+            {
+                return;
+            }
+
+            typedef std::chrono::steady_clock Clock;
+            typedef core::AllocationTracker::Counters Counters;
+            Counters allocations = { 0, 0 };
+            auto measure = [ &function ]( Counters* counters )
+            {
+                auto startAllocations = core::AllocationTracker::getThreadCounters();
+                auto start = Clock::now();
+                function();
+                auto time = std::chrono::duration< double >( Clock::now() - start ).count();
+                auto endAllocations = core::AllocationTracker::getThreadCounters();
+                counters->m_allocations += endAllocations.m_allocations - startAllocations.m_allocations;
+                counters->m_bytes += endAllocations.m_bytes - startAllocations.m_bytes;
+                return time;
+            };
+
+            // Fast functions are affected by cold caches and lazy initialization. Use the first call as warm-up in this case. Slow functions
+            // are not repeated more often than needed.
+            std::vector< double > times;
+            Counters warmUpAllocations = { 0, 0 };
+            auto first = measure( &warmUpAllocations );
+            if( first >= 0.1 * m_minTime )
+            {
+                times.push_back( first );
+                allocations = warmUpAllocations;
+            }
+
+            double total = first;
+            while( ( times.size() < m_minRepetitions ) || ( total < m_minTime ) )
+            {
+                auto time = measure( &allocations );
+                times.push_back( time );
+                total += time;
+            }
+
+            auto repetitions = static_cast< double >( times.size() );
+            add( name, size, items, times, static_cast< double >( allocations.m_allocations ) / repetitions,
+                 static_cast< double >( allocations.m_bytes ) / repetitions );
+        }
+
+        void BenchmarkRunner::add( const std::string& name, size_t size, size_t items, std::vector< double > times, double allocations,
+                                   double bytes )
+        {
+            if( times.empty() )
+            {
+                return;
+            }
+
+            // Statistics:
+            std::sort( times.begin(), times.end() );
+            BenchmarkResult result;
+            result.m_name = name;
+            result.m_size = size;
+            result.m_items = items;
+            result.m_repetitions = times.size();
+            result.m_min = times.front();
+            result.m_max = times.back();
+            result.m_median = ( times.size() % 2 ) ? times[ times.size() / 2 ] :
+                                                     0.5 * ( times[ times.size() / 2 - 1 ] + times[ times.size() / 2 ] );
+            result.m_mean = std::accumulate( times.begin(), times.end(), 0.0 ) / static_cast< double >( times.size() );
+
+            double variance = 0.0;
+            for( auto t : times )
+            {
+                variance += ( t - result.m_mean ) * ( t - result.m_mean );
+            }
+            result.m_stdDev = std::sqrt( variance / static_cast< double >( times.size() ) );
+            result.m_allocations = allocations;
+            result.m_bytes = bytes;
+
+            m_results.push_back( result );
+
+            // Keep the user informed. The results themselves are written to stdout or a file.
+            std::cerr << std::left << std::setw( 40 ) << name << std::right << std::setw( 10 ) << size
+                      << std::setw( 14 ) << std::scientific << std::setprecision( 3 ) << result.m_median << " s"
+                      << "  (" << result.m_repetitions << " repetitions";
+            if( core::AllocationTracker::isEnabled() )
+            {
+                std::cerr << ", " << std::defaultfloat << std::setprecision( 6 ) << allocations << " allocations";
+            }
+            std::cerr << ")" << std::defaultfloat << std::endl;
+        }
+
+        const std::vector< BenchmarkResult >& BenchmarkRunner::getResults() const
+        {
+            return m_results;
+        }
+
+        void BenchmarkRunner::writeJSON( std::ostream& out ) const
+        {
+            out << std::setprecision( 9 );
+            out << "{" << std::endl;
+            out << "  \"context\": {" << std::endl;
+            out << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << "," << std::endl;
+            out << "    \"compiler\": \"" << escapeJSON( __VERSION__ ) << "\"," << std::endl;
+            out << "    \"min_repetitions\": " << m_minRepetitions << "," << std::endl;
+            out << "    \"min_time\": " << m_minTime << "," << std::endl;
+            out << "    \"allocation_tracking\": " << ( core::AllocationTracker::isEnabled() ? "true" : "false" ) << std::endl;
+            out << "  }," << std::endl;
+            out << "  \"benchmarks\": [" << std::endl;
+            for( size_t i = 0; i < m_results.size(); ++i )
+            {
+                const auto& r = m_results[ i ];
+                out << "    { "
+                    << "\"name\": \"" << escapeJSON( r.m_name ) << "\", "
+                    << "\"size\": " << r.m_size << ", "
+                    << "\"items\": " << r.m_items << ", "
+                    << "\"repetitions\": " << r.m_repetitions << ", "
+                    << "\"min\": " << r.m_min << ", "
+                    << "\"median\": " << r.m_median << ", "
+                    << "\"mean\": " << r.m_mean << ", "
+                    << "\"max\": " << r.m_max << ", "
+                    << "\"stddev\": " << r.m_stdDev << ", "
+                    << "\"items_per_second\": " << ( r.m_median > 0.0 ? static_cast< double >( r.m_items ) / r.m_median : 0.0 ) << ", "
+                    << "\"allocations\": " << r.m_allocations << ", "
+                    << "\"allocated_bytes\": " << r.m_bytes
+                    << " }" << ( ( i + 1 < m_results.size() ) ? "," : "" ) << std::endl;
+            }
+            out << "  ]" << std::endl;
+            out << "}" << std::endl;
+        }
+
+        void BenchmarkRunner::writeCSV( std::ostream& out ) const
+        {
+            out << std::setprecision( 9 );
+            out << "name,size,items,repetitions,min,median,mean,max,stddev,items_per_second,allocations,allocated_bytes" << std::endl;
+            for( const auto& r : m_results )
+            {
+                out << "\"" << r.m_name << "\"," << r.m_size << "," << r.m_items << "," << r.m_repetitions << ","
+                    << r.m_min << "," << r.m_median << "," << r.m_mean << "," << r.m_max << "," << r.m_stdDev << ","
+                    << ( r.m_median > 0.0 ? static_cast< double >( r.m_items ) / r.m_median : 0.0 ) << ","
+                    << r.m_allocations << "," << r.m_bytes << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,215 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_BENCHMARK_H
+#define DI_BENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace di
+{
+    namespace bench
+    {
+        /**
+         * The timings of a single benchmark at a single problem size. All times are in seconds.
+         */
+        struct BenchmarkResult
+        {
+            /**
+             * Name of the benchmark. Usually the name of the measured function.
+             */
+            std::string m_name;
+
+            /**
+             * The problem size. For meshes, this is the number of vertices. For grids, the number of voxels.
+             */
+            size_t m_size;
+
+            /**
+             * How many items where processed per repetition. Used to calculate the throughput.
+             */
+            size_t m_items;
+
+            /**
+             * How often the benchmark was repeated.
+             */
+            size_t m_repetitions;
+
+            /**
+             * Fastest repetition.
+             */
+            double m_min;
+
+            /**
+             * Median repetition time.
+             */
+            double m_median;
+
+            /**
+             * Mean repetition time.
+             */
+            double m_mean;
+
+            /**
+             * Slowest repetition.
+             */
+            double m_max;
+
+            /**
+             * Standard deviation of the repetition times.
+             */
+            double m_stdDev;
+
+            /**
+             * Mean number of heap allocations per repetition. Only measured if compiled with DI_ALLOCATION_TRACKING.
+             */
+            double m_allocations = 0.0;
+
+            /**
+             * Mean number of heap allocated bytes per repetition. Only measured if compiled with DI_ALLOCATION_TRACKING.
+             */
+            double m_bytes = 0.0;
+        };
+
+        /**
+         * Runs benchmark functions repeatedly and collects their timings. A function is repeated at least the minimum number of repetitions and
+         * until the minimum time has passed.
+         */
+        class BenchmarkRunner
+        {
+        public:
+            /**
+             * Create a runner with default settings.
+             */
+            BenchmarkRunner();
+
+            /**
+             * Destructor.
+             */
+            virtual ~BenchmarkRunner();
+
+            /**
+             * Set the minimum number of timed repetitions per benchmark and size.
+             *
+             * \param repetitions the number of repetitions. At least 1.
+             */
+            void setMinRepetitions( size_t repetitions );
+
+            /**
+             * Set the minimum total time spent in a benchmark per size.
+             *
+             * \param seconds the time in seconds
+             */
+            void setMinTime( double seconds );
+
+            /**
+             * Only run benchmarks whose name contains the given string. Empty means all benchmarks.
+             *
+             * \param filter the filter string.
+             */
+            void setFilter( const std::string& filter );
+
+            /**
+             * Check whether the benchmark with the given name passes the filter. Use this to avoid creating expensive input data for benchmarks
+             * that are not run anyway.
+             *
+             * \param name the benchmark name
+             *
+             * \return true if the benchmark should run.
+             */
+            bool isSelected( const std::string& name ) const;
+
+            /**
+             * Run a benchmark. The function is called once untimed as warm-up if it is fast enough, then repeatedly. The result is stored.
+             *
+             * \param name the name of the benchmark
+             * \param size the problem size
+             * \param items the number of items processed per call of the function.
+             * \param function the function to measure
+             */
+            void run( const std::string& name, size_t size, size_t items, std::function< void() > function );
+
+            /**
+             * Add a result from timings that where measured elsewhere, like the frames of a rendering benchmark. The filter is not applied.
+             *
+             * \param name the name of the benchmark
+             * \param size the problem size
+             * \param items the number of items processed per measured call.
+             * \param times the measured times in seconds. Must not be empty.
+             * \param allocations mean number of heap allocations per measured call, if known.
+             * \param bytes mean number of heap allocated bytes per measured call, if known.
+             */
+            void add( const std::string& name, size_t size, size_t items, std::vector< double > times, double allocations = 0.0,
+                      double bytes = 0.0 );
+
+            /**
+             * Get all results collected so far.
+             *
+             * \return the results in the order they where run.
+             */
+            const std::vector< BenchmarkResult >& getResults() const;
+
+            /**
+             * Write the results as JSON.
+             *
+             * \param out the stream to write to
+             */
+            void writeJSON( std::ostream& out ) const;
+
+            /**
+             * Write the results as CSV, one line per benchmark and size.
+             *
+             * \param out the stream to write to
+             */
+            void writeCSV( std::ostream& out ) const;
+        protected:
+        private:
+            /**
+             * Minimum repetitions.
+             */
+            size_t m_minRepetitions = 3;
+
+            /**
+             * Minimum time in seconds.
+             */
+            double m_minTime = 0.5;
+
+            /**
+             * Name filter.
+             */
+            std::string m_filter;
+
+            /**
+             * The results.
+             */
+            std::vector< BenchmarkResult > m_results;
+        };
+    }
+}
+
+#endif  // DI_BENCHMARK_H
+
@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <di/core/data/GridRegular.h>
+#include <di/core/data/GridTransformation.h>
+
+#include "BenchmarkData.h"
+
+namespace di
+{
+    namespace bench
+    {
+        /**
+         * The size of the label patches in vertices along each direction.
+         */
+        const size_t PatchSize = 16;
+
+        /**
+         * The number of different region labels.
+         */
+        const size_t NumLabels = 10;
+
+        BenchmarkSurface createSurface( size_t numVertices )
+        {
+            size_t side = std::max< size_t >( 2, static_cast< size_t >( std::ceil( std::sqrt( static_cast< double >( numVertices ) ) ) ) );
+            float spacing = 1.0f / static_cast< float >( side - 1 );
+
+            BenchmarkSurface result;
+            result.m_mesh = std::make_shared< core::TriangleMesh >();
+            result.m_colors = std::make_shared< RGBAArray >();
+            result.m_colors->reserve( side * side );
+
+            auto regionLabels = std::make_shared< io::RegionLabelReader::AttributeType >();
+            auto continuousLabels = std::make_shared< io::RegionLabelReader::AttributeType >();
+            regionLabels->reserve( side * side );
+            continuousLabels->reserve( side * side );
+
+            for( size_t y = 0; y < side; ++y )
+            {
+                for( size_t x = 0; x < side; ++x )
+                {
+                    float fx = spacing * static_cast< float >( x );
+                    float fy = spacing * static_cast< float >( y );
+                    result.m_mesh->addVertex( fx, fy, 0.05f * std::sin( 10.0f * fx ) * std::cos( 10.0f * fy ) );
+
+                    // 3 and 5 are co-prime to NumLabels -> neighbouring patches never share a label.
+                    size_t label = ( 3 * ( x / PatchSize ) + 5 * ( y / PatchSize ) ) % NumLabels;
+                    regionLabels->push_back( static_cast< double >( label ) );
+                    continuousLabels->push_back( static_cast< double >( x + y ) );
+
+                    float shade = static_cast< float >( label ) / static_cast< float >( NumLabels );
+                    result.m_colors->push_back( glm::vec4( shade, 1.0f - shade, 0.5f, 1.0f ) );
+                }
+            }
+
+            for( size_t y = 0; y < side - 1; ++y )
+            {
+                for( size_t x = 0; x < side - 1; ++x )
+                {
+                    size_t i = y * side + x;
+                    result.m_mesh->addTriangle( i, i + 1, i + side );
+                    result.m_mesh->addTriangle( i + 1, i + side + 1, i + side );
+                }
+            }
+
+            result.m_mesh->calculateNormals();
+            result.m_mesh->calculateInverseIndex();
+            result.m_dataSet = std::make_shared< core::TriangleDataSet >( "Benchmark Surface", result.m_mesh, result.m_colors );
+
+            auto labelOrder = std::make_shared< io::RegionLabelReader::AttributeType >();
+            for( size_t l = 0; l < NumLabels; ++l )
+            {
+                labelOrder->push_back( static_cast< double >( l ) );
+            }
+
+            result.m_regionLabels = std::make_shared< io::RegionLabelReader::DataSetType >( "Region Labels", regionLabels );
+            result.m_continuousLabels = std::make_shared< io::RegionLabelReader::DataSetType >( "Continuous Labels", continuousLabels );
+            result.m_labelOrder = std::make_shared< io::RegionLabelReader::DataSetType >( "Label Order", labelOrder );
+            return result;
+        }
+
+        SPtr< core::DataSetScalarRegular3d > createVolume( size_t numVoxels )
+        {
+            size_t side = std::max< size_t >( 3, static_cast< size_t >( std::ceil( std::cbrt( static_cast< double >( numVoxels ) ) ) ) );
+            auto grid = std::make_shared< core::GridRegular3 >( core::GridTransformation< 3 >( glm::mat4( 1.0f ) ), side, side, side );
+            auto values = std::make_shared< std::vector< double > >( grid->getSize(), 0.0 );
+
+            double center = 0.5 * static_cast< double >( side - 1 );
+            double radius = static_cast< double >( side ) / 3.0;
+            for( size_t z = 0; z < side; ++z )
+            {
+                for( size_t y = 0; y < side; ++y )
+                {
+                    for( size_t x = 0; x < side; ++x )
+                    {
+                        double dx = static_cast< double >( x ) - center;
+                        double dy = static_cast< double >( y ) - center;
+                        double dz = static_cast< double >( z ) - center;
+                        ( *values )[ grid->index( x, y, z ) ] = ( dx * dx + dy * dy + dz * dz <= radius * radius ) ? 1.0 : 0.0;
+                    }
+                }
+            }
+
+            return std::make_shared< core::DataSetScalarRegular3d >( "Benchmark Volume", grid, values );
+        }
+
+        /**
+         * Append the raw bytes of a value to a buffer. Byte order is the one of the host.
+         *
+         * \tparam ValueType the type of the value
+         * \param buffer the buffer
+         * \param value the value to append
+         */
+        template< typename ValueType >
+        void appendRaw( std::vector< char >& buffer, const ValueType& value )
+        {
+            char raw[ sizeof( ValueType ) ];
+            std::memcpy( raw, &value, sizeof( ValueType ) );
+            buffer.insert( buffer.end(), raw, raw + sizeof( ValueType ) );
+        }
+
+        void writePly( const std::string& filename, const core::TriangleMesh& mesh, const RGBAArray& colors )
+        {
+            std::ofstream file( filename, std::ios::binary );
+            if( !file )
+            {
+                throw std::ios_base::failure( "Failed to open " + filename + " for writing." );
+            }
+
+            // NOTE: we assume a little endian host here. This is the case for all platforms we support.
+            file << "ply" << std::endl
+                 << "format binary_little_endian 1.0" << std::endl
+                 << "element vertex " << mesh.getNumVertices() << std::endl
+                 << "property float x" << std::endl
+                 << "property float y" << std::endl
+                 << "property float z" << std::endl
+                 << "property uchar red" << std::endl
+                 << "property uchar green" << std::endl
+                 << "property uchar blue" << std::endl
+                 << "element face " << mesh.getNumTriangles() << std::endl
+                 << "property list uchar int vertex_index" << std::endl
+                 << "end_header" << std::endl;
+
+            std::vector< char > buffer;
+            buffer.reserve( mesh.getNumVertices() * ( 3 * sizeof( float ) + 3 ) );
+            for( size_t i = 0; i < mesh.getNumVertices(); ++i )
+            {
+                auto v = mesh.getVertex( i );
+                appendRaw( buffer, v.x );
+                appendRaw( buffer, v.y );
+                appendRaw( buffer, v.z );
+                for( size_t c = 0; c < 3; ++c )
+                {
+                    appendRaw( buffer, static_cast< std::uint8_t >( 255.0f * colors[ i ][ c ] ) );
+                }
+            }
+            file.write( buffer.data(), buffer.size() );
+
+            buffer.clear();
+            buffer.reserve( mesh.getNumTriangles() * ( 1 + 3 * sizeof( std::int32_t ) ) );
+            for( const auto& t : mesh.getTriangles() )
+            {
+                appendRaw( buffer, static_cast< std::uint8_t >( 3 ) );
+                appendRaw( buffer, static_cast< std::int32_t >( t.x ) );
+                appendRaw( buffer, static_cast< std::int32_t >( t.y ) );
+                appendRaw( buffer, static_cast< std::int32_t >( t.z ) );
+            }
+            file.write( buffer.data(), buffer.size() );
+        }
+
+        void writeLabels( const std::string& filename, const io::RegionLabelReader::AttributeType& labels )
+        {
+            std::ofstream file( filename );
+            if( !file )
+            {
+                throw std::ios_base::failure( "Failed to open " + filename + " for writing." );
+            }
+
+            for( auto l : labels )
+            {
+                file << static_cast< int >( l ) << "\n";
+            }
+        }
+    }
+}
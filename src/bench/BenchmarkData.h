@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_BENCHMARKDATA_H
+#define DI_BENCHMARKDATA_H
+
+#include <string>
+#include <vector>
+
+#include <di/Types.h>
+#include <di/GfxTypes.h>
+
+#include <di/core/data/TriangleMesh.h>
+#include <di/core/data/TriangleDataSet.h>
+#include <di/core/data/DataSetTypes.h>
+#include <di/io/RegionLabelReader.h>
+
+namespace di
+{
+    namespace bench
+    {
+        /**
+         * A synthetic surface along with the label data needed by the algorithms. The surface is a regular, slightly bumpy height field. Its
+         * vertices are ordered row by row, as in typical scanned or generated meshes.
+         */
+        struct BenchmarkSurface
+        {
+            /**
+             * The mesh. Normals and inverse index are already calculated.
+             */
+            SPtr< core::TriangleMesh > m_mesh;
+
+            /**
+             * Per-vertex colors.
+             */
+            SPtr< RGBAArray > m_colors;
+
+            /**
+             * The mesh and its colors as dataset.
+             */
+            SPtr< core::TriangleDataSet > m_dataSet;
+
+            /**
+             * Per-vertex region labels. The surface is split into square patches. Neighbouring patches always have different labels.
+             */
+            SPtr< io::RegionLabelReader::DataSetType > m_regionLabels;
+
+            /**
+             * Per-vertex continuous labels, increasing along the surface.
+             */
+            SPtr< io::RegionLabelReader::DataSetType > m_continuousLabels;
+
+            /**
+             * The ordering of the labels in m_regionLabels.
+             */
+            SPtr< io::RegionLabelReader::DataSetType > m_labelOrder;
+        };
+
+        /**
+         * Create a surface with approximately the given number of vertices. The exact number is the next square number.
+         *
+         * \param numVertices the desired number of vertices
+         *
+         * \return the surface.
+         */
+        BenchmarkSurface createSurface( size_t numVertices );
+
+        /**
+         * Create a cubic volume with approximately the given number of voxels. It contains a binary sphere mask.
+         *
+         * \param numVoxels the desired number of voxels. The exact number is the next cube number.
+         *
+         * \return the volume
+         */
+        SPtr< core::DataSetScalarRegular3d > createVolume( size_t numVoxels );
+
+        /**
+         * Write the mesh as binary PLY file, including colors.
+         *
+         * \param filename the file to write
+         * \param mesh the mesh
+         * \param colors the colors. One per vertex.
+         */
+        void writePly( const std::string& filename, const core::TriangleMesh& mesh, const RGBAArray& colors );
+
+        /**
+         * Write labels in the format understood by the RegionLabelReader.
+         *
+         * \param filename the file to write
+         * \param labels the labels
+         */
+        void writeLabels( const std::string& filename, const io::RegionLabelReader::AttributeType& labels );
+    }
+}
+
+#endif  // DI_BENCHMARKDATA_H
+
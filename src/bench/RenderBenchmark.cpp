@@ -0,0 +1,505 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <di/core/AllocationTracker.h>
+#include <di/core/Logger.h>
+#include <di/core/StringUtils.h>
+#include <di/core/Conversion.h>
+#include <di/core/Filesystem.h>
+#include <di/core/FrameStatistics.h>
+#include <di/core/BoundingBox.h>
+#include <di/core/Visualization.h>
+#include <di/gfx/FrameUniforms.h>
+#include <di/gfx/GL.h>
+#include <di/gfx/HeadlessContext.h>
+#include <di/gfx/OffscreenView.h>
+#include <di/MathTypes.h>
+
+#include <di/algorithms/ExtractRegions.h>
+#include <di/algorithms/GenerateMesh.h>
+#include <di/algorithms/RenderIllustrativeLines.h>
+#include <di/algorithms/RenderTriangles.h>
+#include <di/algorithms/SurfaceLIC.h>
+
+#include "Benchmark.h"
+
+/**
+ * A visualization to benchmark and the timings collected for it.
+ */
+struct RenderTarget
+{
+    /**
+     * The name used in the results.
+     */
+    std::string m_name;
+
+    /**
+     * The algorithm. Needed to provide the input data.
+     */
+    di::SPtr< di::core::Algorithm > m_algorithm;
+
+    /**
+     * The same object, as visualization.
+     */
+    di::SPtr< di::core::Visualization > m_visualization;
+};
+
+/**
+ * Print the usage information.
+ */
+void printUsage()
+{
+    std::cerr <<
+    "Usage: di_render_bench [options]" << std::endl <<
+    "  --vertices=N        number of mesh vertices. Default: 100000." << std::endl <<
+    "  --regions=N         number of regions on the mesh. Default: 24." << std::endl <<
+    "  --torus             render a torus instead of a sphere." << std::endl <<
+    "  --frames=N          number of frames of the camera orbit. Default: 60." << std::endl <<
+    "  --width=N           width of the offscreen view. Default: 1024." << std::endl <<
+    "  --height=N          height of the offscreen view. Default: 768." << std::endl <<
+    "  --samples=N         multi-sampling of the offscreen view. Default: 1." << std::endl <<
+    "  --filter=STRING     only benchmark visualizations whose name contains STRING." << std::endl <<
+    "  --hardware          use the default OpenGL driver instead of forcing Mesa llvmpipe." << std::endl <<
+    "  --backend=NAME      how to create the OpenGL context. Either auto, egl or osmesa. Default: auto." << std::endl <<
+    "  --format=FORMAT     output format. Either json or csv. Default: json." << std::endl <<
+    "  --output=FILE       write results to FILE instead of stdout." << std::endl <<
+    "  --image=PREFIX      write the last frame of each visualization to PREFIX<name>.ppm." << std::endl;
+}
+
+/**
+ * Time a function. As OpenGL works asynchronously, the function is followed by glFinish to include the GPU time.
+ *
+ * \param function the function to measure
+ *
+ * \return the time in seconds
+ */
+template< typename FunctionType >
+double timeGL( FunctionType function )
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    glFinish();
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+/**
+ * Write an image as binary PPM. Useful to check what was actually benchmarked.
+ *
+ * \param image the image
+ * \param filename the file to write
+ */
+void writePPM( const di::core::RGBA8Image& image, const std::string& filename )
+{
+    std::ofstream file( filename, std::ios::binary );
+    if( !file )
+    {
+        std::cerr << "Could not open \"" << filename << "\" for writing." << std::endl;
+        return;
+    }
+
+    file << "P6" << std::endl << image.getWidth() << " " << image.getHeight() << std::endl << "255" << std::endl;
+
+    // OpenGL images start at the bottom.
+    for( size_t y = image.getHeight(); y > 0; --y )
+    {
+        for( size_t x = 0; x < image.getWidth(); ++x )
+        {
+            auto pixel = image( x, y - 1 );
+            file.put( static_cast< char >( pixel.r ) );
+            file.put( static_cast< char >( pixel.g ) );
+            file.put( static_cast< char >( pixel.b ) );
+        }
+    }
+}
+
+/**
+ * Render a camera orbit around the scene of the given visualizations and record the timings. This mirrors the frame of the UI: update all
+ * visualizations, clear the view and render them.
+ *
+ * \param runner where to store the results
+ * \param targets the visualizations to render together
+ * \param name the name prefix of the results
+ * \param size the problem size stored in the results
+ * \param view the view to render to. Needs to be prepared.
+ * \param frames the number of frames of the orbit
+ * \param image if not empty, write the last frame to this file
+ */
+void renderOrbit( di::bench::BenchmarkRunner& runner, const std::vector< RenderTarget >& targets, const std::string& name, size_t size,
+                  di::core::OffscreenView& view, size_t frames, const std::string& image )
+{
+    // The visualizations record the GPU time of their render passes. Only keep those of this orbit.
+    di::core::FrameStatistics::clear();
+
+    di::core::BoundingBox sceneBB;
+    for( const auto& target : targets )
+    {
+        target.m_visualization->prepare();
+        sceneBB.include( target.m_visualization->getBoundingBox() );
+    }
+
+    // The camera parameters of the UI at default zoom.
+    float zoom = 1.0f;
+    float near = 0.3f;
+    float far = zoom * sqrt( 3.0f ) + near;
+
+    di::core::Camera camera;
+    camera.setProjectionMatrix( di::core::buildProjectionMatrix( near, far, view.getAspectRatio() ) );
+
+    std::vector< std::vector< double > > updateTimes( targets.size() );
+    std::vector< std::vector< double > > renderTimes( targets.size() );
+    std::vector< double > initialUpdateTimes( targets.size(), 0.0 );
+    std::vector< double > frameTimes;
+    di::core::FrameUniforms frameUniforms;
+
+    for( size_t frame = 0; frame < frames; ++frame )
+    {
+        // One full turn around the vertical axis, slightly tilted to avoid symmetric views.
+        float angle = 2.0f * glm::pi< float >() * static_cast< float >( frame ) / static_cast< float >( frames );
+        glm::mat4 orientation = glm::rotate( glm::radians( 20.0f ), glm::vec3( 1.0f, 0.0f, 0.0f ) ) *
+                                glm::rotate( angle, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+        camera.setViewMatrix( di::core::buildViewMatrix( sceneBB, orientation, zoom ) );
+        view.setCamera( camera );
+
+        auto frameStart = std::chrono::steady_clock::now();
+
+        for( size_t i = 0; i < targets.size(); ++i )
+        {
+            auto time = timeGL(
+                [ & ]()
+                {
+                    di::core::AllocationScope allocations( name + "/" + targets[ i ].m_name + "::update" );
+                    view.bind();
+                    targets[ i ].m_visualization->update( view, false );
+                }
+            );
+
+            // The first update uploads the data. Report it separately as it is not part of the steady state.
+            if( frame == 0 )
+            {
+                initialUpdateTimes[ i ] = time;
+            }
+            else
+            {
+                updateTimes[ i ].push_back( time );
+            }
+        }
+
+        view.bind();
+        glViewport( 0, 0, view.getViewportSize().x, view.getViewportSize().y );
+        glClearColor( 1.0f, 1.0f, 1.0f, 1.0f );
+        glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+        glDepthMask( GL_TRUE );
+        glEnable( GL_BLEND );
+        glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+        glEnable( GL_DEPTH_TEST );
+        frameUniforms.update( view );
+
+        for( size_t i = 0; i < targets.size(); ++i )
+        {
+            auto time = timeGL(
+                [ & ]()
+                {
+                    view.bind();
+                    targets[ i ].m_visualization->render( view );
+                }
+            );
+
+            // The driver compiles shaders and allocates lazily during the first frame. Treat it as warm-up.
+            if( frame != 0 )
+            {
+                renderTimes[ i ].push_back( time );
+            }
+        }
+        glFinish();
+
+        if( frame != 0 )
+        {
+            frameTimes.push_back( std::chrono::duration< double >( std::chrono::steady_clock::now() - frameStart ).count() );
+        }
+    }
+
+    if( !image.empty() )
+    {
+        writePPM( *view.read(), image );
+    }
+
+    // Each result counts frames as items, so the throughput is the frame rate.
+    for( size_t i = 0; i < targets.size(); ++i )
+    {
+        std::string prefix = name + "/" + targets[ i ].m_name;
+        runner.add( prefix + "::update/initial", size, 1, { initialUpdateTimes[ i ] } );
+        runner.add( prefix + "::update", size, 1, updateTimes[ i ] );
+        runner.add( prefix + "::render", size, 1, renderTimes[ i ] );
+    }
+    runner.add( name + "/frame", size, 1, frameTimes );
+
+    for( const auto& series : di::core::FrameStatistics::getAll() )
+    {
+        auto times = di::core::FrameStatistics::getRecent( series.m_name );
+        for( auto& time : times )
+        {
+            time *= 1e-3;
+        }
+        runner.add( name + "/gpu/" + series.m_name, size, 1, times );
+    }
+
+    for( const auto& target : targets )
+    {
+        target.m_visualization->finalize();
+    }
+    frameUniforms.finalize();
+}
+
+/**
+ * Create a visualization algorithm and store it in the list.
+ *
+ * \tparam VisType the visualization type
+ * \param targets the list to add the visualization to
+ * \param name the name used in the results
+ */
+template< typename VisType >
+void addTarget( std::vector< RenderTarget >& targets, const std::string& name )
+{
+    auto vis = std::make_shared< VisType >();
+    targets.push_back( { name, vis, vis } );
+}
+
+int main( int argc, char** argv )
+{
+    size_t numVertices = 100000;
+    size_t numRegions = 24;
+    bool torus = false;
+    size_t frames = 60;
+    size_t width = 1024;
+    size_t height = 768;
+    int samples = 1;
+    bool software = true;
+    auto backend = di::core::HeadlessContext::Backend::Auto;
+    std::string filter;
+    std::string format = "json";
+    std::string output;
+    std::string image;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg( argv[ i ] );
+        auto pos = arg.find( '=' );
+        auto key = di::core::toLower( arg.substr( 0, pos ) );
+        auto value = ( pos == std::string::npos ) ? std::string() : arg.substr( pos + 1 );
+
+        try
+        {
+            if( key == "--vertices" )
+            {
+                numVertices = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--regions" )
+            {
+                numRegions = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--torus" )
+            {
+                torus = true;
+            }
+            else if( key == "--frames" )
+            {
+                frames = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--width" )
+            {
+                width = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--height" )
+            {
+                height = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--samples" )
+            {
+                samples = di::core::fromString< int >( value );
+            }
+            else if( key == "--filter" )
+            {
+                filter = value;
+            }
+            else if( key == "--hardware" )
+            {
+                software = false;
+            }
+            else if( ( key == "--backend" ) && di::core::HeadlessContext::parseBackend( value, backend ) )
+            {
+                continue;
+            }
+            else if( key == "--format" )
+            {
+                format = di::core::toLower( value );
+            }
+            else if( key == "--output" )
+            {
+                output = value;
+            }
+            else if( key == "--image" )
+            {
+                image = value;
+            }
+            else
+            {
+                printUsage();
+                return ( key == "--help" ) ? 0 : 1;
+            }
+        }
+        catch( const std::exception& )
+        {
+            std::cerr << "Invalid value in \"" << arg << "\"." << std::endl;
+            return 1;
+        }
+    }
+
+    if( ( ( format != "json" ) && ( format != "csv" ) ) || ( frames < 2 ) || ( width == 0 ) || ( height == 0 ) || ( samples < 1 ) )
+    {
+        printUsage();
+        return 1;
+    }
+
+    // The algorithms log a lot of debug information. This is not what we want to measure.
+    di::core::Logger::setLevel( di::core::LogLevel::Warning );
+
+    // The shaders are searched relative to the executable.
+    std::string executable( argv[ 0 ] );
+    auto separator = executable.find_last_of( "/\\" );
+    di::core::initRuntimePath( ( separator == std::string::npos ) ? "." : executable.substr( 0, separator ) );
+
+    di::core::HeadlessContext context;
+    if( !context.create( backend, software ) )
+    {
+        std::cerr << "Could not create a headless OpenGL context: " << context.getError() << std::endl;
+        return 1;
+    }
+    std::cerr << "Renderer: " << context.getRenderer() << " - OpenGL " << context.getVersion() << std::endl;
+
+    // Data: a generated mesh with regions and the directions between them.
+    auto generator = std::make_shared< di::algorithms::GenerateMesh >();
+    generator->getParameter( "Torus" )->fromString( torus ? "1" : "0" );
+    generator->getParameter( "Vertices" )->fromString( std::to_string( numVertices ) );
+    generator->getParameter( "Regions" )->fromString( std::to_string( numRegions ) );
+    generator->getParameter( "Ordered Regions" )->fromString( std::to_string( numRegions ) );
+    generator->process();
+
+    auto mesh = generator->getOutput( "Triangle Mesh" )->getTransferable();
+    auto labels = generator->getOutput( "Triangle Labels" )->getTransferable();
+
+    auto extract = std::make_shared< di::algorithms::ExtractRegions >();
+    extract->getInput( "Triangle Mesh" )->setTransferable( mesh );
+    extract->getInput( "Triangle Labels" )->setTransferable( labels );
+    extract->getInput( "Label Ordering" )->setTransferable( generator->getOutput( "Label Ordering" )->getTransferable() );
+    extract->process();
+    auto directions = extract->getOutput( "Directionality" )->getTransferable();
+
+    std::vector< RenderTarget > targets;
+    addTarget< di::algorithms::SurfaceLIC >( targets, "SurfaceLIC" );
+    addTarget< di::algorithms::RenderIllustrativeLines >( targets, "RenderIllustrativeLines" );
+    addTarget< di::algorithms::RenderTriangles >( targets, "RenderTriangles" );
+
+    std::vector< RenderTarget > selected;
+    for( const auto& target : targets )
+    {
+        if( !filter.empty() && ( target.m_name.find( filter ) == std::string::npos ) )
+        {
+            continue;
+        }
+
+        // Not all visualizations have all inputs.
+        for( auto input : target.m_algorithm->getInputs() )
+        {
+            if( input->getName() == "Triangle Mesh" )
+            {
+                input->setTransferable( mesh );
+            }
+            else if( input->getName() == "Directions" )
+            {
+                input->setTransferable( directions );
+            }
+            else if( input->getName() == "Labels" )
+            {
+                input->setTransferable( labels );
+            }
+        }
+        target.m_algorithm->process();
+        selected.push_back( target );
+    }
+
+    di::bench::BenchmarkRunner runner;
+    auto view = std::make_shared< di::core::OffscreenView >( glm::vec2( width, height ), samples );
+    view->prepare();
+
+    // Each visualization on its own, then all of them together, as in the UI.
+    for( const auto& target : selected )
+    {
+        renderOrbit( runner, { target }, target.m_name, numVertices, *view, frames, image.empty() ? "" : image + target.m_name + ".ppm" );
+    }
+    if( selected.size() > 1 )
+    {
+        renderOrbit( runner, selected, "All", numVertices, *view, frames, image.empty() ? "" : image + "All.ppm" );
+    }
+
+    view->finalize();
+
+    std::ofstream file;
+    if( !output.empty() )
+    {
+        file.open( output );
+        if( !file )
+        {
+            std::cerr << "Could not open \"" << output << "\" for writing." << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+
+    if( format == "csv" )
+    {
+        runner.writeCSV( out );
+    }
+    else
+    {
+        runner.writeJSON( out );
+    }
+
+    if( di::core::AllocationTracker::isEnabled() )
+    {
+        di::core::AllocationTracker::write( std::cerr );
+    }
+
+    di::core::Logger::flush();
+    return 0;
+}
+
@@ -0,0 +1,380 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <di/core/Logger.h>
+#include <di/core/StringUtils.h>
+#include <di/core/Conversion.h>
+#include <di/core/data/GridRegular.h>
+
+#include <di/algorithms/Dilatate.h>
+#include <di/algorithms/ExtractRegions.h>
+#include <di/algorithms/GaussSmooth.h>
+#include <di/algorithms/GenerateMesh.h>
+#include <di/algorithms/Voxelize.h>
+
+#include <di/io/PlyReader.h>
+#include <di/io/RegionLabelReader.h>
+
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+
+/**
+ * Keep the compiler from removing computations whose results are not used otherwise.
+ *
+ * \param value the value to consume
+ */
+void consume( size_t value )
+{
+    static volatile size_t sink = 0;
+    sink = sink + value;
+}
+
+/**
+ * Print the usage information.
+ */
+void printUsage()
+{
+    std::cerr <<
+    "Usage: di_bench [options]" << std::endl <<
+    "  --min-vertices=N    smallest problem size. Default: 1000." << std::endl <<
+    "  --max-vertices=N    largest problem size. Sizes grow by a factor of 10. Default: 10000000." << std::endl <<
+    "  --filter=STRING     only run benchmarks whose name contains STRING." << std::endl <<
+    "  --repetitions=N     minimum number of timed repetitions. Default: 3." << std::endl <<
+    "  --min-time=SECONDS  minimum time to spend per benchmark and size. Default: 0.5." << std::endl <<
+    "  --format=FORMAT     output format. Either json or csv. Default: json." << std::endl <<
+    "  --output=FILE       write results to FILE instead of stdout." << std::endl <<
+    "  --temp-dir=DIR      where to write the files for the reader benchmarks. Default: $TMPDIR or /tmp." << std::endl;
+}
+
+/**
+ * Run all benchmarks on meshes of the given size.
+ *
+ * \param runner the runner to use
+ * \param numVertices the mesh size
+ * \param tempDir directory for temporary files
+ */
+void runMeshBenchmarks( di::bench::BenchmarkRunner& runner, size_t numVertices, const std::string& tempDir )
+{
+    auto surface = di::bench::createSurface( numVertices );
+    auto mesh = surface.m_mesh;
+    size_t size = mesh->getNumVertices();
+
+    runner.run( "TriangleMesh::calculateNormals", size, size,
+        [ & ]()
+        {
+            mesh->calculateNormals();
+        }
+    );
+
+    runner.run( "TriangleMesh::calculateInverseIndex", size, mesh->getNumTriangles(),
+        [ & ]()
+        {
+            mesh->calculateInverseIndex();
+        }
+    );
+
+    runner.run( "TriangleMesh::getNeighbourVertices", size, size,
+        [ & ]()
+        {
+            size_t count = 0;
+            for( size_t vertexID = 0; vertexID < mesh->getNumVertices(); ++vertexID )
+            {
+                count += mesh->getNeighbourVertices( vertexID ).size();
+            }
+            consume( count );
+        }
+    );
+
+    // Extract regions, case 1: labels are interpreted as continuous values.
+    if( runner.isSelected( "ExtractRegions::process/continuous" ) )
+    {
+        auto algorithm = std::make_shared< di::algorithms::ExtractRegions >();
+        algorithm->getInput( "Triangle Mesh" )->setTransferable( surface.m_dataSet );
+        algorithm->getInput( "Triangle Labels" )->setTransferable( surface.m_continuousLabels );
+        runner.run( "ExtractRegions::process/continuous", size, size,
+            [ & ]()
+            {
+                // Same inputs each repetition. Measure the processing, not the reuse of the last result.
+                algorithm->invalidate();
+                algorithm->process();
+            }
+        );
+    }
+
+    // Extract regions, case 2: labels define regions and a label ordering defines the direction.
+    if( runner.isSelected( "ExtractRegions::process/ordered" ) )
+    {
+        auto algorithm = std::make_shared< di::algorithms::ExtractRegions >();
+        algorithm->getInput( "Triangle Mesh" )->setTransferable( surface.m_dataSet );
+        algorithm->getInput( "Triangle Labels" )->setTransferable( surface.m_regionLabels );
+        algorithm->getInput( "Label Ordering" )->setTransferable( surface.m_labelOrder );
+        runner.run( "ExtractRegions::process/ordered", size, size,
+            [ & ]()
+            {
+                algorithm->invalidate();
+                algorithm->process();
+            }
+        );
+    }
+
+    if( runner.isSelected( "Voxelize::process" ) )
+    {
+        auto algorithm = std::make_shared< di::algorithms::Voxelize >();
+        algorithm->getInput( "Triangle Mesh" )->setTransferable( surface.m_dataSet );
+        runner.run( "Voxelize::process", size, mesh->getNumTriangles(),
+            [ & ]()
+            {
+                algorithm->process();
+            }
+        );
+    }
+
+    if( runner.isSelected( "PlyReader::load" ) )
+    {
+        auto filename = tempDir + "/di_bench_" + std::to_string( size ) + ".ply";
+        di::bench::writePly( filename, *mesh, *surface.m_colors );
+
+        di::io::PlyReader reader;
+        runner.run( "PlyReader::load", size, size,
+            [ & ]()
+            {
+                reader.load( filename );
+            }
+        );
+        std::remove( filename.c_str() );
+    }
+
+    if( runner.isSelected( "RegionLabelReader::load" ) )
+    {
+        auto filename = tempDir + "/di_bench_" + std::to_string( size ) + ".labels";
+        di::bench::writeLabels( filename, *surface.m_regionLabels->getAttributes< 0 >() );
+
+        di::io::RegionLabelReader reader;
+        runner.run( "RegionLabelReader::load", size, size,
+            [ & ]()
+            {
+                reader.load( filename );
+            }
+        );
+        std::remove( filename.c_str() );
+    }
+}
+
+/**
+ * Run the procedural mesh generation for the given size.
+ *
+ * \param runner the runner to use
+ * \param numVertices the approximate mesh size
+ */
+void runGeneratorBenchmarks( di::bench::BenchmarkRunner& runner, size_t numVertices )
+{
+    for( auto torus : { false, true } )
+    {
+        std::string name = torus ? "GenerateMesh::process/torus" : "GenerateMesh::process/sphere";
+        if( !runner.isSelected( name ) )
+        {
+            continue;
+        }
+
+        auto algorithm = std::make_shared< di::algorithms::GenerateMesh >();
+        algorithm->getParameter( "Torus" )->fromString( torus ? "1" : "0" );
+        algorithm->getParameter( "Vertices" )->fromString( std::to_string( numVertices ) );
+        runner.run( name, numVertices, numVertices,
+            [ & ]()
+            {
+                algorithm->process();
+            }
+        );
+    }
+}
+
+/**
+ * Run all benchmarks on volumes of the given size.
+ *
+ * \param runner the runner to use
+ * \param numVoxels the volume size
+ */
+void runVolumeBenchmarks( di::bench::BenchmarkRunner& runner, size_t numVoxels )
+{
+    auto volume = di::bench::createVolume( numVoxels );
+    auto grid = volume->getGrid();
+    size_t size = grid->getSize();
+
+    runner.run( "GridRegular::index", size, size,
+        [ & ]()
+        {
+            size_t sum = 0;
+            for( size_t z = 0; z < grid->getSizeZ(); ++z )
+            {
+                for( size_t y = 0; y < grid->getSizeY(); ++y )
+                {
+                    for( size_t x = 0; x < grid->getSizeX(); ++x )
+                    {
+                        sum += grid->index( x, y, z );
+                    }
+                }
+            }
+            consume( sum );
+        }
+    );
+
+    if( runner.isSelected( "GaussSmooth::process" ) )
+    {
+        auto algorithm = std::make_shared< di::algorithms::GaussSmooth >();
+        algorithm->getInput( "Input" )->setTransferable( volume );
+        runner.run( "GaussSmooth::process", size, size,
+            [ & ]()
+            {
+                algorithm->process();
+            }
+        );
+    }
+
+    if( runner.isSelected( "Dilatate::process" ) )
+    {
+        auto algorithm = std::make_shared< di::algorithms::Dilatate >();
+        algorithm->getInput( "Input" )->setTransferable( volume );
+        runner.run( "Dilatate::process", size, size,
+            [ & ]()
+            {
+                algorithm->process();
+            }
+        );
+    }
+}
+
+/**
+ * Runs the benchmarks for all sizes and writes the results.
+ */
+int main( int argc, char** argv )
+{
+    size_t minSize = 1000;
+    size_t maxSize = 10000000;
+    std::string format = "json";
+    std::string output;
+    std::string tempDir = std::getenv( "TMPDIR" ) ? std::getenv( "TMPDIR" ) : "/tmp";
+
+    di::bench::BenchmarkRunner runner;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg( argv[ i ] );
+        auto pos = arg.find( '=' );
+        auto key = di::core::toLower( arg.substr( 0, pos ) );
+        auto value = ( pos == std::string::npos ) ? std::string() : arg.substr( pos + 1 );
+
+        try
+        {
+            if( key == "--min-vertices" )
+            {
+                minSize = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--max-vertices" )
+            {
+                maxSize = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--filter" )
+            {
+                runner.setFilter( value );
+            }
+            else if( key == "--repetitions" )
+            {
+                runner.setMinRepetitions( di::core::fromString< size_t >( value ) );
+            }
+            else if( key == "--min-time" )
+            {
+                runner.setMinTime( di::core::fromString< double >( value ) );
+            }
+            else if( key == "--format" )
+            {
+                format = di::core::toLower( value );
+            }
+            else if( key == "--output" )
+            {
+                output = value;
+            }
+            else if( key == "--temp-dir" )
+            {
+                tempDir = value;
+            }
+            else
+            {
+                printUsage();
+                return ( key == "--help" ) ? 0 : 1;
+            }
+        }
+        catch( const std::exception& )
+        {
+            std::cerr << "Invalid value in \"" << arg << "\"." << std::endl;
+            return 1;
+        }
+    }
+
+    if( ( format != "json" ) && ( format != "csv" ) )
+    {
+        printUsage();
+        return 1;
+    }
+
+    // The algorithms log a lot of debug information. This is not what we want to measure.
+    di::core::Logger::setLevel( di::core::LogLevel::Warning );
+
+    for( size_t size = minSize; ( size > 0 ) && ( size <= maxSize ); size *= 10 )
+    {
+        runMeshBenchmarks( runner, size, tempDir );
+        runGeneratorBenchmarks( runner, size );
+        runVolumeBenchmarks( runner, size );
+    }
+
+    std::ofstream file;
+    if( !output.empty() )
+    {
+        file.open( output );
+        if( !file )
+        {
+            std::cerr << "Could not open \"" << output << "\" for writing." << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+
+    if( format == "csv" )
+    {
+        runner.writeCSV( out );
+    }
+    else
+    {
+        runner.writeJSON( out );
+    }
+
+    di::core::Logger::flush();
+    return 0;
+}
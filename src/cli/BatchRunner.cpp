@@ -0,0 +1,368 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <di/core/Filesystem.h>
+#include <di/core/Trace.h>
+
+#include <di/io/PlyReader.h>
+#include <di/io/RegionLabelReader.h>
+
+#include "Bitmap.h"
+
+#include "BatchRunner.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/BatchRunner"
+
+namespace di
+{
+    namespace cli
+    {
+        std::vector< BatchRunner::Job > BatchRunner::readManifest( const std::string& filename )
+        {
+            auto separator = filename.find_last_of( "/\\" );
+            auto directory = ( separator == std::string::npos ) ? std::string() : filename.substr( 0, separator + 1 );
+            auto resolve = [ &directory ]( const std::string& path )
+            {
+                return ( path.empty() || ( path[ 0 ] == '/' ) ) ? path : directory + path;
+            };
+
+            std::vector< Job > jobs;
+            std::map< std::string, size_t > lines;
+            std::istringstream manifest( di::core::readTextFile( filename ) );
+            std::string line;
+            size_t lineNumber = 0;
+            while( std::getline( manifest, line ) )
+            {
+                ++lineNumber;
+                std::istringstream fields( line );
+                std::vector< std::string > tokens;
+                std::string token;
+                while( ( fields >> token ) && ( token[ 0 ] != '#' ) )
+                {
+                    tokens.push_back( token );
+                }
+
+                if( tokens.empty() )
+                {
+                    continue;
+                }
+                if( ( tokens.size() < 3 ) || ( tokens.size() > 4 ) )
+                {
+                    throw std::invalid_argument( filename + ":" + std::to_string( lineNumber ) +
+                                                 ": expected mesh, labels, label ordering and an optional name." );
+                }
+
+                Job job;
+                job.m_mesh = resolve( tokens[ 0 ] );
+                job.m_labels = resolve( tokens[ 1 ] );
+                job.m_order = resolve( tokens[ 2 ] );
+                if( tokens.size() == 4 )
+                {
+                    job.m_name = tokens[ 3 ];
+                }
+                else
+                {
+                    // Subjects usually have label files of the same name in their own directories. Keep the directories in the name.
+                    auto name = tokens[ 1 ];
+                    auto extension = name.find_last_of( '.' );
+                    if( ( extension != std::string::npos ) && ( extension > name.find_last_of( "/\\" ) + 1 ) )
+                    {
+                        name.erase( extension );
+                    }
+                    std::replace_if( name.begin(), name.end(),
+                                     []( char c )
+                                     {
+                                         return ( c == '/' ) || ( c == '\\' ) || ( c == ':' );
+                                     },
+                                     '_'
+                    );
+                    // Relative paths like ../subjects start with dots.
+                    auto first = name.find_first_not_of( "._" );
+                    job.m_name = ( first == std::string::npos ) ? name : name.substr( first );
+                }
+
+                // The name selects the output files. Two subjects of the same name would overwrite each other.
+                auto known = lines.find( job.m_name );
+                if( known != lines.end() )
+                {
+                    throw std::invalid_argument( filename + ":" + std::to_string( lineNumber ) + ": the name \"" + job.m_name +
+                                                 "\" is already used in line " + std::to_string( known->second ) + "." );
+                }
+                lines[ job.m_name ] = lineNumber;
+                jobs.push_back( job );
+            }
+            return jobs;
+        }
+
+        BatchRunner::BatchRunner( const Settings& settings, const di::core::State& project ):
+            m_settings( settings ),
+            m_project( project )
+        {
+            // The subjects define the files.
+            m_project.set( "files", di::core::State() );
+        }
+
+        bool BatchRunner::run( const std::vector< Job >& jobs )
+        {
+            m_results.assign( jobs.size(), Result() );
+            if( m_settings.m_processes )
+            {
+                runProcesses( jobs );
+                return std::all_of( m_results.begin(), m_results.end(),
+                                    []( const Result& result )
+                                    {
+                                        return result.m_ok;
+                                    }
+                );
+            }
+
+            // Each worker takes the next job until none is left. Jobs are small compared to the setup of a worker.
+            std::atomic< size_t > next( 0 );
+            auto worker = [ this, &jobs, &next ]( size_t index )
+            {
+                if( di::core::Trace::isEnabled() )
+                {
+                    di::core::Trace::setThreadName( "Batch Worker " + std::to_string( index ) );
+                }
+
+                // Contexts are bound to the thread. Each worker needs its own.
+                di::core::HeadlessContext context;
+                if( !m_settings.m_outputDir.empty() && !context.create( m_settings.m_backend, m_settings.m_software ) )
+                {
+                    LogE << "Worker " << index << " could not create a headless OpenGL context: " << context.getError() << LogEnd;
+                    return;
+                }
+
+                for( size_t job = next++; job < jobs.size(); job = next++ )
+                {
+                    m_results[ job ] = process( jobs[ job ] );
+                }
+            };
+
+            auto workers = std::max< size_t >( 1, std::min( m_settings.m_workers, jobs.size() ) );
+            LogI << "Processing " << jobs.size() << " subjects using " << workers << " workers." << LogEnd;
+
+            std::vector< std::thread > threads;
+            for( size_t index = 0; index < workers; ++index )
+            {
+                threads.push_back( std::thread( worker, index ) );
+            }
+            for( auto& thread : threads )
+            {
+                thread.join();
+            }
+
+            LogI << "Loaded " << m_cache.getMisses() << " files and shared " << m_cache.getHits() << " times." << LogEnd;
+            return std::all_of( m_results.begin(), m_results.end(),
+                                []( const Result& result )
+                                {
+                                    return result.m_ok;
+                                }
+            );
+        }
+
+        BatchRunner::Result BatchRunner::process( const Job& job )
+        {
+            typedef std::chrono::steady_clock Clock;
+            auto start = Clock::now();
+            di::core::TraceSpan span( LogTag, job.m_name );
+
+            Result result;
+            HeadlessNetwork network;
+            network.setStrategy( m_settings.m_strategy );
+            if( !network.setState( m_project ) )
+            {
+                return result;
+            }
+
+            // Meshes and orderings are usually shared among subjects. Labels are usually unique, no need to keep them.
+            try
+            {
+                if( !network.setData( job.m_mesh, m_cache.load( std::make_shared< di::io::PlyReader >(), job.m_mesh ) ) ||
+                    !network.setData( job.m_order, m_cache.load( std::make_shared< di::io::RegionLabelReader >(), job.m_order ) ) )
+                {
+                    LogE << job.m_name << ": loading failed." << LogEnd;
+                    return result;
+                }
+            }
+            catch( const std::exception& e )
+            {
+                LogE << job.m_name << ": loading failed: " << e.what() << LogEnd;
+                return result;
+            }
+
+            if( !network.loadFile( job.m_labels ) || !network.run() )
+            {
+                LogE << job.m_name << ": processing failed." << LogEnd;
+                return result;
+            }
+
+            result.m_ok = true;
+            if( !m_settings.m_outputDir.empty() )
+            {
+                auto pixels = network.render( m_settings.m_size, m_settings.m_samples, m_settings.m_background );
+                network.finalize();
+
+                result.m_image = m_settings.m_outputDir + "/" + job.m_name + ".bmp";
+                result.m_ok = writeBMP( *pixels, result.m_image );
+            }
+
+            result.m_time = std::chrono::duration< double >( Clock::now() - start ).count();
+            return result;
+        }
+
+        void BatchRunner::runProcesses( const std::vector< Job >& jobs )
+        {
+            // Load the shared data before forking. The workers inherit it copy-on-write. Nobody writes it, so it stays in memory only once.
+            for( const auto& job : jobs )
+            {
+                try
+                {
+                    m_cache.load( std::make_shared< di::io::PlyReader >(), job.m_mesh );
+                    m_cache.load( std::make_shared< di::io::RegionLabelReader >(), job.m_order );
+                }
+                catch( const std::exception& e )
+                {
+                    // The job fails in its worker and reports it there.
+                    LogD << job.m_name << ": preloading failed: " << e.what() << LogEnd;
+                }
+            }
+
+            WorkQueue queue( m_settings.m_queueDir );
+            if( !queue.create( jobs.size() ) )
+            {
+                return;
+            }
+
+            auto processes = std::min( m_settings.m_processes, jobs.size() );
+            LogI << "Processing " << jobs.size() << " subjects using " << processes << " processes. Queue: " << queue.getDirectory() << LogEnd;
+
+            // The log writer thread does not exist in the children. Write directly from now on. Flush to not write buffered output twice.
+            di::core::Logger::setAsynchronous( false );
+            std::cout.flush();
+            std::cerr.flush();
+
+            std::vector< pid_t > children;
+            for( size_t index = 0; index < processes; ++index )
+            {
+                auto pid = fork();
+                if( pid == 0 )
+                {
+                    // Do not run the destructors of the parent's static objects.
+                    auto code = work( jobs, &queue );
+                    std::cout.flush();
+                    std::cerr.flush();
+                    _exit( code );
+                }
+                else if( pid < 0 )
+                {
+                    LogE << "Could not start worker process " << index << "." << LogEnd;
+                }
+                else
+                {
+                    children.push_back( pid );
+                }
+            }
+
+            for( auto child : children )
+            {
+                int status = 0;
+                waitpid( child, &status, 0 );
+                if( !WIFEXITED( status ) )
+                {
+                    LogE << "Worker process " << child << " died." << LogEnd;
+                }
+            }
+
+            for( size_t index = 0; index < jobs.size(); ++index )
+            {
+                std::string text;
+                if( !queue.getResult( index, &text ) )
+                {
+                    LogE << jobs[ index ].m_name << ": not processed." << LogEnd;
+                    continue;
+                }
+
+                std::istringstream result( text );
+                result >> m_results[ index ].m_ok >> m_results[ index ].m_time;
+                result.ignore();
+                std::getline( result, m_results[ index ].m_image );
+            }
+
+            // Keep explicitly given queues for inspection.
+            if( m_settings.m_queueDir.empty() )
+            {
+                queue.remove();
+            }
+        }
+
+        int BatchRunner::work( const std::vector< Job >& jobs, WorkQueue* queue )
+        {
+            di::core::HeadlessContext context;
+            if( !m_settings.m_outputDir.empty() && !context.create( m_settings.m_backend, m_settings.m_software ) )
+            {
+                LogE << "Worker process " << getpid() << " could not create a headless OpenGL context: " << context.getError() << LogEnd;
+                return 1;
+            }
+
+            bool ok = true;
+            size_t index = 0;
+            while( queue->claim( &index ) )
+            {
+                auto result = process( jobs[ index ] );
+                std::ostringstream text;
+                text << result.m_ok << " " << result.m_time << std::endl << result.m_image;
+                queue->finish( index, text.str() );
+                ok = ok && result.m_ok;
+            }
+            return ok ? 0 : 1;
+        }
+
+        const std::vector< BatchRunner::Result >& BatchRunner::getResults() const
+        {
+            return m_results;
+        }
+
+        const DataSetCache& BatchRunner::getCache() const
+        {
+            return m_cache;
+        }
+    }
+}
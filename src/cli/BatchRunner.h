@@ -0,0 +1,251 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_BATCHRUNNER_H
+#define DI_BATCHRUNNER_H
+
+#include <string>
+#include <vector>
+
+#include <di/core/State.h>
+#include <di/gfx/HeadlessContext.h>
+#include <di/MathTypes.h>
+
+#include "DataSetCache.h"
+#include "HeadlessNetwork.h"
+#include "WorkQueue.h"
+
+namespace di
+{
+    namespace cli
+    {
+        /**
+         * Processes many subjects concurrently. Each subject is a mesh, a label file and a label ordering. Each worker thread has its own
+         * network and, if images are requested, its own OpenGL context. Meshes and label orderings are loaded through a \ref DataSetCache. Subjects
+         * on the same template mesh share one read-only mesh, including normals and the inverse index.
+         */
+        class BatchRunner
+        {
+        public:
+            /**
+             * A subject to process.
+             */
+            struct Job
+            {
+                /**
+                 * The mesh file.
+                 */
+                std::string m_mesh;
+
+                /**
+                 * The region label file.
+                 */
+                std::string m_labels;
+
+                /**
+                 * The label ordering file.
+                 */
+                std::string m_order;
+
+                /**
+                 * The name of the subject. Used for the output files.
+                 */
+                std::string m_name;
+            };
+
+            /**
+             * The outcome of a job.
+             */
+            struct Result
+            {
+                /**
+                 * True if processing and rendering succeeded.
+                 */
+                bool m_ok = false;
+
+                /**
+                 * Processing and rendering time in seconds. Excludes waiting for a worker.
+                 */
+                double m_time = 0.0;
+
+                /**
+                 * The image written. Empty if no image was requested or the job failed.
+                 */
+                std::string m_image;
+            };
+
+            /**
+             * How to process and render.
+             */
+            struct Settings
+            {
+                /**
+                 * The number of worker threads.
+                 */
+                size_t m_workers = 1;
+
+                /**
+                 * The visualization to use.
+                 */
+                HeadlessNetwork::Strategy m_strategy = HeadlessNetwork::Strategy::Lines;
+
+                /**
+                 * Where to write the images. No images are rendered if empty.
+                 */
+                std::string m_outputDir;
+
+                /**
+                 * The image size.
+                 */
+                glm::vec2 m_size = glm::vec2( 2048, 1536 );
+
+                /**
+                 * Multi-sampling of the images.
+                 */
+                int m_samples = 4;
+
+                /**
+                 * Background color.
+                 */
+                glm::vec4 m_background = glm::vec4( 1.0 );
+
+                /**
+                 * How to create the OpenGL contexts.
+                 */
+                di::core::HeadlessContext::Backend m_backend = di::core::HeadlessContext::Backend::Auto;
+
+                /**
+                 * Force software rendering.
+                 */
+                bool m_software = true;
+
+                /**
+                 * Number of worker processes. If not zero, batches are processed by forked processes instead of threads. Each process has its
+                 * own OpenGL context and allocator.
+                 */
+                size_t m_processes = 0;
+
+                /**
+                 * The work queue directory of the worker processes. A temporary directory is used if empty.
+                 */
+                std::string m_queueDir;
+            };
+
+            /**
+             * Read a manifest. Each line contains the mesh, the labels and the label ordering, separated by white space, followed by an optional
+             * name. Relative paths are relative to the manifest. Empty lines and lines starting with # are ignored. Without a name, the path of the
+             * label file as written, without extension and with separators replaced by _, is used. Names must be unique.
+             *
+             * \param filename the manifest
+             *
+             * \return the jobs
+             *
+             * \throw std::invalid_argument if the file cannot be read, a line is invalid or a name is used twice.
+             */
+            static std::vector< Job > readManifest( const std::string& filename );
+
+            /**
+             * Create the runner.
+             *
+             * \param settings how to process
+             * \param project the parameters and camera to use for all subjects, in the format of the project files. Files in the project are
+             * ignored.
+             */
+            BatchRunner( const Settings& settings, const di::core::State& project = di::core::State() );
+
+            /**
+             * Process all jobs. Blocks until all are done.
+             *
+             * \param jobs the jobs
+             *
+             * \return true if all jobs succeeded.
+             */
+            bool run( const std::vector< Job >& jobs );
+
+            /**
+             * The results of the last run, in the order of the jobs.
+             *
+             * \return the results
+             */
+            const std::vector< Result >& getResults() const;
+
+            /**
+             * The cache of loaded meshes and label orderings. Shared by all runs of this runner.
+             *
+             * \return the cache
+             */
+            const DataSetCache& getCache() const;
+
+        protected:
+        private:
+            /**
+             * Process a single job using the calling thread. Requires a current OpenGL context if images are requested.
+             *
+             * \param job the job
+             *
+             * \return the result
+             */
+            Result process( const Job& job );
+
+            /**
+             * Process all jobs using forked worker processes and a \ref WorkQueue.
+             *
+             * \param jobs the jobs
+             */
+            void runProcesses( const std::vector< Job >& jobs );
+
+            /**
+             * The loop of a worker process. Processes jobs until the queue is empty.
+             *
+             * \param jobs all jobs
+             * \param queue the queue to take jobs from
+             *
+             * \return the exit code of the process.
+             */
+            int work( const std::vector< Job >& jobs, WorkQueue* queue );
+
+            /**
+             * The settings.
+             */
+            Settings m_settings;
+
+            /**
+             * The template project without files.
+             */
+            di::core::State m_project;
+
+            /**
+             * The shared data.
+             */
+            DataSetCache m_cache;
+
+            /**
+             * Results of the last run.
+             */
+            std::vector< Result > m_results;
+        };
+    }
+}
+
+#endif  // DI_BATCHRUNNER_H
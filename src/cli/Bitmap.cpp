@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <fstream>
+#include <string>
+
+#include <di/ext/bitmap_image.hpp>
+
+#include "Bitmap.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/Bitmap"
+
+namespace di
+{
+    namespace cli
+    {
+        bool writeBMP( const di::core::RGBA8Image& image, const std::string& filename )
+        {
+            // bitmap_image::save_image does not report errors.
+            if( !std::ofstream( filename, std::ios::binary ) )
+            {
+                LogE << "Could not open \"" << filename << "\" for writing." << LogEnd;
+                return false;
+            }
+
+            bitmap_image bitmap( image.getWidth(), image.getHeight() );
+            for( size_t y = 0; y < image.getHeight(); ++y )
+            {
+                for( size_t x = 0; x < image.getWidth(); ++x )
+                {
+                    // Bitmaps start at the top, OpenGL images at the bottom.
+                    auto color = image( x, y );
+                    bitmap.set_pixel( x, image.getHeight() - y - 1, color.x, color.y, color.z );
+                }
+            }
+            bitmap.save_image( filename );
+            return true;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_BITMAP_H
+#define DI_BITMAP_H
+
+#include <string>
+
+#include <di/gfx/PixelData.h>
+
+namespace di
+{
+    namespace cli
+    {
+        /**
+         * Write an image as bitmap, like the screenshots of the application.
+         *
+         * \param image the image. OpenGL convention: the first row is the bottom row.
+         * \param filename the file to write
+         *
+         * \return true on success
+         */
+        bool writeBMP( const di::core::RGBA8Image& image, const std::string& filename );
+    }
+}
+
+#endif  // DI_BITMAP_H
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+#include <di/core/Filesystem.h>
+
+#include "DataSetCache.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/DataSetCache"
+
+namespace di
+{
+    namespace cli
+    {
+        ConstSPtr< di::core::DataSetBase > DataSetCache::load( ConstSPtr< di::core::Reader > reader, const std::string& filename )
+        {
+            // Hash outside the lock. Other threads can hash their files meanwhile.
+            Key key( std::type_index( typeid( *reader ) ), di::core::hashFile( filename ) );
+
+            std::promise< ConstSPtr< di::core::DataSetBase > > promise;
+            std::shared_future< ConstSPtr< di::core::DataSetBase > > future;
+            bool owner = false;
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+                auto found = m_data.find( key );
+                if( found != m_data.end() )
+                {
+                    ++m_hits;
+                    future = found->second;
+                }
+                else
+                {
+                    ++m_misses;
+                    owner = true;
+                    future = promise.get_future().share();
+                    m_data[ key ] = future;
+                }
+            }
+
+            // The first user loads. All others wait for the result.
+            if( owner )
+            {
+                LogD << "Loading \"" << filename << "\"." << LogEnd;
+                try
+                {
+                    promise.set_value( reader->load( filename ) );
+                }
+                catch( ... )
+                {
+                    promise.set_exception( std::current_exception() );
+                }
+            }
+            else
+            {
+                LogD << "Sharing already loaded data for \"" << filename << "\"." << LogEnd;
+            }
+            return future.get();
+        }
+
+        size_t DataSetCache::getHits() const
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            return m_hits;
+        }
+
+        size_t DataSetCache::getMisses() const
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            return m_misses;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_DATASETCACHE_H
+#define DI_DATASETCACHE_H
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+
+#include <di/core/Reader.h>
+#include <di/core/data/DataSetBase.h>
+#include <di/Types.h>
+
+namespace di
+{
+    namespace cli
+    {
+        /**
+         * Loads files once per content. Files are identified by the hash of their contents, so copies of the same mesh under different names are
+         * loaded only once, including everything the reader derives, like normals and the inverse index of meshes. The loaded data is shared
+         * read-only between all users. Thread-safe. Concurrent requests for the same content wait for the first one to finish loading.
+         */
+        class DataSetCache
+        {
+        public:
+            /**
+             * Load the file or return the already loaded data with the same content.
+             *
+             * \param reader the reader to use. Data loaded by other reader types is not shared.
+             * \param filename the file to load
+             *
+             * \return the data
+             *
+             * \throw std::invalid_argument if the file cannot be read. Exceptions of the reader are forwarded to all users waiting for the data.
+             */
+            ConstSPtr< di::core::DataSetBase > load( ConstSPtr< di::core::Reader > reader, const std::string& filename );
+
+            /**
+             * The number of loads that used already loaded data.
+             *
+             * \return the number of hits
+             */
+            size_t getHits() const;
+
+            /**
+             * The number of loads that needed to read the file.
+             *
+             * \return the number of misses
+             */
+            size_t getMisses() const;
+
+        protected:
+        private:
+            /**
+             * Identifies a data set: reader type and content hash.
+             */
+            typedef std::tuple< std::type_index, uint64_t > Key;
+
+            /**
+             * The data loaded so far. Futures allow waiting for loads in progress.
+             */
+            std::map< Key, std::shared_future< ConstSPtr< di::core::DataSetBase > > > m_data;
+
+            /**
+             * Protects the map and the counters.
+             */
+            mutable std::mutex m_mutex;
+
+            /**
+             * Number of hits.
+             */
+            size_t m_hits = 0;
+
+            /**
+             * Number of misses.
+             */
+            size_t m_misses = 0;
+        };
+    }
+}
+
+#endif  // DI_DATASETCACHE_H
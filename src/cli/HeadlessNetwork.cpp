@@ -0,0 +1,466 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <cmath>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <di/core/Filesystem.h>
+#include <di/core/StringUtils.h>
+#include <di/gfx/Camera.h>
+#include <di/gfx/GL.h>
+#include <di/gfx/OffscreenView.h>
+
+#include <di/algorithms/DataInject.h>
+#include <di/algorithms/ExtractRegions.h>
+#include <di/algorithms/ExtractSubmesh.h>
+#include <di/algorithms/RenderIllustrativeLines.h>
+#include <di/algorithms/SurfaceLIC.h>
+#include <di/algorithms/TransferLabels.h>
+
+#include <di/io/PlyReader.h>
+#include <di/io/RegionLabelReader.h>
+#include <di/io/Snapshot.h>
+
+#include "HeadlessNetwork.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/HeadlessNetwork"
+
+namespace di
+{
+    namespace cli
+    {
+        HeadlessNetwork::HeadlessNetwork():
+            m_network( new di::core::ProcessingNetwork() ),
+            m_meshInject( new di::algorithms::DataInject() ),
+            m_labelInject( new di::algorithms::DataInject() ),
+            m_labelOrderInject( new di::algorithms::DataInject() )
+        {
+            m_network->start();
+
+            // Same network as in App::prepareNetwork. Keep the order of the algorithms. It defines the runtime names used in project files.
+            auto extractRegions = SPtr< di::core::Algorithm >( new di::algorithms::ExtractRegions );
+            auto renderArrows = SPtr< di::core::Algorithm >( new di::algorithms::RenderIllustrativeLines );
+            auto lic = SPtr< di::core::Algorithm >( new di::algorithms::SurfaceLIC );
+            auto extractSubmesh = SPtr< di::core::Algorithm >( new di::algorithms::ExtractSubmesh );
+            m_linesStrategy.push_back( renderArrows );
+            m_licStrategy.push_back( lic );
+
+            m_network->addAlgorithm( m_meshInject );
+            m_network->addAlgorithm( m_labelInject );
+            m_network->addAlgorithm( m_labelOrderInject );
+            m_network->addAlgorithm( extractRegions );
+            m_network->addAlgorithm( renderArrows );
+            m_network->addAlgorithm( lic );
+            m_network->addAlgorithm( extractSubmesh );
+
+            m_network->connectAlgorithms( m_meshInject, "Data", extractSubmesh, "Triangle Mesh" );
+            m_network->connectAlgorithms( m_labelInject, "Data", extractSubmesh, "Triangle Labels" );
+            m_network->connectAlgorithms( extractSubmesh, "Triangle Mesh", extractRegions, "Triangle Mesh" );
+            m_network->connectAlgorithms( extractSubmesh, "Triangle Labels", extractRegions, "Triangle Labels" );
+            m_network->connectAlgorithms( m_labelOrderInject, "Data", extractRegions, "Label Ordering" );
+            m_network->connectAlgorithms( extractSubmesh, "Triangle Labels", renderArrows, "Labels" );
+            m_network->connectAlgorithms( extractSubmesh, "Triangle Mesh", renderArrows, "Triangle Mesh" );
+            m_network->connectAlgorithms( extractSubmesh, "Triangle Mesh", lic, "Triangle Mesh" );
+            m_network->connectAlgorithms( extractRegions, "Directionality", renderArrows, "Directions" );
+            m_network->connectAlgorithms( extractRegions, "Directionality", lic, "Directions" );
+            wait();
+
+            setStrategy( Strategy::Lines );
+        }
+
+        HeadlessNetwork::~HeadlessNetwork()
+        {
+            m_network->stop();
+        }
+
+        bool HeadlessNetwork::wait()
+        {
+            std::promise< void > done;
+            auto future = done.get_future();
+            m_network->callback(
+                [ &done ]()
+                {
+                    done.set_value();
+                }
+            );
+            future.wait();
+
+            bool ok = true;
+            for( auto command : m_pending )
+            {
+                if( command->isFailed() )
+                {
+                    LogE << command->getName() << " failed: " << command->getFailureReason() << LogEnd;
+                    ok = false;
+                }
+            }
+            m_pending.clear();
+            return ok;
+        }
+
+        void HeadlessNetwork::setFile( SPtr< di::algorithms::DataInject > inject, const std::string& filename )
+        {
+            std::string name = "Label Ordering";
+            if( inject == m_meshInject )
+            {
+                name = "Mesh";
+            }
+            else if( inject == m_labelInject )
+            {
+                name = "Region Labels";
+            }
+
+            di::core::State file;
+            file.set( "Filename", filename );
+            m_files.set( name, file );
+        }
+
+        void HeadlessNetwork::loadFile( SPtr< di::algorithms::DataInject > inject, const std::string& filename )
+        {
+            SPtr< di::core::Reader > reader;
+            if( inject == m_meshInject )
+            {
+                reader = std::make_shared< di::io::PlyReader >();
+            }
+            else
+            {
+                reader = std::make_shared< di::io::RegionLabelReader >();
+            }
+
+            setFile( inject, filename );
+            m_pending.push_back( m_network->loadFile( reader, filename, inject ) );
+        }
+
+        SPtr< di::algorithms::DataInject > HeadlessNetwork::getInject( const std::string& filename ) const
+        {
+            // Like the application, use the extension to select the loader. Some readers can load multiple formats.
+            auto ext = di::core::toLower( di::core::getFileExtension( filename ) );
+            if( ext == "ply" )
+            {
+                return m_meshInject;
+            }
+            else if( ext == "labels" )
+            {
+                return m_labelInject;
+            }
+            else if( ext == "labelorder" )
+            {
+                return m_labelOrderInject;
+            }
+            return nullptr;
+        }
+
+        bool HeadlessNetwork::loadFile( const std::string& filename )
+        {
+            auto inject = getInject( filename );
+            if( !inject )
+            {
+                LogE << "Unknown file type: \"" << filename << "\"." << LogEnd;
+                return false;
+            }
+            loadFile( inject, filename );
+            return wait();
+        }
+
+        bool HeadlessNetwork::setData( const std::string& filename, ConstSPtr< di::core::DataSetBase > data )
+        {
+            auto inject = getInject( filename );
+            if( !inject )
+            {
+                LogE << "Unknown file type: \"" << filename << "\"." << LogEnd;
+                return false;
+            }
+            setFile( inject, filename );
+            inject->inject( data );
+            return true;
+        }
+
+        bool HeadlessNetwork::transferLabels( const std::string& sourceMesh, int neighbours )
+        {
+            auto mesh = m_meshInject->getInjected();
+            auto labels = m_labelInject->getInjected();
+            if( !mesh || !labels )
+            {
+                LogE << "Transferring labels requires the labels and the mesh to transfer them to." << LogEnd;
+                return false;
+            }
+
+            SPtr< di::core::DataSetBase > source;
+            try
+            {
+                source = di::io::PlyReader().load( sourceMesh );
+            }
+            catch( const std::exception& e )
+            {
+                LogE << "Could not load \"" << sourceMesh << "\": " << e.what() << LogEnd;
+                return false;
+            }
+
+            // Not part of the network. Its runtime name would change the names in project files.
+            di::algorithms::TransferLabels transfer;
+            transfer.getInput( "Source Mesh" )->setTransferable( source );
+            transfer.getInput( "Source Labels" )->setTransferable( labels );
+            transfer.getInput( "Target Mesh" )->setTransferable( mesh );
+            transfer.getParameter( "Neighbours" )->fromString( std::to_string( neighbours ) );
+            transfer.process();
+
+            auto result = transfer.getOutput( "Triangle Labels" )->getTransferable();
+            if( !result )
+            {
+                return false;
+            }
+            m_labelInject->inject( result );
+            return true;
+        }
+
+        bool HeadlessNetwork::loadProject( const std::string& filename )
+        {
+            di::core::State state;
+            try
+            {
+                state = di::core::State::fromFile( filename );
+            }
+            catch( const std::exception& e )
+            {
+                LogE << "Could not load project \"" << filename << "\": " << e.what() << LogEnd;
+                return false;
+            }
+            return setState( state );
+        }
+
+        bool HeadlessNetwork::loadSnapshot( const std::string& filename )
+        {
+            try
+            {
+                di::io::Snapshot snapshot( filename );
+                auto state = snapshot.getState();
+
+                // Like setState, but without loading the files. Parameters first, since setting them requests updates. Restoring resets them.
+                m_network->setState( state.getState( "parameters" ) );
+                auto view = state.getState( "view1" );
+                if( !view.empty() )
+                {
+                    m_arcballMatrix = view.getValue< glm::mat4 >( "Arcball Matrix", glm::mat4() );
+                    m_dragOffset = view.getValue< glm::vec2 >( "Drag Offset", glm::vec2( 0.0, 0.0 ) );
+                }
+                m_files = state.getState( "files" );
+
+                if( !wait() )
+                {
+                    return false;
+                }
+                auto restored = snapshot.restore( *m_network );
+                LogI << "Restored " << restored << " algorithms from snapshot \"" << filename << "\"." << LogEnd;
+            }
+            catch( const std::exception& e )
+            {
+                LogE << "Could not load snapshot \"" << filename << "\": " << e.what() << LogEnd;
+                return false;
+            }
+            return true;
+        }
+
+        bool HeadlessNetwork::saveSnapshot( const std::string& filename ) const
+        {
+            try
+            {
+                di::io::Snapshot::write( filename, getState(), *m_network );
+            }
+            catch( const std::exception& e )
+            {
+                LogE << "Could not save snapshot \"" << filename << "\": " << e.what() << LogEnd;
+                return false;
+            }
+            return true;
+        }
+
+        bool HeadlessNetwork::setState( const di::core::State& state )
+        {
+            m_network->setState( state.getState( "parameters" ) );
+
+            auto view = state.getState( "view1" );
+            if( !view.empty() )
+            {
+                m_arcballMatrix = view.getValue< glm::mat4 >( "Arcball Matrix", glm::mat4() );
+                m_dragOffset = view.getValue< glm::vec2 >( "Drag Offset", glm::vec2( 0.0, 0.0 ) );
+            }
+
+            auto files = state.getState( "files" );
+            std::vector< std::pair< std::string, SPtr< di::algorithms::DataInject > > > loaders;
+            loaders.push_back( std::make_pair( "Mesh", m_meshInject ) );
+            loaders.push_back( std::make_pair( "Region Labels", m_labelInject ) );
+            loaders.push_back( std::make_pair( "Label Ordering", m_labelOrderInject ) );
+            for( const auto& loader : loaders )
+            {
+                auto filename = files.getState( loader.first ).getValue( "Filename", "" );
+                if( !filename.empty() )
+                {
+                    loadFile( loader.second, filename );
+                }
+            }
+            return wait();
+        }
+
+        di::core::State HeadlessNetwork::getState() const
+        {
+            di::core::State view;
+            view.set( "Arcball Matrix", m_arcballMatrix );
+            view.set( "Drag Offset", m_dragOffset );
+
+            // The layout of App::saveProject.
+            di::core::State state;
+            state.set( "program", "DirectionalityIndicator" );
+            state.set( "version", "1.0" );
+            state.set( "view1", view );
+            state.set( "parameters", m_network->getState() );
+            state.set( "files", m_files );
+            return state;
+        }
+
+        void HeadlessNetwork::setStrategy( Strategy strategy )
+        {
+            // Like AlgorithmWidget::setActive, for each algorithm of each strategy.
+            auto activate = []( SPtrVec< di::core::Algorithm > algorithms, bool active )
+            {
+                for( auto algorithm : algorithms )
+                {
+                    algorithm->setActive( active );
+                    auto vis = std::dynamic_pointer_cast< di::core::Visualization >( algorithm );
+                    if( vis )
+                    {
+                        vis->setRenderingActive( active );
+                    }
+                }
+            };
+            activate( m_linesStrategy, strategy == Strategy::Lines );
+            activate( m_licStrategy, strategy == Strategy::LIC );
+        }
+
+        bool HeadlessNetwork::run()
+        {
+            m_pending.push_back( m_network->runNetwork() );
+            return wait();
+        }
+
+        SPtr< di::core::RGBA8Image > HeadlessNetwork::render( const glm::vec2& size, int samples, const glm::vec4& background )
+        {
+            if( !m_prepared )
+            {
+                m_network->visitVisualizations(
+                    []( SPtr< di::core::Visualization > vis )
+                    {
+                        vis->prepare();
+                    }
+                );
+            }
+
+            di::core::BoundingBox sceneBB;
+            m_network->visitVisualizations(
+                [ &sceneBB ]( SPtr< di::core::Visualization > vis )
+                {
+                    sceneBB.include( vis->getBoundingBox() );
+                }
+            );
+
+            // The camera of OGLWidget::paintGL.
+            auto view = std::make_shared< di::core::OffscreenView >( size, samples );
+            view->setHQMode( true );
+
+            double near = 0.3;
+            double far = m_zoom * sqrt( 3.0 ) + near;
+            di::core::Camera camera;
+            camera.setProjectionMatrix( di::core::buildProjectionMatrix( near, far, view->getAspectRatio() ) );
+            camera.setViewMatrix( di::core::buildViewMatrix( sceneBB, m_arcballMatrix, m_zoom, m_dragOffset ) );
+            view->setCamera( camera );
+            view->prepare();
+
+            // The frame of OGLWidget::renderToView with overridden background. The first update uploads the data by itself.
+            m_network->visitVisualizations(
+                [ &view ]( SPtr< di::core::Visualization > vis )
+                {
+                    if( vis->isRenderingActive() )
+                    {
+                        view->bind();
+                        vis->update( *view, false );
+                    }
+                }
+            );
+            m_prepared = true;
+
+            view->bind();
+            glViewport( view->getViewport().first.x, view->getViewport().first.y,
+                        view->getViewport().second.x, view->getViewport().second.y );
+            glClearColor( background.r, background.g, background.b, background.a );
+            glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+            glDepthMask( GL_TRUE );
+            glEnable( GL_BLEND );
+            glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+            glEnable( GL_DEPTH_TEST );
+            m_frameUniforms.update( *view );
+
+            m_network->visitVisualizations(
+                [ &view ]( SPtr< di::core::Visualization > vis )
+                {
+                    if( vis->isRenderingActive() )
+                    {
+                        view->bind();
+                        vis->render( *view );
+                    }
+                }
+            );
+
+            auto image = view->read();
+            view->finalize();
+            return image;
+        }
+
+        void HeadlessNetwork::finalize()
+        {
+            if( !m_prepared )
+            {
+                return;
+            }
+
+            m_network->visitVisualizations(
+                []( SPtr< di::core::Visualization > vis )
+                {
+                    vis->finalize();
+                }
+            );
+            m_frameUniforms.finalize();
+            m_prepared = false;
+        }
+
+        SPtr< di::core::ProcessingNetwork > HeadlessNetwork::getProcessingNetwork() const
+        {
+            return m_network;
+        }
+    }
+}
+
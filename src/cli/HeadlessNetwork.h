@@ -0,0 +1,290 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_HEADLESSNETWORK_H
+#define DI_HEADLESSNETWORK_H
+
+#include <string>
+#include <vector>
+
+#include <di/core/ProcessingNetwork.h>
+#include <di/core/State.h>
+#include <di/core/data/DataSetBase.h>
+#include <di/gfx/FrameUniforms.h>
+#include <di/gfx/PixelData.h>
+#include <di/MathTypes.h>
+#include <di/Types.h>
+
+namespace di
+{
+    namespace algorithms
+    {
+        class DataInject;
+    }
+
+    namespace cli
+    {
+        /**
+         * The processing network of the application without any UI. It builds the same network as App::prepareNetwork, in the same order, so the
+         * runtime names of the algorithms and thus project files match. Loading, processing and rendering are blocking.
+         */
+        class HeadlessNetwork
+        {
+        public:
+            /**
+             * The visualization strategies of the application. Only the algorithms of the active strategy are processed and rendered.
+             */
+            enum class Strategy
+            {
+                Lines,  //!< Surface with region boundaries and illustrative lines.
+                LIC     //!< Surface LIC
+            };
+
+            /**
+             * Create and start the network. Blocks until all algorithms are added and connected.
+             */
+            HeadlessNetwork();
+
+            /**
+             * Destructor. Stops the network. Call \ref finalize before, if you rendered.
+             */
+            virtual ~HeadlessNetwork();
+
+            /**
+             * Load a file. The loader is selected by extension: ply, labels and labelorder. Processing is not triggered.
+             *
+             * \param filename the file to load
+             *
+             * \return false if the extension is unknown or loading failed.
+             */
+            bool loadFile( const std::string& filename );
+
+            /**
+             * Use already loaded data instead of loading a file. The target is selected by the extension of the file the data was loaded from, like
+             * in \ref loadFile. The file is recorded in the state. The data is shared and must not be modified anymore. Processing is not triggered.
+             *
+             * \param filename the file the data was loaded from
+             * \param data the data
+             *
+             * \return false if the extension is unknown.
+             */
+            bool setData( const std::string& filename, ConstSPtr< di::core::DataSetBase > data );
+
+            /**
+             * Replace the loaded labels, defined on another mesh, by labels for the loaded mesh. Each vertex gets the labels of the nearest vertices
+             * of the other mesh. The files state still refers to the original labels. Processing is not triggered.
+             *
+             * \param sourceMesh the mesh the loaded labels are defined on
+             * \param neighbours the number of nearest vertices to consider
+             *
+             * \return false if mesh or labels are missing or the source mesh cannot be loaded.
+             */
+            bool transferLabels( const std::string& sourceMesh, int neighbours );
+
+            /**
+             * Load a project file as written by the application. Loads the files and sets the parameters and camera.
+             *
+             * \param filename the project file
+             *
+             * \return false if the file cannot be read or a data file cannot be loaded.
+             */
+            bool loadProject( const std::string& filename );
+
+            /**
+             * Load a snapshot written by \ref saveSnapshot. Sets parameters and camera and restores the data of the algorithms without loading
+             * or processing anything. The files state refers to the files of the session the snapshot was taken from, but they are not needed.
+             *
+             * \param filename the snapshot file
+             *
+             * \return false if the file cannot be read.
+             */
+            bool loadSnapshot( const std::string& filename );
+
+            /**
+             * Write the state and the data of all algorithms as snapshot. Call after \ref run.
+             *
+             * \param filename the snapshot file
+             *
+             * \return false if the file cannot be written.
+             */
+            bool saveSnapshot( const std::string& filename ) const;
+
+            /**
+             * Apply a project state. Very fault tolerant, like the application. It sets what it can set.
+             *
+             * \param state the state with the sub-states "parameters", "files" and "view1".
+             *
+             * \return false if a data file cannot be loaded.
+             */
+            bool setState( const di::core::State& state );
+
+            /**
+             * Get the whole state, in the format of the application's project files.
+             *
+             * \return the state
+             */
+            di::core::State getState() const;
+
+            /**
+             * Select the visualization strategy. The default is \ref Strategy::Lines, like the application.
+             *
+             * \param strategy the strategy to use
+             */
+            void setStrategy( Strategy strategy );
+
+            /**
+             * Run all algorithms that need to be updated.
+             *
+             * \return false if processing failed.
+             */
+            bool run();
+
+            /**
+             * Render the active visualizations with the camera of the loaded project. Requires a current OpenGL context. Visualizations get
+             * prepared during the first call.
+             *
+             * \param size the image size
+             * \param samples the number of samples per pixel
+             * \param background the background color
+             *
+             * \return the image. OpenGL convention: the first row is the bottom row.
+             */
+            SPtr< di::core::RGBA8Image > render( const glm::vec2& size, int samples, const glm::vec4& background );
+
+            /**
+             * Release the OpenGL resources of the visualizations. Requires the context used by \ref render to be current.
+             */
+            void finalize();
+
+            /**
+             * The network itself.
+             *
+             * \return the network
+             */
+            SPtr< di::core::ProcessingNetwork > getProcessingNetwork() const;
+
+        protected:
+        private:
+            /**
+             * Wait until all committed commands are done.
+             *
+             * \return false if one of the commands issued since the last wait failed.
+             */
+            bool wait();
+
+            /**
+             * Load a file using the given data inject.
+             *
+             * \param inject where to inject the data
+             * \param filename the file
+             */
+            void loadFile( SPtr< di::algorithms::DataInject > inject, const std::string& filename );
+
+            /**
+             * Select the data inject by the extension of the file, like the application: ply, labels and labelorder.
+             *
+             * \param filename the file
+             *
+             * \return the inject or nullptr if the extension is unknown.
+             */
+            SPtr< di::algorithms::DataInject > getInject( const std::string& filename ) const;
+
+            /**
+             * Record the file of the given inject in the files state.
+             *
+             * \param inject the inject
+             * \param filename the file
+             */
+            void setFile( SPtr< di::algorithms::DataInject > inject, const std::string& filename );
+
+            /**
+             * The network.
+             */
+            SPtr< di::core::ProcessingNetwork > m_network;
+
+            /**
+             * The mesh input.
+             */
+            SPtr< di::algorithms::DataInject > m_meshInject;
+
+            /**
+             * The label input.
+             */
+            SPtr< di::algorithms::DataInject > m_labelInject;
+
+            /**
+             * The label order input.
+             */
+            SPtr< di::algorithms::DataInject > m_labelOrderInject;
+
+            /**
+             * The files currently loaded, by the names used by the application: Mesh, Region Labels and Label Ordering.
+             */
+            di::core::State m_files;
+
+            /**
+             * The algorithms of the lines strategy.
+             */
+            SPtrVec< di::core::Algorithm > m_linesStrategy;
+
+            /**
+             * The algorithms of the LIC strategy.
+             */
+            SPtrVec< di::core::Algorithm > m_licStrategy;
+
+            /**
+             * Commands issued since the last wait.
+             */
+            SPtrVec< di::core::Command > m_pending;
+
+            /**
+             * Camera orientation, like the arcball of the application.
+             */
+            glm::mat4 m_arcballMatrix;
+
+            /**
+             * Camera offset.
+             */
+            glm::vec2 m_dragOffset = glm::vec2( 0.0 );
+
+            /**
+             * Camera zoom. The default of the application.
+             */
+            double m_zoom = 1.732;
+
+            /**
+             * True if the visualizations were prepared.
+             */
+            bool m_prepared = false;
+
+            /**
+             * Camera and viewport for all programs. Created with the visualizations.
+             */
+            di::core::FrameUniforms m_frameUniforms;
+        };
+    }
+}
+
+#endif  // DI_HEADLESSNETWORK_H
+
@@ -0,0 +1,342 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <di/core/Conversion.h>
+#include <di/core/StringUtils.h>
+#include <di/core/Trace.h>
+
+#include <di/io/PlyReader.h>
+#include <di/io/RegionLabelReader.h>
+
+#include "Bitmap.h"
+#include "HeadlessNetwork.h"
+
+#include "SweepRunner.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/SweepRunner"
+
+namespace di
+{
+    namespace cli
+    {
+        SweepRunner::Dimension SweepRunner::parseDimension( const std::string& spec )
+        {
+            // Parameter names may contain anything but the separators. Values never contain =.
+            auto equals = spec.find_last_of( '=' );
+            auto slash = spec.find( '/' );
+            if( ( equals == std::string::npos ) || ( slash == std::string::npos ) || ( slash > equals ) )
+            {
+                throw std::invalid_argument( "Invalid sweep \"" + spec + "\". Expected ALGORITHM/PARAMETER=VALUES." );
+            }
+
+            Dimension dimension;
+            dimension.m_algorithm = spec.substr( 0, slash );
+            dimension.m_parameter = spec.substr( slash + 1, equals - slash - 1 );
+            auto values = spec.substr( equals + 1 );
+
+            auto range = di::core::split( values, ':' );
+            if( range.size() == 3 )
+            {
+                auto from = di::core::fromString< double >( range[ 0 ] );
+                auto to = di::core::fromString< double >( range[ 1 ] );
+                auto step = di::core::fromString< double >( range[ 2 ] );
+                if( ( step <= 0.0 ) || ( to < from ) )
+                {
+                    throw std::invalid_argument( "Invalid range \"" + values + "\". Expected FROM:TO:STEP with FROM <= TO and STEP > 0." );
+                }
+
+                // Allow some rounding error at the end of the range.
+                auto count = static_cast< size_t >( std::floor( ( to - from ) / step + 1e-6 ) ) + 1;
+                for( size_t i = 0; i < count; ++i )
+                {
+                    // The default format writes integral values without decimals. Integer parameters need that.
+                    std::ostringstream value;
+                    value << ( from + i * step );
+                    dimension.m_values.push_back( value.str() );
+                }
+            }
+            else
+            {
+                for( const auto& value : di::core::split( values, ';' ) )
+                {
+                    if( !value.empty() )
+                    {
+                        dimension.m_values.push_back( value );
+                    }
+                }
+            }
+
+            if( dimension.m_values.empty() )
+            {
+                throw std::invalid_argument( "Invalid sweep \"" + spec + "\". No values." );
+            }
+            return dimension;
+        }
+
+        SweepRunner::SweepRunner( const BatchRunner::Settings& settings, const di::core::State& project ):
+            m_settings( settings ),
+            m_project( project )
+        {
+        }
+
+        bool SweepRunner::order( std::vector< Dimension >* dimensions ) const
+        {
+            // An empty network is enough to know the names and order of the algorithms.
+            HeadlessNetwork probe;
+            std::map< std::string, size_t > positions;
+            auto algorithms = probe.getProcessingNetwork()->getRunOrder();
+            for( size_t position = 0; position < algorithms.size(); ++position )
+            {
+                positions[ algorithms[ position ]->getRuntimeName() ] = position;
+            }
+
+            for( const auto& dimension : *dimensions )
+            {
+                auto found = positions.find( dimension.m_algorithm );
+                if( found == positions.end() )
+                {
+                    LogE << "There is no algorithm \"" << dimension.m_algorithm << "\". Use the names of the project files." << LogEnd;
+                    return false;
+                }
+
+                // Check the parameter and its values now. Workers should not fail because of typos.
+                try
+                {
+                    auto parameter = algorithms[ found->second ]->getParameter( dimension.m_parameter );
+                    for( const auto& value : dimension.m_values )
+                    {
+                        parameter->fromString( value );
+                    }
+                }
+                catch( const std::exception& e )
+                {
+                    LogE << "Invalid sweep of \"" << dimension.m_algorithm << "/" << dimension.m_parameter << "\": " << e.what() << LogEnd;
+                    return false;
+                }
+            }
+
+            // Upstream parameters change least often. Upstream algorithms then only run when their parameters change.
+            std::stable_sort( dimensions->begin(), dimensions->end(),
+                [ &positions ]( const Dimension& a, const Dimension& b )
+                {
+                    return positions[ a.m_algorithm ] < positions[ b.m_algorithm ];
+                }
+            );
+            return true;
+        }
+
+        bool SweepRunner::run( std::vector< Dimension > dimensions )
+        {
+            m_results.clear();
+            if( !order( &dimensions ) )
+            {
+                return false;
+            }
+            m_dimensions = dimensions;
+
+            size_t combinations = 1;
+            for( const auto& dimension : m_dimensions )
+            {
+                combinations *= dimension.m_values.size();
+            }
+            m_results.assign( combinations, Result() );
+
+            // Each worker processes a contiguous block of combinations. Within a block, only the innermost parameters change from one
+            // combination to the next. Upstream results get reused.
+            auto workers = std::max< size_t >( 1, std::min( m_settings.m_workers, combinations ) );
+            LogI << "Sweeping " << combinations << " combinations using " << workers << " workers." << LogEnd;
+
+            auto worker = [ this, combinations, workers ]( size_t index )
+            {
+                if( di::core::Trace::isEnabled() )
+                {
+                    di::core::Trace::setThreadName( "Sweep Worker " + std::to_string( index ) );
+                }
+
+                di::core::HeadlessContext context;
+                if( !m_settings.m_outputDir.empty() && !context.create( m_settings.m_backend, m_settings.m_software ) )
+                {
+                    LogE << "Worker " << index << " could not create a headless OpenGL context: " << context.getError() << LogEnd;
+                    return;
+                }
+                process( index * combinations / workers, ( index + 1 ) * combinations / workers );
+            };
+
+            std::vector< std::thread > threads;
+            for( size_t index = 0; index < workers; ++index )
+            {
+                threads.push_back( std::thread( worker, index ) );
+            }
+            for( auto& thread : threads )
+            {
+                thread.join();
+            }
+
+            // The index of all combinations. The images and projects are named after the first column.
+            if( !m_settings.m_outputDir.empty() )
+            {
+                std::ofstream csv( m_settings.m_outputDir + "/sweep.csv" );
+                csv << "name";
+                for( const auto& dimension : m_dimensions )
+                {
+                    csv << ",\"" << dimension.m_algorithm << "/" << dimension.m_parameter << "\"";
+                }
+                csv << ",ok,time,algorithms_run" << std::endl;
+                for( size_t index = 0; index < combinations; ++index )
+                {
+                    const auto& result = m_results[ index ];
+                    csv << getName( index );
+                    for( const auto& value : result.m_values )
+                    {
+                        csv << ",\"" << value << "\"";
+                    }
+                    csv << "," << result.m_ok << "," << result.m_time << "," << result.m_algorithmsRun << std::endl;
+                }
+            }
+
+            return std::all_of( m_results.begin(), m_results.end(),
+                                []( const Result& result )
+                                {
+                                    return result.m_ok;
+                                }
+            );
+        }
+
+        void SweepRunner::process( size_t first, size_t end )
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            // The files of the project are shared by all workers. Parameters and camera are set per worker.
+            auto project = m_project;
+            auto files = project.getState( "files" );
+            project.set( "files", di::core::State() );
+
+            HeadlessNetwork network;
+            network.setStrategy( m_settings.m_strategy );
+            bool ok = network.setState( project );
+            for( const auto& file : files.getNestedStates() )
+            {
+                auto filename = file.second.getValue( "Filename", "" );
+                if( !ok || filename.empty() )
+                {
+                    continue;
+                }
+
+                try
+                {
+                    SPtr< di::core::Reader > reader;
+                    if( file.first == "Mesh" )
+                    {
+                        reader = std::make_shared< di::io::PlyReader >();
+                    }
+                    else
+                    {
+                        reader = std::make_shared< di::io::RegionLabelReader >();
+                    }
+                    ok = network.setData( filename, m_cache.load( reader, filename ) );
+                }
+                catch( const std::exception& e )
+                {
+                    LogE << "Loading \"" << filename << "\" failed: " << e.what() << LogEnd;
+                    ok = false;
+                }
+            }
+
+            auto countRuns = [ &network ]()
+            {
+                size_t runs = 0;
+                for( auto algorithm : network.getProcessingNetwork()->getRunOrder() )
+                {
+                    runs += algorithm->getRunCount();
+                }
+                return runs;
+            };
+
+            for( size_t index = first; ok && ( index < end ); ++index )
+            {
+                auto start = Clock::now();
+                auto name = getName( index );
+                di::core::TraceSpan span( LogTag, name );
+                auto& result = m_results[ index ];
+
+                // Mixed radix: the last dimension changes with every combination.
+                di::core::State parameters;
+                auto remainder = index;
+                result.m_values.resize( m_dimensions.size() );
+                for( size_t d = m_dimensions.size(); d-- > 0; )
+                {
+                    const auto& dimension = m_dimensions[ d ];
+                    result.m_values[ d ] = dimension.m_values[ remainder % dimension.m_values.size() ];
+                    remainder /= dimension.m_values.size();
+                    parameters.set( "parameters/" + dimension.m_algorithm + "/" + dimension.m_parameter, result.m_values[ d ] );
+                }
+
+                // Only changed parameters request an update. Everything else keeps its results.
+                auto runs = countRuns();
+                result.m_ok = network.setState( parameters ) && network.run();
+                result.m_algorithmsRun = countRuns() - runs;
+
+                if( result.m_ok && !m_settings.m_outputDir.empty() )
+                {
+                    auto pixels = network.render( m_settings.m_size, m_settings.m_samples, m_settings.m_background );
+                    result.m_ok = writeBMP( *pixels, m_settings.m_outputDir + "/" + name + ".bmp" );
+                    network.getState().toFile( m_settings.m_outputDir + "/" + name + ".project" );
+                }
+                result.m_time = std::chrono::duration< double >( Clock::now() - start ).count();
+            }
+            network.finalize();
+        }
+
+        std::string SweepRunner::getName( size_t index ) const
+        {
+            auto digits = std::to_string( std::max< size_t >( 1, m_results.size() ) - 1 ).size();
+            std::ostringstream name;
+            name << "sweep_" << std::setw( digits ) << std::setfill( '0' ) << index;
+            return name.str();
+        }
+
+        const std::vector< SweepRunner::Dimension >& SweepRunner::getDimensions() const
+        {
+            return m_dimensions;
+        }
+
+        const std::vector< SweepRunner::Result >& SweepRunner::getResults() const
+        {
+            return m_results;
+        }
+    }
+}
@@ -0,0 +1,195 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_SWEEPRUNNER_H
+#define DI_SWEEPRUNNER_H
+
+#include <string>
+#include <vector>
+
+#include <di/core/State.h>
+
+#include "BatchRunner.h"
+#include "DataSetCache.h"
+
+namespace di
+{
+    namespace cli
+    {
+        /**
+         * Renders one project under all combinations of a set of parameter values. Each worker thread owns a network and processes a contiguous
+         * block of combinations. The combinations are ordered such that parameters of upstream algorithms change least often. As the network only
+         * runs algorithms whose parameters or inputs changed, upstream results are reused until an upstream parameter changes.
+         */
+        class SweepRunner
+        {
+        public:
+            /**
+             * A parameter and the values to try.
+             */
+            struct Dimension
+            {
+                /**
+                 * The runtime name of the algorithm, as used in project files.
+                 */
+                std::string m_algorithm;
+
+                /**
+                 * The parameter name.
+                 */
+                std::string m_parameter;
+
+                /**
+                 * The values, as strings in the format of project files.
+                 */
+                std::vector< std::string > m_values;
+            };
+
+            /**
+             * The outcome of a combination.
+             */
+            struct Result
+            {
+                /**
+                 * The value of each dimension.
+                 */
+                std::vector< std::string > m_values;
+
+                /**
+                 * True if processing and rendering succeeded.
+                 */
+                bool m_ok = false;
+
+                /**
+                 * Time to apply the parameters, process and render, in seconds.
+                 */
+                double m_time = 0.0;
+
+                /**
+                 * Number of algorithms that were run for this combination.
+                 */
+                size_t m_algorithmsRun = 0;
+            };
+
+            /**
+             * Parse a parameter sweep. The format is ALGORITHM/PARAMETER=VALUES. ALGORITHM is the runtime name of the algorithm, like in the
+             * project files. VALUES is either a list of values separated by ; or a numeric range FROM:TO:STEP, including TO.
+             *
+             * \param spec the sweep specification
+             *
+             * \return the dimension
+             *
+             * \throw std::invalid_argument if the specification is invalid.
+             */
+            static Dimension parseDimension( const std::string& spec );
+
+            /**
+             * Create the runner. Rendering uses the settings of a batch run. The output directory receives one image and one project per
+             * combination and a sweep.csv listing all combinations.
+             *
+             * \param settings how to process and render
+             * \param project the project to sweep. Needs files.
+             */
+            SweepRunner( const BatchRunner::Settings& settings, const di::core::State& project );
+
+            /**
+             * Process all combinations. Blocks until all are done.
+             *
+             * \param dimensions the parameters to sweep
+             *
+             * \return true if all combinations succeeded.
+             */
+            bool run( std::vector< Dimension > dimensions );
+
+            /**
+             * The dimensions of the last run, in the order used to enumerate the combinations. The first dimension changes least often.
+             *
+             * \return the dimensions
+             */
+            const std::vector< Dimension >& getDimensions() const;
+
+            /**
+             * The results of the last run, in processing order.
+             *
+             * \return the results
+             */
+            const std::vector< Result >& getResults() const;
+
+        protected:
+        private:
+            /**
+             * Process a block of combinations with a new network. Requires a current OpenGL context if images are requested.
+             *
+             * \param first the first combination
+             * \param end the combination after the last one
+             */
+            void process( size_t first, size_t end );
+
+            /**
+             * Order the dimensions by the position of their algorithms in the network. Upstream first.
+             *
+             * \param dimensions the dimensions to order
+             *
+             * \return false if an algorithm or parameter does not exist.
+             */
+            bool order( std::vector< Dimension >* dimensions ) const;
+
+            /**
+             * The name of a combination. Used for the output files.
+             *
+             * \param index the combination
+             *
+             * \return the name
+             */
+            std::string getName( size_t index ) const;
+
+            /**
+             * The settings.
+             */
+            BatchRunner::Settings m_settings;
+
+            /**
+             * The project to sweep.
+             */
+            di::core::State m_project;
+
+            /**
+             * The files of the project. Loaded once and shared by all workers.
+             */
+            DataSetCache m_cache;
+
+            /**
+             * The dimensions of the last run.
+             */
+            std::vector< Dimension > m_dimensions;
+
+            /**
+             * Results of the last run.
+             */
+            std::vector< Result > m_results;
+        };
+    }
+}
+
+#endif  // DI_SWEEPRUNNER_H
@@ -0,0 +1,221 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <di/core/Filesystem.h>
+
+#include "WorkQueue.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/WorkQueue"
+
+namespace di
+{
+    namespace cli
+    {
+        namespace
+        {
+            /**
+             * Remove the items of an earlier run from a queue sub-directory. These are the numbered files and unfinished results. Other files
+             * are kept.
+             *
+             * \param directory the sub-directory
+             *
+             * \return false if an item could not be removed.
+             */
+            bool removeItems( const std::string& directory )
+            {
+                auto dir = opendir( directory.c_str() );
+                if( !dir )
+                {
+                    return true;
+                }
+
+                std::vector< std::string > items;
+                while( auto entry = readdir( dir ) )  // NOLINT: readdir_r is deprecated. The directory stream is not shared.
+                {
+                    std::string name( entry->d_name );
+                    if( !name.empty() && std::isdigit( static_cast< unsigned char >( name[ 0 ] ) ) )
+                    {
+                        items.push_back( directory + "/" + name );
+                    }
+                }
+                closedir( dir );
+
+                for( const auto& item : items )
+                {
+                    if( std::remove( item.c_str() ) != 0 )
+                    {
+                        LogE << "Could not remove the queue item \"" << item << "\" of an earlier run." << LogEnd;
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+        WorkQueue::WorkQueue( const std::string& directory ):
+            m_directory( directory )
+        {
+        }
+
+        bool WorkQueue::create( size_t count )
+        {
+            if( m_directory.empty() )
+            {
+                std::string pattern = "/tmp/di_queue_XXXXXX";
+                std::vector< char > temp( pattern.begin(), pattern.end() );
+                temp.push_back( '\0' );
+                if( !mkdtemp( temp.data() ) )
+                {
+                    LogE << "Could not create a temporary queue directory." << LogEnd;
+                    return false;
+                }
+                m_directory = temp.data();
+            }
+
+            m_count = count;
+            std::vector< std::string > directories;
+            directories.push_back( m_directory );
+            directories.push_back( m_directory + "/pending" );
+            directories.push_back( m_directory + "/running" );
+            directories.push_back( m_directory + "/done" );
+            for( const auto& directory : directories )
+            {
+                if( ( mkdir( directory.c_str(), 0755 ) != 0 ) && ( errno != EEXIST ) )
+                {
+                    LogE << "Could not create the queue directory \"" << directory << "\"." << LogEnd;
+                    return false;
+                }
+            }
+
+            // A given directory might hold the items of an earlier run. Their results would be taken for the results of this run.
+            if( !removeItems( m_directory + "/pending" ) || !removeItems( m_directory + "/running" ) || !removeItems( m_directory + "/done" ) )
+            {
+                return false;
+            }
+
+            for( size_t index = 0; index < count; ++index )
+            {
+                if( !std::ofstream( getPath( "pending", index ) ) )
+                {
+                    LogE << "Could not create the queue item \"" << getPath( "pending", index ) << "\"." << LogEnd;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool WorkQueue::claim( size_t* index )
+        {
+            // Other processes claim items concurrently. Whoever renames first, owns the item.
+            auto pending = m_directory + "/pending";
+            auto dir = opendir( pending.c_str() );
+            if( !dir )
+            {
+                return false;
+            }
+
+            std::vector< size_t > items;
+            while( auto entry = readdir( dir ) )  // NOLINT: readdir_r is deprecated. The directory stream is not shared.
+            {
+                std::string name( entry->d_name );
+                if( !name.empty() && std::all_of( name.begin(), name.end(), ::isdigit ) )
+                {
+                    items.push_back( std::stoul( name ) );
+                }
+            }
+            closedir( dir );
+
+            std::sort( items.begin(), items.end() );
+            for( auto item : items )
+            {
+                if( std::rename( getPath( "pending", item ).c_str(), getPath( "running", item ).c_str() ) == 0 )
+                {
+                    *index = item;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void WorkQueue::finish( size_t index, const std::string& result )
+        {
+            // Write, then move, so the result is complete once it is visible.
+            auto temp = getPath( "running", index ) + ".result";
+            std::ofstream( temp ) << result;
+            std::rename( temp.c_str(), getPath( "done", index ).c_str() );
+            std::remove( getPath( "running", index ).c_str() );
+        }
+
+        bool WorkQueue::getResult( size_t index, std::string* result ) const
+        {
+            try
+            {
+                *result = di::core::readTextFile( getPath( "done", index ) );
+            }
+            catch( const std::exception& )
+            {
+                return false;
+            }
+            return true;
+        }
+
+        void WorkQueue::remove()
+        {
+            for( size_t index = 0; index < m_count; ++index )
+            {
+                std::remove( getPath( "pending", index ).c_str() );
+                std::remove( getPath( "running", index ).c_str() );
+                std::remove( getPath( "done", index ).c_str() );
+            }
+            rmdir( ( m_directory + "/pending" ).c_str() );
+            rmdir( ( m_directory + "/running" ).c_str() );
+            rmdir( ( m_directory + "/done" ).c_str() );
+            rmdir( m_directory.c_str() );
+        }
+
+        const std::string& WorkQueue::getDirectory() const
+        {
+            return m_directory;
+        }
+
+        std::string WorkQueue::getPath( const std::string& state, size_t index ) const
+        {
+            return m_directory + "/" + state + "/" + std::to_string( index );
+        }
+    }
+}
@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_WORKQUEUE_H
+#define DI_WORKQUEUE_H
+
+#include <string>
+
+namespace di
+{
+    namespace cli
+    {
+        /**
+         * A queue of numbered work items in a directory, shared by processes. Each item is a file. Processes claim items by moving the file from
+         * pending/ to running/, which is atomic. Results are written to done/. Items left in running/ belong to processes that died.
+         */
+        class WorkQueue
+        {
+        public:
+            /**
+             * Use the given directory. Nothing is created yet.
+             *
+             * \param directory the queue directory. Create a temporary directory if empty.
+             */
+            explicit WorkQueue( const std::string& directory = "" );
+
+            /**
+             * Create the directories and one pending item per index. Items of earlier runs are removed first. Only one process may create the
+             * queue, all others use it.
+             *
+             * \param count the number of items
+             *
+             * \return false if the directories or items cannot be created.
+             */
+            bool create( size_t count );
+
+            /**
+             * Claim the next pending item.
+             *
+             * \param index the index of the claimed item
+             *
+             * \return false if there is no pending item left.
+             */
+            bool claim( size_t* index );
+
+            /**
+             * Finish a claimed item by storing its result.
+             *
+             * \param index the item
+             * \param result the result. Any text.
+             */
+            void finish( size_t index, const std::string& result );
+
+            /**
+             * Get the result of an item.
+             *
+             * \param index the item
+             * \param result the result
+             *
+             * \return false if the item is not done.
+             */
+            bool getResult( size_t index, std::string* result ) const;
+
+            /**
+             * Remove all items and the directories. Only call if no process uses the queue anymore.
+             */
+            void remove();
+
+            /**
+             * The queue directory.
+             *
+             * \return the directory
+             */
+            const std::string& getDirectory() const;
+
+        protected:
+        private:
+            /**
+             * The path of an item in a sub-directory of the queue.
+             *
+             * \param state pending, running or done
+             * \param index the item
+             *
+             * \return the path
+             */
+            std::string getPath( const std::string& state, size_t index ) const;
+
+            /**
+             * The queue directory.
+             */
+            std::string m_directory;
+
+            /**
+             * The number of items.
+             */
+            size_t m_count = 0;
+        };
+    }
+}
+
+#endif  // DI_WORKQUEUE_H
@@ -0,0 +1,533 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <di/core/Conversion.h>
+#include <di/core/Filesystem.h>
+#include <di/core/StringUtils.h>
+#include <di/core/Trace.h>
+#include <di/gfx/HeadlessContext.h>
+#include <di/io/LabelSeries.h>
+
+#include "BatchRunner.h"
+#include "Bitmap.h"
+#include "HeadlessNetwork.h"
+#include "SweepRunner.h"
+
+#include <di/core/Logger.h>
+#define LogTag "cli/main"
+
+/**
+ * Print the usage information.
+ */
+void printUsage()
+{
+    std::cerr <<
+    "Usage: di_headless [options] FILE..." << std::endl <<
+    "       di_headless --batch=MANIFEST [options] [PROJECT]" << std::endl <<
+    "       di_headless --sweep=SWEEP... [options] PROJECT" << std::endl <<
+    "  FILE                a .project, .snapshot, .ply, .labels or .labelorder file. Later files replace earlier ones." << std::endl <<
+    "  PROJECT             a .project file with the parameters and camera used for all subjects of a batch or the combinations" << std::endl <<
+    "                      of a sweep." << std::endl <<
+    "  --batch=MANIFEST    process the subjects listed in MANIFEST. One subject per line: mesh, labels, label ordering and an" << std::endl <<
+    "                      optional name, separated by white space. Subjects sharing a mesh share its data." << std::endl <<
+    "  --sweep=SWEEP       vary a parameter as ALGORITHM/PARAMETER=VALUES, with names as in project files. VALUES is a list" << std::endl <<
+    "                      separated by ; or a range FROM:TO:STEP. Repeat to render all combinations." << std::endl <<
+    "  --jobs=N            number of subjects or combinations to process concurrently. Default: number of cores." << std::endl <<
+    "  --processes=N       process a batch using N worker processes instead of threads. Meshes are loaded once and shared." << std::endl <<
+    "  --queue-dir=DIR     the work queue of the worker processes. Default: a temporary directory." << std::endl <<
+    "  --output-dir=DIR    render each subject of a batch to DIR/NAME.bmp, or each combination of a sweep to DIR/sweep_N.bmp" << std::endl <<
+    "                      and DIR/sweep_N.project, listed in DIR/sweep.csv." << std::endl <<
+    "  --strategy=NAME     the visualization to use. Either lines or lic. Default: lines." << std::endl <<
+    "  --image=FILE        render the result to FILE as bitmap." << std::endl <<
+    "  --label-mesh=FILE   the labels belong to the mesh in FILE. Transfer them to the nearest vertices of the loaded mesh." << std::endl <<
+    "  --neighbours=N      number of nearest vertices whose labels vote when transferring labels. Default: 1." << std::endl <<
+    "  --label-series=LIST play the label files listed in LIST, one per line, as frames on the loaded mesh. Renders frame N" << std::endl <<
+    "                      to FILE_N.bmp if --image=FILE.bmp is given." << std::endl <<
+    "  --prefetch=N        number of label frames to load ahead. Default: 2." << std::endl <<
+    "  --width=N           width of the image. Default: 2048." << std::endl <<
+    "  --height=N          height of the image. Default: 1536." << std::endl <<
+    "  --samples=N         multi-sampling of the image. Default: 4." << std::endl <<
+    "  --background=COLOR  background color as r,g,b,a in [0,1]. Default: 1,1,1,1." << std::endl <<
+    "  --hardware          use the default OpenGL driver instead of forcing Mesa llvmpipe." << std::endl <<
+    "  --backend=NAME      how to create the OpenGL context. Either auto, egl or osmesa. Default: auto." << std::endl <<
+    "  --save-project=FILE write files, parameters and camera as project file." << std::endl <<
+    "  --save-snapshot=FILE write parameters, camera and all computed data to FILE. Loading it skips reading and processing." << std::endl <<
+    "  --trace=FILE        write a Chrome trace of the run to FILE." << std::endl <<
+    "  --log-level=LEVEL   debug, info, warning or error. Default: warning." << std::endl;
+}
+
+/**
+ * Load the project files. The last one wins.
+ *
+ * \param projects the project files
+ * \param project the result
+ *
+ * \return false if a file cannot be read.
+ */
+bool loadProjects( const std::vector< std::string >& projects, di::core::State* project )
+{
+    try
+    {
+        for( const auto& file : projects )
+        {
+            *project = di::core::State::fromFile( file );
+        }
+    }
+    catch( const std::exception& e )
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Process all subjects of a manifest and print a summary.
+ *
+ * \param manifest the manifest file
+ * \param projects the template project files. The last one wins.
+ * \param settings how to process and render
+ *
+ * \return true if all subjects were processed.
+ */
+bool runBatch( const std::string& manifest, const std::vector< std::string >& projects, const di::cli::BatchRunner::Settings& settings )
+{
+    di::core::State project;
+    std::vector< di::cli::BatchRunner::Job > subjects;
+    try
+    {
+        subjects = di::cli::BatchRunner::readManifest( manifest );
+    }
+    catch( const std::exception& e )
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    if( !loadProjects( projects, &project ) )
+    {
+        return false;
+    }
+
+    di::cli::BatchRunner runner( settings, project );
+    bool ok = runner.run( subjects );
+
+    const auto& results = runner.getResults();
+    for( size_t i = 0; i < subjects.size(); ++i )
+    {
+        std::cerr << subjects[ i ].m_name << ": " << ( results[ i ].m_ok ? "ok" : "FAILED" ) << " after " << results[ i ].m_time << " s."
+                  << std::endl;
+    }
+    std::cerr << subjects.size() << " subjects, " << runner.getCache().getMisses() << " files loaded, "
+              << runner.getCache().getHits() << " loads shared." << std::endl;
+    return ok;
+}
+
+/**
+ * Render a project under all combinations of the given parameter values and print a summary.
+ *
+ * \param sweeps the sweep specifications
+ * \param projects the project files. The last one wins.
+ * \param settings how to process and render
+ *
+ * \return true if all combinations were processed.
+ */
+bool runSweep( const std::vector< std::string >& sweeps, const std::vector< std::string >& projects,
+               const di::cli::BatchRunner::Settings& settings )
+{
+    di::core::State project;
+    std::vector< di::cli::SweepRunner::Dimension > dimensions;
+    try
+    {
+        for( const auto& sweep : sweeps )
+        {
+            dimensions.push_back( di::cli::SweepRunner::parseDimension( sweep ) );
+        }
+    }
+    catch( const std::exception& e )
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    if( !loadProjects( projects, &project ) )
+    {
+        return false;
+    }
+
+    di::cli::SweepRunner runner( settings, project );
+    bool ok = runner.run( dimensions );
+
+    size_t runs = 0;
+    for( const auto& result : runner.getResults() )
+    {
+        runs += result.m_algorithmsRun;
+    }
+    std::cerr << runner.getResults().size() << " combinations, " << runs << " algorithm runs." << std::endl;
+    return ok;
+}
+
+/**
+ * Play a label series. Each frame replaces the labels of the network, is processed and rendered.
+ *
+ * \param network the network with mesh and parameters
+ * \param list the file listing the label files
+ * \param prefetch the number of frames to load ahead
+ * \param image the image file. Frames are rendered to files with the frame number appended to the name. Empty to not render.
+ * \param size the size of the images
+ * \param samples multi-sampling
+ * \param background the background color
+ *
+ * \return true if all frames were processed.
+ */
+bool runLabelSeries( di::cli::HeadlessNetwork& network, const std::string& list, size_t prefetch, const std::string& image,
+                     const glm::vec2& size, int samples, const glm::vec4& background )
+{
+    typedef std::chrono::steady_clock Clock;
+
+    std::vector< std::string > frames;
+    try
+    {
+        frames = di::io::LabelSeries::readList( list );
+    }
+    catch( const std::exception& e )
+    {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    if( frames.empty() )
+    {
+        std::cerr << "The label series \"" << list << "\" is empty." << std::endl;
+        return false;
+    }
+    di::io::LabelSeries series( frames, prefetch );
+
+    // Insert the frame number in front of the extension: image.bmp becomes image_0000.bmp.
+    auto dot = image.find_last_of( '.' );
+    if( ( dot == std::string::npos ) || ( image.find_first_of( "/\\", dot ) != std::string::npos ) )
+    {
+        dot = image.size();
+    }
+
+    auto start = Clock::now();
+    bool ok = true;
+    for( size_t frame = 0; ok && ( frame < series.getNumFrames() ); ++frame )
+    {
+        di::core::TraceSpan span( LogTag, "Frame " + std::to_string( frame ) );
+        try
+        {
+            ok = network.setData( series.getFile( frame ), series.getFrame( frame ) ) && network.run();
+        }
+        catch( const std::exception& e )
+        {
+            std::cerr << "Could not load frame " << frame << " from \"" << series.getFile( frame ) << "\": " << e.what() << std::endl;
+            ok = false;
+        }
+
+        if( ok && !image.empty() )
+        {
+            std::string number = std::to_string( frame );
+            number.insert( 0, ( number.size() < 4 ) ? ( 4 - number.size() ) : 0, '0' );
+            auto pixels = network.render( size, samples, background );
+            ok = di::cli::writeBMP( *pixels, image.substr( 0, dot ) + "_" + number + image.substr( dot ) );
+        }
+    }
+
+    double seconds = std::chrono::duration< double >( Clock::now() - start ).count();
+    std::cerr << series.getNumFrames() << " frames, " << series.getPrefetchHits() << " prefetched, "
+              << ( series.getNumFrames() / seconds ) << " frames/s." << std::endl;
+    return ok;
+}
+
+int main( int argc, char** argv )
+{
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+
+    std::vector< std::string > files;
+    auto strategy = di::cli::HeadlessNetwork::Strategy::Lines;
+    std::string image;
+    size_t width = 2048;
+    size_t height = 1536;
+    int samples = 4;
+    glm::vec4 background( 1.0 );
+    bool software = true;
+    auto backend = di::core::HeadlessContext::Backend::Auto;
+    std::string project;
+    std::string snapshot;
+    std::string trace;
+    std::string batch;
+    std::vector< std::string > sweeps;
+    size_t jobs = std::max< size_t >( 1, std::thread::hardware_concurrency() );
+    std::string outputDir;
+    size_t processes = 0;
+    std::string queueDir;
+    std::string labelSeries;
+    size_t prefetch = 2;
+    std::string labelMesh;
+    int neighbours = 1;
+    auto logLevel = di::core::LogLevel::Warning;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        std::string arg( argv[ i ] );
+        if( arg.find( "--" ) != 0 )
+        {
+            files.push_back( arg );
+            continue;
+        }
+
+        auto pos = arg.find( '=' );
+        auto key = di::core::toLower( arg.substr( 0, pos ) );
+        auto value = ( pos == std::string::npos ) ? std::string() : arg.substr( pos + 1 );
+
+        try
+        {
+            if( key == "--strategy" && ( di::core::toLower( value ) == "lines" ) )
+            {
+                strategy = di::cli::HeadlessNetwork::Strategy::Lines;
+            }
+            else if( key == "--strategy" && ( di::core::toLower( value ) == "lic" ) )
+            {
+                strategy = di::cli::HeadlessNetwork::Strategy::LIC;
+            }
+            else if( key == "--image" )
+            {
+                image = value;
+            }
+            else if( key == "--label-mesh" )
+            {
+                labelMesh = value;
+            }
+            else if( key == "--neighbours" )
+            {
+                neighbours = di::core::fromString< int >( value );
+            }
+            else if( key == "--label-series" )
+            {
+                labelSeries = value;
+            }
+            else if( key == "--prefetch" )
+            {
+                prefetch = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--width" )
+            {
+                width = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--height" )
+            {
+                height = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--samples" )
+            {
+                samples = di::core::fromString< int >( value );
+            }
+            else if( key == "--background" )
+            {
+                background = di::core::fromString< glm::vec4 >( value );
+            }
+            else if( key == "--hardware" )
+            {
+                software = false;
+            }
+            else if( ( key == "--backend" ) && di::core::HeadlessContext::parseBackend( value, backend ) )
+            {
+                continue;
+            }
+            else if( key == "--save-project" )
+            {
+                project = value;
+            }
+            else if( key == "--save-snapshot" )
+            {
+                snapshot = value;
+            }
+            else if( key == "--batch" )
+            {
+                batch = value;
+            }
+            else if( key == "--sweep" )
+            {
+                sweeps.push_back( value );
+            }
+            else if( key == "--jobs" )
+            {
+                jobs = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--processes" )
+            {
+                processes = di::core::fromString< size_t >( value );
+            }
+            else if( key == "--queue-dir" )
+            {
+                queueDir = value;
+            }
+            else if( key == "--output-dir" )
+            {
+                outputDir = value;
+            }
+            else if( key == "--trace" )
+            {
+                trace = value;
+            }
+            else if( ( key == "--log-level" ) && di::core::Logger::parseLevel( value, logLevel ) )
+            {
+                continue;
+            }
+            else
+            {
+                printUsage();
+                return ( key == "--help" ) ? 0 : 1;
+            }
+        }
+        catch( const std::exception& )
+        {
+            std::cerr << "Invalid value in \"" << arg << "\"." << std::endl;
+            return 1;
+        }
+    }
+
+    if( ( files.empty() && batch.empty() ) || ( !batch.empty() && !sweeps.empty() ) || ( width == 0 ) || ( height == 0 ) || ( samples < 1 ) ||
+        ( neighbours < 1 ) || ( !labelMesh.empty() && ( !batch.empty() || !sweeps.empty() || !labelSeries.empty() ) ) )
+    {
+        printUsage();
+        return 1;
+    }
+
+    di::core::Logger::setLevel( logLevel );
+    if( !trace.empty() )
+    {
+        di::core::Trace::setEnabled( true );
+        di::core::Trace::setThreadName( "Main" );
+    }
+
+    // The shaders are searched relative to the executable.
+    std::string executable( argv[ 0 ] );
+    auto separator = executable.find_last_of( "/\\" );
+    di::core::initRuntimePath( ( separator == std::string::npos ) ? "." : executable.substr( 0, separator ) );
+
+    bool ok = true;
+    if( !batch.empty() || !sweeps.empty() )
+    {
+        di::cli::BatchRunner::Settings settings;
+        settings.m_workers = jobs;
+        settings.m_strategy = strategy;
+        settings.m_outputDir = outputDir;
+        settings.m_size = glm::vec2( width, height );
+        settings.m_samples = samples;
+        settings.m_background = background;
+        settings.m_backend = backend;
+        settings.m_software = software;
+        settings.m_processes = processes;
+        settings.m_queueDir = queueDir;
+        ok = batch.empty() ? runSweep( sweeps, files, settings ) : runBatch( batch, files, settings );
+    }
+    else
+    {
+        di::cli::HeadlessNetwork network;
+        network.setStrategy( strategy );
+
+        for( const auto& file : files )
+        {
+            auto ext = di::core::toLower( di::core::getFileExtension( file ) );
+            if( ext == "project" )
+            {
+                ok = ok && network.loadProject( file );
+            }
+            else if( ext == "snapshot" )
+            {
+                ok = ok && network.loadSnapshot( file );
+            }
+            else
+            {
+                ok = ok && network.loadFile( file );
+            }
+        }
+
+        if( ok && !labelMesh.empty() )
+        {
+            ok = network.transferLabels( labelMesh, neighbours );
+        }
+
+        // The labels of a series replace the loaded ones frame by frame. Rendering them needs the context before processing.
+        if( labelSeries.empty() )
+        {
+            ok = ok && network.run();
+        }
+
+        if( ok && ( !image.empty() || !labelSeries.empty() ) )
+        {
+            di::core::HeadlessContext context;
+            if( image.empty() || context.create( backend, software ) )
+            {
+                if( !image.empty() )
+                {
+                    LogI << "Renderer: " << context.getRenderer() << " - OpenGL " << context.getVersion() << LogEnd;
+                }
+                if( labelSeries.empty() )
+                {
+                    auto pixels = network.render( glm::vec2( width, height ), samples, background );
+                    ok = di::cli::writeBMP( *pixels, image );
+                }
+                else
+                {
+                    ok = runLabelSeries( network, labelSeries, prefetch, image, glm::vec2( width, height ), samples, background );
+                }
+                network.finalize();
+            }
+            else
+            {
+                std::cerr << "Could not create a headless OpenGL context: " << context.getError() << std::endl;
+                ok = false;
+            }
+        }
+
+        if( ok && !project.empty() )
+        {
+            network.getState().toFile( project );
+        }
+
+        if( ok && !snapshot.empty() )
+        {
+            ok = network.saveSnapshot( snapshot );
+        }
+    }
+
+    if( !trace.empty() )
+    {
+        di::core::Trace::writeChromeTrace( trace );
+    }
+
+    std::cerr << ( ok ? "Done" : "Failed" ) << " after "
+              << std::chrono::duration< double >( Clock::now() - start ).count() << " s." << std::endl;
+    di::core::Logger::flush();
+    return ok ? 0 : 1;
+}
+
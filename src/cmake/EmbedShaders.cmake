@@ -0,0 +1,49 @@
+#----------------------------------------------------------------------------------------
+#
+# Project: DirectionalityIndicator
+#
+# Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+#           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+#
+# This file is part of DirectionalityIndicator.
+#
+# DirectionalityIndicator is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DirectionalityIndicator is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+#
+#----------------------------------------------------------------------------------------
+
+# Generates a source file providing the code of the given shaders as strings. Used by GENERATE_EMBEDDED_SHADERS. Call in script mode:
+#
+#   cmake -DENTRIES="name=file|name=file" -DOUTPUT=EmbeddedShaders.cpp -P EmbedShaders.cmake
+#
+# ENTRIES the shaders as pairs of name and file, separated by "|"
+# OUTPUT the source file to write
+
+STRING( REPLACE "|" ";" Entries "${ENTRIES}" )
+
+SET( Code "// Generated by the build system from the shaders of the library. Do not edit.\n\n" )
+SET( Code "${Code}#include <map>\n#include <string>\n\n" )
+SET( Code "${Code}namespace di\n{\n    namespace core\n    {\n" )
+SET( Code "${Code}        const std::map< std::string, std::string >& getEmbeddedShaders()\n        {\n" )
+SET( Code "${Code}            static const std::map< std::string, std::string > shaders =\n            {\n" )
+FOREACH( entry ${Entries} )
+    STRING( REGEX REPLACE "=.*$" "" name "${entry}" )
+    STRING( REGEX REPLACE "^[^=]*=" "" fname "${entry}" )
+
+    # Raw strings keep the code as it is. GLSL does not contain the delimiter.
+    FILE( READ ${fname} content )
+    SET( Code "${Code}                { \"${name}\", R\"di_glsl(${content})di_glsl\" },\n" )
+ENDFOREACH( entry )
+SET( Code "${Code}            };\n            return shaders;\n        }\n    }\n}\n" )
+
+FILE( WRITE ${OUTPUT} "${Code}" )
@@ -68,6 +68,12 @@ namespace di
             LogD << "inject: data instance " << static_cast< const void* >( data.get() ) << " - " << ( m_injectionData != data ) << "." << LogEnd;
             m_injectionData = data;
         }
+
+        ConstSPtr< di::core::ConnectorTransferable > DataInject::getInjected()
+        {
+            std::lock_guard<std::mutex> lock( m_injectionDataMutex );
+            return m_injectionData;
+        }
     }
 }
 
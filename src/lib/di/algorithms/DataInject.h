@@ -63,6 +63,13 @@ namespace di
              */
             void inject( ConstSPtr< di::core::ConnectorTransferable > data );
 
+            /**
+             * The data injected last.
+             *
+             * \return the data. Can be nullptr.
+             */
+            ConstSPtr< di::core::ConnectorTransferable > getInjected();
+
         protected:
         private:
             /**
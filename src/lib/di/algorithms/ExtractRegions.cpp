@@ -36,6 +36,7 @@
 #include <chrono>
 #include <iostream>
 
+#include <di/core/ParallelFor.h>
 #include <di/core/data/TriangleDataSet.h>
 #include <di/core/data/LineDataSet.h>
 #include <di/core/data/PointDataSet.h>
@@ -99,20 +100,117 @@ namespace di
         void marchRegion( size_t vertexID,
                           std::vector< size_t >& connectedAndEqual,
                           std::vector< bool >& visited,
-                          ConstSPtr< core::TriangleMesh >& source,
+                          const std::vector< std::vector< size_t > >& neighbourhood,
                           CriterionFunctorType criterion
                         )
         {
-            auto directNeighbours = source->getNeighbourVertices( vertexID );
-            for( auto n : directNeighbours )
+            // Depth-first walk with an explicit stack. Recursion overflows the call stack for regions with a few hundred thousand vertices. Each
+            // entry keeps the neighbours of a vertex and the next neighbour to check, which results in the same visiting order as recursion.
+            struct MarchState
             {
-                if( !visited[ n ] && criterion( n, vertexID ) )
+                size_t m_vertex;
+                const std::vector< size_t >* m_neighbours;
+                size_t m_next;
+            };
+
+            std::vector< MarchState > stack;
+            stack.push_back( MarchState{ vertexID, &neighbourhood[ vertexID ], 0 } );
+            while( !stack.empty() )
+            {
+                auto& current = stack.back();
+                if( current.m_next == current.m_neighbours->size() )
+                {
+                    stack.pop_back();
+                    continue;
+                }
+
+                auto from = current.m_vertex;
+                auto n = ( *current.m_neighbours )[ current.m_next++ ];
+                if( !visited[ n ] && criterion( n, from ) )
                 {
                     connectedAndEqual.push_back( n );
                     visited[ n ] = true;
-                    marchRegion( n, connectedAndEqual, visited, source, criterion );
+                    stack.push_back( MarchState{ n, &neighbourhood[ n ], 0 } );
+                }
+            }
+        }
+
+        void ExtractRegions::updateNeighbourhood( ConstSPtr< di::core::TriangleMesh > mesh )
+        {
+            if( m_neighbourhoodMesh == mesh )
+            {
+                return;
+            }
+
+            // The first query builds the inverse index of the mesh. This is not thread-safe.
+            m_neighbourhood.assign( mesh->getNumVertices(), std::vector< size_t >() );
+            if( mesh->getNumVertices() )
+            {
+                m_neighbourhood[ 0 ] = mesh->getNeighbourVertices( 0 );
+            }
+            di::core::parallelFor( 1, mesh->getNumVertices(),
+                [ this, &mesh ]( size_t from, size_t to )
+                {
+                    for( size_t vertexID = from; vertexID < to; ++vertexID )
+                    {
+                        m_neighbourhood[ vertexID ] = mesh->getNeighbourVertices( vertexID );
+                    }
+                }
+            );
+            m_neighbourhoodMesh = mesh;
+
+            // Components do not interact. Each gets its part of the neighbourhood, in its own indices.
+            auto components = di::core::splitComponents( *mesh );
+            m_components.clear();
+            if( components.size() < 2 )
+            {
+                return;
+            }
+
+            std::vector< size_t > localIndex( mesh->getNumVertices() );
+            for( const auto& component : components )
+            {
+                for( size_t i = 0; i < component.m_vertices.size(); ++i )
+                {
+                    localIndex[ component.m_vertices[ i ] ] = i;
                 }
             }
+
+            m_components.resize( components.size() );
+            di::core::parallelFor( 0, components.size(),
+                [ this, &components, &localIndex ]( size_t from, size_t to )
+                {
+                    for( size_t c = from; c < to; ++c )
+                    {
+                        auto& component = m_components[ c ];
+                        component.m_submesh = std::move( components[ c ] );
+
+                        // Only the vertices are mapped back.
+                        std::vector< size_t >().swap( component.m_submesh.m_triangles );
+                        component.m_neighbourhood.resize( component.m_submesh.m_vertices.size() );
+                        for( size_t i = 0; i < component.m_neighbourhood.size(); ++i )
+                        {
+                            for( auto neighbour : m_neighbourhood[ component.m_submesh.m_vertices[ i ] ] )
+                            {
+                                component.m_neighbourhood[ i ].push_back( localIndex[ neighbour ] );
+                            }
+                        }
+                    }
+                },
+                1
+            );
+            LogD << "The mesh has " << m_components.size() << " connected components." << LogEnd;
+        }
+
+        void ExtractRegions::invalidate()
+        {
+            m_neighbourhoodMesh = nullptr;
+            m_neighbourhood.clear();
+            m_components.clear();
+            m_lastMesh = nullptr;
+            m_lastLabels = nullptr;
+            m_lastLabelOrdering = nullptr;
+            m_lastResult = nullptr;
         }
 
         void ExtractRegions::process()
@@ -130,6 +228,28 @@ namespace di
             auto attribute = triangleDataSet->getAttributes< 0 >(); // the color in our case
             auto labels = triangleLabelDataSet->getAttributes< 0 >();
 
+            // Consecutive frames of a time series often have the same labels.
+            if( m_lastResult && ( m_lastMesh == triangleDataSet ) && ( m_lastLabelOrdering == labelOrderDataSet ) &&
+                ( m_lastDirectionSwitch == m_enableDirectionSwitch->get() ) && ( *m_lastLabels == *labels ) )
+            {
+                LogD << "Labels did not change. Keeping the last result." << LogEnd;
+                return;
+            }
+
+            // Keep the result for the next run.
+            auto setResult = [ & ]( ConstSPtr< di::core::TriangleVectorField > result )
+            {
+                m_lastMesh = triangleDataSet;
+                m_lastLabels = labels;
+                m_lastLabelOrdering = labelOrderDataSet;
+                m_lastDirectionSwitch = m_enableDirectionSwitch->get();
+                m_lastResult = result;
+                m_vectorOutput->setData( result );
+            };
+
+            // Walking the mesh is the main work. Building the neighbourhood is as expensive as one walk. Share it among runs on the same mesh.
+            updateNeighbourhood( triangles );
+
             // Get label order information if defined
             di::ConstSPtr< di::io::RegionLabelReader::AttributeType > labelOrders = nullptr;
             if( labelOrderDataSet )
@@ -142,8 +262,8 @@ namespace di
                 LogE << "Number of labels needs to match the number of vertices in the triangle mesh." << LogEnd;
             }
 
-            // Debug Code
-            if( labelOrders )
+            // Debug Code. Skip it completely if nobody will see it.
+            if( labelOrders && di::core::Logger::isEnabled( di::core::LogLevel::Debug ) )
             {
                 LogD << "Label ordering: ";
                 for( auto l : *labelOrders )
@@ -153,6 +273,49 @@ namespace di
                 LogContinue << " - total: " << labelOrders->size() << LogEnd;
             }
 
+            if( m_components.empty() || ( labels->size() != triangles->getNumVertices() ) )
+            {
+                auto vectorAttribute = computeDirections( triangles, attribute, labels, labelOrders, m_neighbourhood, &getProgress() );
+                setResult( std::make_shared< di::core::TriangleVectorField >( "Directionality", triangles, vectorAttribute ) );
+                return;
+            }
+
+            // Process the components in parallel and stitch the results. Each component is processed serially by one worker.
+            auto vectorAttribute = std::make_shared< di::Vec3Array >( triangles->getNumVertices(), glm::vec3( 0.0f ) );
+            getProgress().begin( "Processing components", triangles->getNumVertices() );
+            di::core::parallelFor( 0, m_components.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t c = from; c < to; ++c )
+                    {
+                        const auto& submesh = m_components[ c ].m_submesh;
+                        auto componentColors = ( attribute && ( attribute->size() == triangles->getNumVertices() ) ) ?
+                                                di::core::remapAttribute( *attribute, submesh.m_vertices, false ) :
+                                                std::make_shared< di::RGBAArray >( submesh.m_vertices.size() );
+
+                        // The stages of a component are not reported. Only the overall progress.
+                        di::core::Progress componentProgress;
+                        auto directions = computeDirections( submesh.m_mesh, componentColors,
+                                                             di::core::remapAttribute( *labels, submesh.m_vertices, false ),
+                                                             labelOrders, m_components[ c ].m_neighbourhood, &componentProgress );
+                        di::core::stitchAttribute( *directions, submesh.m_vertices, vectorAttribute.get(), false );
+                        getProgress().advance( submesh.m_vertices.size() );
+                    }
+                },
+                1
+            );
+            getProgress().end();
+
+            LogD << "Done. Updating output." << LogEnd;
+            setResult( std::make_shared< di::core::TriangleVectorField >( "Directionality", triangles, vectorAttribute ) );
+        }
+
+        SPtr< di::Vec3Array > ExtractRegions::computeDirections( ConstSPtr< di::core::TriangleMesh > triangles, ConstSPtr< di::RGBAArray > attribute,
+                                                                 ConstSPtr< di::io::RegionLabelReader::AttributeType > labels,
+                                                                 ConstSPtr< di::io::RegionLabelReader::AttributeType > labelOrders,
+                                                                 const std::vector< std::vector< size_t > >& neighbourhood,
+                                                                 di::core::Progress* progress ) const
+        {
             //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
             //
             // Extract Directionality on Surface -- Case 1
@@ -168,10 +331,13 @@ namespace di
                 auto vectorAttribute = std::make_shared< di::Vec3Array >( triangles->getNumVertices() );
 
                 // This case is mostly trivial. Calculate a direction for each vertex of the mesh:
+                progress->begin( "Calculating gradients", triangles->getNumVertices() );
                 for( size_t vertexID = 0; vertexID < triangles->getNumVertices(); ++vertexID )
                 {
+                    progress->advance();
+
                     // Get neighbours
-                    auto neighbours = triangles->getNeighbourVertices( vertexID );
+                    const auto& neighbours = neighbourhood[ vertexID ];
 
                     // Accumulate direction in here
                     auto direction = glm::vec3( 0.0 );
@@ -210,13 +376,10 @@ namespace di
                     // Store
                     vectorAttribute->at( vertexID ) = glm::normalize( direction );
                 }
-
-                // Update outputs
-                LogD << "Done. Updating output." << LogEnd;
-                m_vectorOutput->setData( std::make_shared< di::core::TriangleVectorField >( "Directionality", triangles, vectorAttribute ) );
+                progress->end();
 
                 // Case 1 finished. Stop here.
-                return;
+                return vectorAttribute;
             }
 
             // End of Case one
@@ -249,6 +412,7 @@ namespace di
 
             // Iterate all triangles and transform to lines
             size_t regionVertexCount = 0; // keep track of how many vertices where associated
+            progress->begin( "Finding regions", triangles->getNumVertices() );
             for( size_t vertID = 0; vertID < triangles->getNumVertices(); ++vertID )
             {
                 // already visited?
@@ -258,7 +422,7 @@ namespace di
 
                     // -> find all direct and indirect neighbours:
                     std::vector< size_t > connectedAndEqual;
-                    marchRegion( vertID, connectedAndEqual, visited, triangles,
+                    marchRegion( vertID, connectedAndEqual, visited, m_neighbourhood,
                         [ & ]( size_t v1, size_t v2 )
                         {
                             return ( labels->at( v1 ) == labels->at( v2 ) );
@@ -270,6 +434,7 @@ namespace di
                     regionColors->push_back( attribute->at( vertID ) ); // take source color as palette here
                     regionLabels->push_back( labels->at( vertID ) );
                     regionVertexCount += connectedAndEqual.size();
+                    progress->advance( connectedAndEqual.size() );
 
                     // also build the inverse list
                     for( auto v : connectedAndEqual )
@@ -279,25 +444,30 @@ namespace di
                 }
             }
 
+            progress->end();
+
             LogD << "Associated " << regionVertexCount << " vertices of " << triangles->getNumVertices() << " with "  <<
                     regionVertices.size() << " non-connected regions." << LogEnd;
 
-            // Some output for verification.
-            size_t internalID = 0;
-            for( auto r : regionVertices )
+            // Some output for verification. This iterates all vertices of all regions. Skip it completely if nobody will see it.
+            if( di::core::Logger::isEnabled( di::core::LogLevel::Debug ) )
             {
-                size_t rmin = r.front();
-                size_t rmax = r.front();
-
-                for( auto v : r )
+                size_t internalID = 0;
+                for( const auto& r : regionVertices )
                 {
-                    rmin = std::min( rmin, v );
-                    rmax = std::max( rmax, v );
-                }
+                    size_t rmin = r.front();
+                    size_t rmax = r.front();
 
-                LogD << "Region " << internalID << " Vertex ID range: [ " << rmin << ", " << rmax << " ]" << " Label: " << regionLabels->at(
-                        internalID ) << "." << LogEnd;
-                internalID++;
+                    for( auto v : r )
+                    {
+                        rmin = std::min( rmin, v );
+                        rmax = std::max( rmax, v );
+                    }
+
+                    LogD << "Region " << internalID << " Vertex ID range: [ " << rmin << ", " << rmax << " ]" << " Label: " <<
+                            regionLabels->at( internalID ) << "." << LogEnd;
+                    internalID++;
+                }
             }
 
 
@@ -384,8 +554,10 @@ namespace di
             LogD << "Masked all vertices that are ignored according to label order list." << LogEnd;
 
             // Iterate all vertices, decide for directionality if it is a border vertex
+            progress->begin( "Marching borders", triangles->getNumVertices() );
             for( size_t vertexID = 0; vertexID < triangles->getNumVertices(); ++vertexID )
             {
+                progress->advance();
                 if( vertexIgnore.at( vertexID ) )
                 {
                     continue;
@@ -396,7 +568,7 @@ namespace di
                 auto label = labels->at( vertexID );
 
                 // Get all triangles sharing this vertex
-                auto neighbourVertices = triangles->getNeighbourVertices( vertexID );
+                const auto& neighbourVertices = neighbourhood[ vertexID ];
 
                 // Collect directions of all borders
                 std::vector< glm::vec3 > vertexBorderVectors;
@@ -455,6 +627,7 @@ namespace di
                 }
             }
 
+            progress->end();
             LogD << "Done marching borders." << LogEnd;
 
             //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -463,7 +636,9 @@ namespace di
             //
             //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-            // This is an iterative process to spread the values in to each vertex by using its neighbours
+            // This is an iterative process to spread the values in to each vertex by using its neighbours. The number of iterations is unknown, but
+            // the number of vertices to set is known.
+            progress->begin( "Spreading directions", std::count( vectorAttributeSet.begin(), vectorAttributeSet.end(), false ) );
             bool keepRunning = true;
             while( keepRunning )
             {
@@ -480,7 +655,7 @@ namespace di
                     }
 
                     // Get neighbours
-                    auto neighbours = triangles->getNeighbourVertices( vertexID );
+                    const auto& neighbours = neighbourhood[ vertexID ];
 
                     // We need to know how much neighbours already have a value and the longest distance between those neighbours
                     size_t includedNeighbours = 0;
@@ -569,6 +744,7 @@ namespace di
 
                     vectorAttribute->at( vertexID ) = meanVec / factor;
                     nowSet.at( vertexID ) = true;
+                    progress->advance();
                 }
 
                 // As this is iterative and will converge -> go on until it converged
@@ -613,11 +789,11 @@ namespace di
                 vectorAttributeSet = nowSet;
             }
 
+            progress->end();
             LogD << "Done propagating directions." << LogEnd;
 
             // Update outputs
-            LogD << "Done. Updating output." << LogEnd;
-            m_vectorOutput->setData( std::make_shared< di::core::TriangleVectorField >( "Directionality", triangles, vectorAttribute ) );
+            return vectorAttribute;
         }
     }
 }
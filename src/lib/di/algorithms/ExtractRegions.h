@@ -31,6 +31,7 @@
 
 #include <di/core/Algorithm.h>
 #include <di/core/data/DataSetTypes.h>
+#include <di/core/data/Submesh.h>
 #include <di/io/RegionLabelReader.h>
 #include <di/core/ParameterTypes.h>
 
@@ -59,6 +60,12 @@ namespace di
              */
             virtual void process();
 
+            /**
+             * Forget the neighbourhood and the result kept from earlier runs. The next process() computes everything again, even for the same
+             * inputs. Benchmarks use this to measure the processing instead of the reuse.
+             */
+            void invalidate();
+
             /**
              * Associate each region with its neighbours. The size_t is the region index.
              */
@@ -117,6 +124,89 @@ namespace di
              */
             SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_dataLabelOrderingInput;
 
+            /**
+             * Build \ref m_neighbourhood and \ref m_components if the mesh is not the one of the last run.
+             *
+             * \param mesh the mesh
+             */
+            void updateNeighbourhood( ConstSPtr< di::core::TriangleMesh > mesh );
+
+            /**
+             * Calculate the directions on a mesh. Only uses the neighbourhood of each vertex. Connected components can thus be processed
+             * independently and concurrently.
+             *
+             * \param triangles the mesh
+             * \param attribute the vertex colors
+             * \param labels the vertex labels
+             * \param labelOrders the label ordering. Can be nullptr.
+             * \param neighbourhood the neighbour vertices of each vertex
+             * \param progress where to report the progress
+             *
+             * \return the direction of each vertex
+             */
+            SPtr< di::Vec3Array > computeDirections( ConstSPtr< di::core::TriangleMesh > triangles, ConstSPtr< di::RGBAArray > attribute,
+                                                     ConstSPtr< di::io::RegionLabelReader::AttributeType > labels,
+                                                     ConstSPtr< di::io::RegionLabelReader::AttributeType > labelOrders,
+                                                     const std::vector< std::vector< size_t > >& neighbourhood, di::core::Progress* progress ) const;
+
+            /**
+             * The mesh \ref m_neighbourhood belongs to.
+             */
+            ConstSPtr< di::core::TriangleMesh > m_neighbourhoodMesh;
+
+            /**
+             * The neighbour vertices of each vertex, including the vertex itself. Frames of a time series share the mesh and thus the
+             * neighbourhood.
+             */
+            std::vector< std::vector< size_t > > m_neighbourhood;
+
+            /**
+             * A connected component of the mesh.
+             */
+            struct Component
+            {
+                /**
+                 * The submesh and its vertex mapping. The triangle mapping is not needed and dropped.
+                 */
+                di::core::Submesh m_submesh;
+
+                /**
+                 * The neighbourhood in the indices of the submesh.
+                 */
+                std::vector< std::vector< size_t > > m_neighbourhood;
+            };
+
+            /**
+             * The connected components of \ref m_neighbourhoodMesh. Empty if it has only one. This copies the vertices and the neighbourhood
+             * once more. They are kept on purpose: the frames of a time series only change the labels, and splitting the mesh again would cost
+             * as much as building the neighbourhood. \ref invalidate or a new mesh frees them.
+             */
+            std::vector< Component > m_components;
+
+            /**
+             * Mesh of the last run.
+             */
+            ConstSPtr< di::core::TriangleDataSet > m_lastMesh;
+
+            /**
+             * Labels of the last run.
+             */
+            ConstSPtr< di::io::RegionLabelReader::AttributeType > m_lastLabels;
+
+            /**
+             * Label ordering of the last run.
+             */
+            ConstSPtr< di::io::RegionLabelReader::DataSetType > m_lastLabelOrdering;
+
+            /**
+             * Direction switch of the last run.
+             */
+            bool m_lastDirectionSwitch = false;
+
+            /**
+             * Result of the last run. Reused if only the instance of the labels changed, but not their values.
+             */
+            ConstSPtr< di::core::TriangleVectorField > m_lastResult;
         };
     }
 }
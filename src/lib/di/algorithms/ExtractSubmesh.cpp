@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <di/core/ParallelFor.h>
+#include <di/core/data/Submesh.h>
+
+#include "ExtractSubmesh.h"
+
+#include <di/core/Logger.h>
+#define LogTag "algorithms/ExtractSubmesh"
+
+namespace di
+{
+    namespace algorithms
+    {
+        ExtractSubmesh::ExtractSubmesh():
+            Algorithm( "Extract Submesh",
+                       "Extract the part of the mesh covered by the selected labels." )
+        {
+            // 1: the outputs
+            m_dataOutput = addOutput< di::core::TriangleDataSet >(
+                    "Triangle Mesh",
+                    "The triangles of the selected labels."
+            );
+
+            m_dataLabelOutput = addOutput< di::io::RegionLabelReader::DataSetType >(
+                    "Triangle Labels",
+                    "The labels of the submesh vertices."
+            );
+
+            // 2: the inputs
+            m_dataInput = addInput< di::core::TriangleDataSet >(
+                    "Triangle Mesh",
+                    "The triangle data to process."
+            );
+
+            m_dataLabelInput = addInput< di::io::RegionLabelReader::DataSetType >(
+                    "Triangle Labels",
+                    "Labels to assign a region to each mesh vertex."
+            );
+
+            m_labels = addParameter< std::vector< int > >(
+                    "Labels",
+                    "The labels to keep as comma separated list. Leave empty to keep the whole mesh.",
+                    std::vector< int >()
+            );
+
+            m_includeBorder = addParameter< bool >(
+                    "Include Border",
+                    "Keep the triangles between the selected regions and their neighbours. Needed to find directions towards the neighbours.",
+                    true
+            );
+        }
+
+        ExtractSubmesh::~ExtractSubmesh()
+        {
+            // nothing to clean up so far
+        }
+
+        void ExtractSubmesh::process()
+        {
+            // Get input data
+            auto triangleDataSet = m_dataInput->getData();
+            auto triangleLabelDataSet = m_dataLabelInput->getData();
+            if( !triangleDataSet )
+            {
+                return;
+            }
+
+            // Nothing selected or nothing to select by: pass the data through without copying it. A mesh without labels still gets rendered.
+            auto selection = m_labels->get();
+            if( selection.empty() || !triangleLabelDataSet )
+            {
+                m_dataOutput->setData( triangleDataSet );
+                m_dataLabelOutput->setData( triangleLabelDataSet );
+                return;
+            }
+
+            auto triangles = triangleDataSet->getGrid();
+            auto colors = triangleDataSet->getAttributes< 0 >();
+            auto labels = triangleLabelDataSet->getAttributes< 0 >();
+            if( labels->size() != triangles->getNumVertices() )
+            {
+                LogE << "The mesh has " << triangles->getNumVertices() << " vertices but there are " << labels->size() << " labels." << LogEnd;
+                return;
+            }
+
+            std::sort( selection.begin(), selection.end() );
+            std::vector< uint8_t > selected( labels->size() );
+            di::core::parallelFor( 0, labels->size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t vertexID = from; vertexID < to; ++vertexID )
+                    {
+                        auto label = static_cast< int >( ( *labels )[ vertexID ] );
+                        selected[ vertexID ] = std::binary_search( selection.begin(), selection.end(), label );
+                    }
+                }
+            );
+
+            const auto& indices = triangles->getTriangles();
+            bool includeBorder = m_includeBorder->get();
+            std::vector< uint8_t > keep( indices.size() );
+            di::core::parallelFor( 0, indices.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t triID = from; triID < to; ++triID )
+                    {
+                        const auto& triangle = indices[ triID ];
+                        int count = selected[ triangle.x ] + selected[ triangle.y ] + selected[ triangle.z ];
+                        keep[ triID ] = includeBorder ? ( count > 0 ) : ( count == 3 );
+                    }
+                }
+            );
+
+            auto submesh = di::core::extractSubmesh( *triangles, keep );
+            LogD << "Kept " << submesh.m_triangles.size() << " of " << indices.size() << " triangles and " << submesh.m_vertices.size() << " of "
+                 << triangles->getNumVertices() << " vertices." << LogEnd;
+
+            auto subColors = std::make_shared< di::RGBAArray >( submesh.m_vertices.size(), glm::vec4( 1.0f ) );
+            if( colors && ( colors->size() == triangles->getNumVertices() ) )
+            {
+                subColors = di::core::remapAttribute( *colors, submesh.m_vertices );
+            }
+            m_dataOutput->setData( std::make_shared< di::core::TriangleDataSet >( triangleDataSet->getName(), submesh.m_mesh, subColors ) );
+            m_dataLabelOutput->setData( std::make_shared< di::io::RegionLabelReader::DataSetType >( triangleLabelDataSet->getName(),
+                                        di::core::remapAttribute( *labels, submesh.m_vertices ) ) );
+        }
+    }
+}
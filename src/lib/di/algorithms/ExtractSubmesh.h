@@ -0,0 +1,93 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_EXTRACTSUBMESH_H
+#define DI_EXTRACTSUBMESH_H
+
+#include <di/core/Algorithm.h>
+#include <di/core/ParameterTypes.h>
+#include <di/core/data/TriangleDataSet.h>
+#include <di/io/RegionLabelReader.h>
+
+namespace di
+{
+    namespace algorithms
+    {
+        /**
+         * Extract the part of a mesh covered by a set of labels. Algorithms downstream only process and render this region of interest.
+         */
+        class ExtractSubmesh: public di::core::Algorithm
+        {
+        public:
+            /**
+             * Constructor. Initialize all inputs, outputs and parameters.
+             */
+            ExtractSubmesh();
+
+            /**
+             * Destructor. Clean up if needed.
+             */
+            virtual ~ExtractSubmesh();
+
+            /**
+             * Extract the triangles of the selected labels and compact the vertices.
+             */
+            virtual void process();
+
+        protected:
+        private:
+            /**
+             * The mesh.
+             */
+            SPtr< di::core::Connector< di::core::TriangleDataSet > > m_dataInput;
+
+            /**
+             * The labels of the mesh vertices.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_dataLabelInput;
+
+            /**
+             * The submesh.
+             */
+            SPtr< di::core::Connector< di::core::TriangleDataSet > > m_dataOutput;
+
+            /**
+             * The labels of the submesh vertices.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_dataLabelOutput;
+
+            /**
+             * The labels to keep. Empty to keep the whole mesh.
+             */
+            core::ParamIntList m_labels;
+
+            /**
+             * Keep triangles with at least one selected vertex instead of only those with three.
+             */
+            core::ParamBool m_includeBorder;
+        };
+    }
+}
+
+#endif  // DI_EXTRACTSUBMESH_H
@@ -0,0 +1,227 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <di/core/ParallelFor.h>
+#include <di/core/data/DataBuilder.h>
+
+#include "GenerateMesh.h"
+
+#include <di/core/Logger.h>
+#define LogTag "algorithms/GenerateMesh"
+
+namespace di
+{
+    namespace algorithms
+    {
+        namespace
+        {
+            /**
+             * Create a color for the given region. Neighbouring region indices get very different hues.
+             *
+             * \param region the region index
+             *
+             * \return the color.
+             */
+            glm::vec4 regionColor( size_t region )
+            {
+                // Golden ratio hue steps distribute the hues evenly, saturation and value are fixed.
+                float hue = 6.0f * std::fmod( 0.618034f * static_cast< float >( region ), 1.0f );
+                float x = 1.0f - std::abs( std::fmod( hue, 2.0f ) - 1.0f );
+                glm::vec3 rgb;
+                switch( static_cast< int >( hue ) )
+                {
+                    case 0:
+                        rgb = glm::vec3( 1.0f, x, 0.0f );
+                        break;
+                    case 1:
+                        rgb = glm::vec3( x, 1.0f, 0.0f );
+                        break;
+                    case 2:
+                        rgb = glm::vec3( 0.0f, 1.0f, x );
+                        break;
+                    case 3:
+                        rgb = glm::vec3( 0.0f, x, 1.0f );
+                        break;
+                    case 4:
+                        rgb = glm::vec3( x, 0.0f, 1.0f );
+                        break;
+                    default:
+                        rgb = glm::vec3( 1.0f, 0.0f, x );
+                        break;
+                }
+
+                return glm::vec4( glm::vec3( 0.3f ) + 0.6f * rgb, 1.0f );
+            }
+        }
+
+        /**
+         * Radius of the tube of the generated torus. The distance of the tube to the origin is 1.
+         */
+        const float TorusMinorRadius = 0.35f;
+
+        GenerateMesh::GenerateMesh():
+            Algorithm( "Generate Mesh",
+                       "Generate a sphere or torus with a synthetic parcellation and label ordering." )
+        {
+            // 1: the outputs
+            m_meshOutput = addOutput< di::core::TriangleDataSet >(
+                    "Triangle Mesh",
+                    "The generated mesh, colored by region."
+            );
+
+            m_labelOutput = addOutput< di::io::RegionLabelReader::DataSetType >(
+                    "Triangle Labels",
+                    "The region label of each vertex."
+            );
+
+            m_labelOrderingOutput = addOutput< di::io::RegionLabelReader::DataSetType >(
+                    "Label Ordering",
+                    "The ordering of the region labels."
+            );
+
+            // 2: the parameters
+            m_torus = addParameter< bool >(
+                    "Torus",
+                    "If enabled, a torus is generated. A sphere otherwise.",
+                    false
+            );
+
+            m_vertices = addParameter< int >(
+                    "Vertices",
+                    "The approximate number of vertices to generate.",
+                    100000
+            );
+            m_vertices->setRangeHint( 12, 10000000 );
+
+            m_regions = addParameter< int >(
+                    "Regions",
+                    "The number of regions to split the mesh into.",
+                    24
+            );
+            m_regions->setRangeHint( 1, 1000 );
+
+            m_orderedRegions = addParameter< int >(
+                    "Ordered Regions",
+                    "The number of region labels in the label ordering. Regions not in the ordering are ignored when extracting directions.",
+                    24
+            );
+            m_orderedRegions->setRangeHint( 0, 1000 );
+
+            m_shuffleOrdering = addParameter< bool >(
+                    "Shuffle Ordering",
+                    "If enabled, the label ordering is a random permutation of the labels. Otherwise, the labels are in ascending order.",
+                    true
+            );
+
+            m_seed = addParameter< int >(
+                    "Seed",
+                    "The seed for all random decisions. The same seed always creates the same data.",
+                    1
+            );
+            m_seed->setRangeHint( 0, 10000 );
+        }
+
+        GenerateMesh::~GenerateMesh()
+        {
+            // nothing to clean up so far
+        }
+
+        void GenerateMesh::process()
+        {
+            size_t numVertices = static_cast< size_t >( std::max( 12, m_vertices->get() ) );
+            size_t numRegions = static_cast< size_t >( std::max( 1, m_regions->get() ) );
+            size_t numOrdered = std::min( numRegions, static_cast< size_t >( std::max( 0, m_orderedRegions->get() ) ) );
+            unsigned int seed = static_cast< unsigned int >( m_seed->get() );
+
+            // 1: the mesh.
+            getProgress().begin( "Building mesh" );
+            SPtr< core::TriangleMesh > mesh;
+            if( m_torus->get() )
+            {
+                // Choose the segment counts to get roughly square quads.
+                size_t minorSegments = static_cast< size_t >( std::round( std::sqrt( numVertices * TorusMinorRadius ) ) );
+                minorSegments = std::max< size_t >( 3, minorSegments );
+                size_t majorSegments = std::max< size_t >( 3, numVertices / minorSegments );
+                mesh = core::buildTorus( majorSegments, minorSegments, 1.0f, TorusMinorRadius );
+            }
+            else
+            {
+                // 10 * f^2 + 2 vertices
+                size_t frequency = static_cast< size_t >( std::round( std::sqrt( ( numVertices - 2 ) / 10.0 ) ) );
+                mesh = core::buildIcosphere( std::max< size_t >( 1, frequency ) );
+            }
+            mesh->calculateInverseIndex();
+            getProgress().end();
+
+            // 2: the parcellation
+            getProgress().begin( "Assigning regions" );
+            auto regions = core::buildVoronoiLabels( *mesh, numRegions, seed );
+
+            // Labels start at 1. Use the region index for color.
+            auto labels = std::make_shared< di::io::RegionLabelReader::AttributeType >( regions.size() );
+            auto colors = std::make_shared< di::RGBAArray >( regions.size() );
+            core::parallelFor( 0, regions.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t vertexID = from; vertexID < to; ++vertexID )
+                    {
+                        ( *labels )[ vertexID ] = static_cast< double >( regions[ vertexID ] + 1 );
+                        ( *colors )[ vertexID ] = regionColor( regions[ vertexID ] );
+                    }
+                }
+            );
+            getProgress().end();
+
+            // 3: the label ordering. The engine output is used directly as the standard distributions are implementation-defined.
+            std::vector< size_t > order( numRegions );
+            for( size_t i = 0; i < numRegions; ++i )
+            {
+                order[ i ] = i + 1;
+            }
+
+            if( m_shuffleOrdering->get() )
+            {
+                std::mt19937 random( seed + 1 );
+                for( size_t i = numRegions; i > 1; --i )
+                {
+                    std::swap( order[ i - 1 ], order[ random() % i ] );
+                }
+            }
+
+            auto labelOrder = std::make_shared< di::io::RegionLabelReader::AttributeType >( order.begin(), order.begin() + numOrdered );
+
+            LogI << "Generated " << ( m_torus->get() ? "torus" : "sphere" ) << " with " << mesh->getNumVertices() << " vertices, "
+                 << mesh->getNumTriangles() << " triangles and " << numRegions << " regions (" << numOrdered << " ordered)." << LogEnd;
+
+            m_meshOutput->setData( std::make_shared< di::core::TriangleDataSet >( "Generated Mesh", mesh, colors ) );
+            m_labelOutput->setData( std::make_shared< di::io::RegionLabelReader::DataSetType >( "Generated Labels", labels ) );
+            m_labelOrderingOutput->setData( std::make_shared< di::io::RegionLabelReader::DataSetType >( "Generated Label Ordering", labelOrder ) );
+        }
+    }
+}
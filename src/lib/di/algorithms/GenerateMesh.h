@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_GENERATEMESH_H
+#define DI_GENERATEMESH_H
+
+#include <di/core/Algorithm.h>
+#include <di/core/ParameterTypes.h>
+#include <di/core/data/TriangleDataSet.h>
+#include <di/io/RegionLabelReader.h>
+
+namespace di
+{
+    namespace algorithms
+    {
+        /**
+         * Generate a sphere or torus of arbitrary resolution along with a synthetic parcellation. The parcellation consists of Voronoi patches
+         * around randomly chosen vertices and a label ordering. The outputs match the inputs of ExtractRegions. Useful to test and benchmark the
+         * pipeline without the need for huge files. The result only depends on the parameters, including the seed.
+         */
+        class GenerateMesh: public di::core::Algorithm
+        {
+        public:
+            /**
+             * Constructor. Initialize all inputs, outputs and parameters.
+             */
+            GenerateMesh();
+
+            /**
+             * Destructor. Clean up if needed.
+             */
+            virtual ~GenerateMesh();
+
+            /**
+             * Generate mesh, labels and label ordering.
+             */
+            virtual void process();
+        protected:
+        private:
+            /**
+             * The generated mesh.
+             */
+            SPtr< di::core::Connector< di::core::TriangleDataSet > > m_meshOutput;
+
+            /**
+             * The generated per-vertex labels.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_labelOutput;
+
+            /**
+             * The generated label ordering.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_labelOrderingOutput;
+
+            /**
+             * Generate a torus instead of a sphere.
+             */
+            core::ParamBool m_torus;
+
+            /**
+             * The approximate number of vertices.
+             */
+            core::ParamInt m_vertices;
+
+            /**
+             * The number of Voronoi patches.
+             */
+            core::ParamInt m_regions;
+
+            /**
+             * The number of labels in the label ordering.
+             */
+            core::ParamInt m_orderedRegions;
+
+            /**
+             * Randomly permute the label ordering.
+             */
+            core::ParamBool m_shuffleOrdering;
+
+            /**
+             * The seed for all random choices.
+             */
+            core::ParamInt m_seed;
+        };
+    }
+}
+
+#endif  // DI_GENERATEMESH_H
+
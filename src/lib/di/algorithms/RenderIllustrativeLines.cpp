@@ -22,16 +22,21 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <functional>
 #include <string>
 #include <vector>
 #include <random>
 
 #include <di/core/data/TriangleDataSet.h>
 #include <di/core/data/Points.h>
-#include <di/core/Filesystem.h>
 
+#include <di/gfx/BufferCache.h>
 #include <di/gfx/GL.h>
 #include <di/gfx/GLError.h>
+#include <di/gfx/ShaderSources.h>
 
 #include "RenderIllustrativeLines.h"
 
@@ -45,7 +50,8 @@ namespace di
         RenderIllustrativeLines::RenderIllustrativeLines():
             Algorithm( "Render Illustrative Lines",
                        "This algorithm takes a bunch of lines and renders it to screen." ),
-            Visualization()
+            Visualization(),
+            m_gpuTimer( "RenderIllustrativeLines" )
         {
             // We require some inputs.
 
@@ -221,13 +227,17 @@ namespace di
             bool changeVis = ( m_visTriangleData != data ) ||
                              ( m_visTriangleLabelData != labels ) ||
                              ( m_visTriangleVectorData != vectors );
+            bool changeLabels = ( m_visTriangleLabelData != labels ) || !m_visTriangleLabelDataUInt32;
             m_visTriangleData = data;
             m_visTriangleVectorData = vectors;
             m_visTriangleLabelData = labels;
 
-            // Convert labels to ints
-            m_visTriangleLabelDataUInt32 = std::make_shared< std::vector< uint32_t > >( m_visTriangleLabelData->getAttributes()->begin(),
-                                                                                        m_visTriangleLabelData->getAttributes()->end() );
+            // Convert labels to ints. Only if they changed. Each new conversion is uploaded again.
+            if( changeLabels )
+            {
+                m_visTriangleLabelDataUInt32 = std::make_shared< std::vector< uint32_t > >( m_visTriangleLabelData->getAttributes()->begin(),
+                                                                                            m_visTriangleLabelData->getAttributes()->end() );
+            }
 
             // Update normalization length:
             if( vectors )
@@ -248,6 +258,29 @@ namespace di
             }
         }
 
+        void RenderIllustrativeLines::updateAttributes()
+        {
+            // process() replaces these concurrently.
+            auto vectors = m_visTriangleVectorData;
+            auto labels = m_visTriangleLabelDataUInt32;
+
+            glBindVertexArray( m_VAO );
+            if( vectors != m_uploadedVectorData )
+            {
+                m_vectorsBuffer->data( vectors->getAttributes() );
+                glVertexAttribPointer( m_transformShaderProgram->getAttribLocation( "vectors" ), 3, GL_FLOAT, 0, 0, 0 );
+                m_uploadedVectorData = vectors;
+            }
+            if( labels != m_uploadedLabelData )
+            {
+                m_labelsBuffer->data( *labels );
+                glVertexAttribIPointer( m_transformShaderProgram->getAttribLocation( "label" ), 1, GL_UNSIGNED_INT, 0, 0 );
+                m_uploadedLabelData = labels;
+            }
+            glBindVertexArray( 0 );
+            logGLError();
+        }
+
         core::BoundingBox RenderIllustrativeLines::getBoundingBox() const
         {
             if( m_visTriangleData )
@@ -262,16 +295,21 @@ namespace di
 
         void RenderIllustrativeLines::prepare()
         {
+            // Shaders, noise and framebuffers are built once. Only a forced reload in update() builds them again.
+            if( m_transformShaderProgram )
+            {
+                return;
+            }
             LogD << "Vis Prepare" << LogEnd;
 
-            std::string localShaderPath = core::getResourcePath() + "/algorithms/shaders/";
+            std::string localShaderPath = "algorithms/shaders/";
 
             // Transformation Stage
             auto transformVertex = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                                     core::readTextFile(
+                                                                     core::ShaderSources::get(
                                                                          localShaderPath + "RenderIllustrativeLines-Transform-vertex.glsl" ) );
             auto transformFragment = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                       core::readTextFile(
+                                                                       core::ShaderSources::get(
                                                                            localShaderPath + "RenderIllustrativeLines-Transform-fragment.glsl" ) );
 
             // Link them to build the program itself
@@ -280,19 +318,19 @@ namespace di
                             transformVertex,
                             transformFragment,
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "Shading.glsl" ) )
+                                                              core::ShaderSources::get( localShaderPath + "Shading.glsl" ) )
                         }
             ) );
             m_transformShaderProgram->realize();
 
             auto arrowVertex = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                                 core::readTextFile(
+                                                                 core::ShaderSources::get(
                                                                      localShaderPath + "RenderIllustrativeLines-Arrows-vertex.glsl" ) );
             auto arrowsFragment = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                    core::readTextFile(
+                                                                    core::ShaderSources::get(
                                                                         localShaderPath + "RenderIllustrativeLines-Arrows-fragment.glsl" ) );
             auto arrowGeometry = std::make_shared< core::Shader >( core::Shader::ShaderType::Geometry,
-                                                                   core::readTextFile(
+                                                                   core::ShaderSources::get(
                                                                        localShaderPath + "RenderIllustrativeLines-Arrows-geometry.glsl" ) );
 
             // Link them to build the program itself
@@ -302,15 +340,15 @@ namespace di
                             arrowsFragment,
                             arrowGeometry,
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "Shading.glsl" ) )                        }
+                                                              core::ShaderSources::get( localShaderPath + "Shading.glsl" ) )                        }
             ) );
             m_arrowShaderProgram->realize();
 
             auto composeVertex = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                                   core::readTextFile(
+                                                                   core::ShaderSources::get(
                                                                        localShaderPath + "RenderIllustrativeLines-Compose-vertex.glsl" ) );
             auto composeFragment = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                     core::readTextFile(
+                                                                     core::ShaderSources::get(
                                                                         localShaderPath + "RenderIllustrativeLines-Compose-fragment.glsl" ) );
 
             // Link them to build the program itself
@@ -319,18 +357,18 @@ namespace di
                             composeVertex,
                             composeFragment,
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "Shading.glsl" ) ),
+                                                              core::ShaderSources::get( localShaderPath + "Shading.glsl" ) ),
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "LineAO.glsl" ) )
+                                                              core::ShaderSources::get( localShaderPath + "LineAO.glsl" ) )
                         }
             ) );
             m_composeShaderProgram->realize();
 
             auto finalVertex = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                                   core::readTextFile(
+                                                                   core::ShaderSources::get(
                                                                        localShaderPath + "RenderIllustrativeLines-Final-vertex.glsl" ) );
             auto finalFragment = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                     core::readTextFile(
+                                                                     core::ShaderSources::get(
                                                                         localShaderPath + "RenderIllustrativeLines-Final-fragment.glsl" ) );
 
             // Link them to build the program itself
@@ -342,11 +380,253 @@ namespace di
             ) );
             m_finalShaderProgram->realize();
 
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create the VAO of the arrow positions. They are filled during rendering.
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+            LogD << "Creating Point VAO" << LogEnd;
+
+            m_arrowShaderProgram->bind();
+            logGLError();
+
+            // get the location of attribute "position" in program
+            GLint vertexPointLoc = m_arrowShaderProgram->getAttribLocation( "position" );
+            logGLError();
+
+            // Create the VAO
+            glGenVertexArrays( 1, &m_pointVAO );
+            glBindVertexArray( m_pointVAO );
+            logGLError();
+
+            // The arrow positions. Not shared, as they are generated while rendering.
+            m_pointBuffer = std::make_shared< core::Buffer >();
+            logGLError();
+
+            // Set the location mapping of the shader using the VAO
+            m_pointBuffer->realize();
+            m_pointBuffer->bind();
+
+            // NOTE: filled during rendering
+
+            glEnableVertexAttribArray( vertexPointLoc );
+            glVertexAttribPointer( vertexPointLoc, 3, GL_FLOAT, 0, 0, 0 );
+            glBindVertexArray( 0 );
+            logGLError();
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create the Framebuffer Objects (FBO). Their textures get their size in resizeFramebuffers().
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 1: Render and transform to image space
+            LogD << "Creating Transform Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, & m_fboTransform );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboTransform );
+            logGLError();
+
+            m_step1ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1ColorTex->realize();
+            m_step1VecTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1VecTex->realize();
+            m_step1NormalTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1NormalTex->realize();
+            m_step1PosTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1PosTex->realize();
+            m_step1DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1DepthTex->realize();
+            m_step1DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step1ColorTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step1VecTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_step1NormalTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, m_step1PosTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step1DepthTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_transformShaderProgram->bindFragDataLocation( 0, "fragColor" );
+            logGLError();
+            m_transformShaderProgram->bindFragDataLocation( 1, "fragVec" );
+            logGLError();
+            m_transformShaderProgram->bindFragDataLocation( 2, "fragNormal" );
+            logGLError();
+            m_transformShaderProgram->bindFragDataLocation( 3, "fragPos" );
+            logGLError();
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 2: Render and transform to image space
+            LogD << "Creating Arrow Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, &m_fboArrow );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboArrow );
+            logGLError();
+
+            m_step2ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step2ColorTex->realize();
+            m_step2DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step2DepthTex->realize();
+            m_step2DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step2ColorTex->getObjectID() , 0 );
+            logGLError();
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step2DepthTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_arrowShaderProgram->bindFragDataLocation( 0, "fragColor" );
+            logGLError();
+
+            // We need 2D noise.
+            m_whiteNoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_whiteNoiseTex->realize();
+            m_whiteNoiseTex->bind();
+            logGLError();
+
+            const size_t noiseWidth = 128;
+
+            // create some noise. Each random number provides four bytes.
+            std::mt19937 generator( time( 0 ) );
+            std::vector< uint32_t > randData( noiseWidth * noiseWidth * 3 / 4 );
+            std::generate( randData.begin(), randData.end(), std::ref( generator ) );
+
+            // Commit data
+            m_whiteNoiseTex->data( randData.data(), noiseWidth, noiseWidth, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
+
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 3 - Compose
+            LogD << "Creating flat VAO" << LogEnd;
+
+            // Create the full-screen quad.
+            float points[] = {
+             -1.0f,  1.0f,  0.0f,
+              1.0f,  1.0f,  0.0f,
+              1.0f, -1.0f,  0.0f,
+
+              1.0f, -1.0f,  0.0f,
+             -1.0f, -1.0f,  0.0f,
+             -1.0f,  1.0f,  0.0f
+            };
+
+            // Create Vertex Array Object
+            glGenVertexArrays( 1, &m_screenQuadVAO );
+            glBindVertexArray( m_screenQuadVAO );
+            logGLError();
+
+            m_screenQuadVertexBuffer = std::make_shared< core::Buffer >();
+            m_screenQuadVertexBuffer->realize();
+            m_screenQuadVertexBuffer->bind();
+            m_screenQuadVertexBuffer->data( 9 * 2 * sizeof( float ), points );
+            logGLError();
+
+            glEnableVertexAttribArray( 0 );
+            glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, nullptr );
+            glBindVertexArray( 0 );
+            logGLError();
+
+            LogD << "Creating Compose Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, &m_fboCompose );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboCompose );
+            logGLError();
+
+            m_step3ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step3ColorTex->realize();
+            m_step3AOTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step3AOTex->realize();
+            m_step3DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step3DepthTex->realize();
+            m_step3DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step3ColorTex->getObjectID() , 0 );
+            logGLError();
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step3AOTex->getObjectID() , 0 );
+            logGLError();
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step3DepthTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_composeShaderProgram->bindFragDataLocation( 0, "fragColor" );
+            m_composeShaderProgram->bindFragDataLocation( 1, "fragAO" );
+            logGLError();
+
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 4 - Compose
+
+            m_finalShaderProgram->bind();
+            m_finalShaderProgram->setPersistentUniform( "u_colorSampler",  0 );
+            m_finalShaderProgram->setPersistentUniform( "u_depthSampler", 1 );
+            m_finalShaderProgram->setPersistentUniform( "u_aoSampler",  2 );
+            logGLError();
         }
 
         void RenderIllustrativeLines::finalize()
         {
             LogD << "Vis Finalize" << LogEnd;
+            m_gpuTimer.finalize();
+
+            // Vertex arrays and framebuffers are not shared between contexts and have no wrapper. Everything else deletes itself when released.
+            glDeleteVertexArrays( 1, &m_VAO );
+            glDeleteVertexArrays( 1, &m_pointVAO );
+            glDeleteVertexArrays( 1, &m_screenQuadVAO );
+            glDeleteFramebuffers( 1, &m_fboTransform );
+            glDeleteFramebuffers( 1, &m_fboArrow );
+            glDeleteFramebuffers( 1, &m_fboCompose );
+            m_VAO = 0;
+            m_pointVAO = 0;
+            m_screenQuadVAO = 0;
+            m_fboTransform = 0;
+            m_fboArrow = 0;
+            m_fboCompose = 0;
+            logGLError();
+
+            m_transformShaderProgram = nullptr;
+            m_arrowShaderProgram = nullptr;
+            m_composeShaderProgram = nullptr;
+            m_finalShaderProgram = nullptr;
+
+            m_vertexBuffer = nullptr;
+            m_pointBuffer = nullptr;
+            m_colorBuffer = nullptr;
+            m_normalBuffer = nullptr;
+            m_vectorsBuffer = nullptr;
+            m_labelsBuffer = nullptr;
+            m_indexBuffer = nullptr;
+            m_screenQuadVertexBuffer = nullptr;
+            m_uploadedTriangleData = nullptr;
+            m_uploadedVectorData = nullptr;
+            m_uploadedLabelData = nullptr;
+            m_points = nullptr;
+
+            m_whiteNoiseTex = nullptr;
+            m_step1ColorTex = nullptr;
+            m_step1VecTex = nullptr;
+            m_step1NormalTex = nullptr;
+            m_step1PosTex = nullptr;
+            m_step1DepthTex = nullptr;
+            m_step2ColorTex = nullptr;
+            m_step2DepthTex = nullptr;
+            m_step3ColorTex = nullptr;
+            m_step3AOTex = nullptr;
+            m_step3DepthTex = nullptr;
+            m_fboResolution = glm::ivec2( 0 );
         }
 
         void RenderIllustrativeLines::render( const core::View& view )
@@ -356,24 +636,26 @@ namespace di
                 return;
             }
 
+            m_gpuTimer.beginFrame();
+
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Step 1 - Draw Color and Noise on geometry to textures:
 
+            m_gpuTimer.beginPass( "transform" );
+
             // Bind it to be able to modify and configure:
             glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboTransform );
 
             glDisable( GL_BLEND );
             m_transformShaderProgram->setDefine( "d_enableInterpolation", m_interpolateOnSurface->get() );
             m_transformShaderProgram->bind();
-            m_transformShaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            m_transformShaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
-            m_transformShaderProgram->setUniform( "u_specularity",      m_specularity->get() );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_specularity, m_specularity->get() );
 
-            m_transformShaderProgram->setUniform( "u_maskLabel",        m_maskLabel->get(), 20, -1 );
-            m_transformShaderProgram->setUniform( "u_maskLabelEnable",  m_maskLabelEnable->get() );
-            m_transformShaderProgram->setUniform( "u_desaturationIntensity", m_desaturationIntensity->get() );
-            m_transformShaderProgram->setUniform( "u_maxVectorLength", m_visTriangleVectorMax );
-            m_transformShaderProgram->setUniform( "u_emphasizeSingularPointsEnable",  m_emphasizeSingularPointsEnable->get() );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_maskLabel, m_maskLabel->get(), 20, -1 );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_maskLabelEnable, m_maskLabelEnable->get() );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_desaturationIntensity, m_desaturationIntensity->get() );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_maxVectorLength, m_visTriangleVectorMax );
+            m_transformShaderProgram->setUniform( m_transformUniforms.m_emphasizeSingularPointsEnable, m_emphasizeSingularPointsEnable->get() );
 
             logGLError();
 
@@ -424,8 +706,8 @@ namespace di
                                            );
                     }
                 }
-                m_vertexBuffer->bind();
-                m_vertexBuffer->data( m_points->getVertices() );
+                m_pointBuffer->bind();
+                m_pointBuffer->data( m_points->getVertices() );
                 logGLError();
             }
 
@@ -435,6 +717,8 @@ namespace di
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Step 2 - Draw Arrows:
 
+            m_gpuTimer.beginPass( "arrows" );
+
             // Bind it to be able to modify and configure:
             glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboArrow );
 
@@ -444,22 +728,19 @@ namespace di
             m_arrowShaderProgram->setDefine( "d_curvatureNumVerts", 2 * m_curvatureArrowsSampleDensity->get() );
 
             m_arrowShaderProgram->bind();
-            m_arrowShaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            // m_arrowShaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
-            // m_arrowShaderProgram->setUniform( "u_viewportSize", view.getViewportSize() );
-            m_arrowShaderProgram->setUniform( "u_viewportScale", ( view.getViewportSize() - glm::vec2( 1.0 ) ) / glm::vec2( m_fboResolution.x,
-                                                                                                                            m_fboResolution.y ) );
-            m_arrowShaderProgram->setUniform( "u_width", m_widthArrows->get() );
-            m_arrowShaderProgram->setUniform( "u_widthTails", m_widthArrowTails->get() );
-            m_arrowShaderProgram->setUniform( "u_height", m_lengthArrows->get() );
-            m_arrowShaderProgram->setUniform( "u_dist", m_distArrows->get() );
-            m_arrowShaderProgram->setUniform( "u_arrowColor", m_colorArrows->get() );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_viewportScale, ( view.getViewportSize() - glm::vec2( 1.0 ) ) /
+                                                                               glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_width, m_widthArrows->get() );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_widthTails, m_widthArrowTails->get() );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_height, m_lengthArrows->get() );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_dist, m_distArrows->get() );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_arrowColor, m_colorArrows->get() );
 
             // Allow the next shader to access step 1 textures
-            m_arrowShaderProgram->setUniform( "u_colorSampler",  0 );
-            m_arrowShaderProgram->setUniform( "u_vecSampler",    1 );
-            m_arrowShaderProgram->setUniform( "u_normalSampler", 2 );
-            m_arrowShaderProgram->setUniform( "u_posSampler",    3 );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_colorSampler,  0 );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_vecSampler,    1 );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_normalSampler, 2 );
+            m_arrowShaderProgram->setUniform( m_arrowUniforms.m_posSampler,    3 );
 
             logGLError();
 
@@ -494,18 +775,24 @@ namespace di
             // Step 3 - Merge everything and output to the normal framebuffer:
             // Set the view to be the target.
 
+            m_gpuTimer.beginPass( "compose" );
+
             // Bind it to be able to modify and configure:
             glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboCompose );
             logGLError();
 
-            // draw a big quad and compose
+            // draw a big quad and compose. Changing the sample count relinks, so the samplers are set here.
             m_composeShaderProgram->bind();
-            // m_composeShaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            m_composeShaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
-            // m_composeShaderProgram->setUniform( "u_viewportSize", view.getViewportSize() );
-            m_composeShaderProgram->setUniform( "u_viewportScale", view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
-            m_composeShaderProgram->setUniform( "u_bbSize", getBoundingBox().getSize() );
-            m_composeShaderProgram->setUniform( "u_enableSSAO", m_enableSSAO->get() );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_meshColorSampler,  0 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_arrowColorSampler, 1 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_meshDepthSampler,  2 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_arrowDepthSampler, 3 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_meshNormalSampler, 4 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_noiseSampler,      5 );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_viewportScale, view.getViewportSize() / glm::vec2( m_fboResolution.x,
+                                                                                                                       m_fboResolution.y ) );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_bbSize, getBoundingBox().getSize() );
+            m_composeShaderProgram->setUniform( m_composeUniforms.m_enableSSAO, m_enableSSAO->get() );
 
             // Textures
             glActiveTexture( GL_TEXTURE0 );
@@ -545,12 +832,15 @@ namespace di
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Step 4 -
 
+            m_gpuTimer.beginPass( "final" );
+
             view.bind();
             glEnable( GL_BLEND );
 
             // draw a big quad and compose
             m_finalShaderProgram->bind();
-            m_finalShaderProgram->setUniform( "u_viewportScale", view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
+            m_finalShaderProgram->setUniform( m_finalUniforms.m_viewportScale, view.getViewportSize() / glm::vec2( m_fboResolution.x,
+                                                                                                                   m_fboResolution.y ) );
             logGLError();
 
             // Textures
@@ -573,11 +863,23 @@ namespace di
             glBindVertexArray( m_screenQuadVAO );
             glDrawArrays( GL_TRIANGLES, 0, 6 ); // 3 indices starting at 0 -> 1 triangle
             logGLError();
+
+            m_gpuTimer.endFrame();
         }
 
         void RenderIllustrativeLines::update( const core::View& view, bool reload )
         {
-            // Force update if resolution mismatch
+            // A forced reload, like after editing the shaders, builds everything again.
+            if( reload )
+            {
+                finalize();
+            }
+            prepare();
+
+            // Only relinks if the quality mode changed.
+            m_composeShaderProgram->setDefine( "d_samples", view.isHQMode() ? 64 : 16 );
+
+            // A resize only needs new framebuffer textures.
             auto resolution = di::core::Texture::powerOfTwoResolution( view.getViewportSize() );
             if( m_fboResolution != resolution )
             {
@@ -586,8 +888,8 @@ namespace di
                         ", Current FBO: " << m_fboResolution.x << "x" << m_fboResolution.y <<
                         ", New FBO: " << resolution.x << "x" << resolution.y << LogEnd;
 
-                reload = true;
                 m_fboResolution = resolution;
+                resizeFramebuffers();
             }
 
             if( !m_visTriangleData || !m_visTriangleVectorData || !m_visTriangleLabelData )
@@ -595,29 +897,65 @@ namespace di
                 return;
             }
 
-            if( !isRenderingRequested() && !reload )
+            if( !isRenderingRequested() && m_VAO )
             {
                 return;
             }
             LogD << "Vis Update" << LogEnd;
             resetRenderingRequest();
 
-            prepare();
-
-            // house-keeping
-            if( m_fboTransform )
-            {
-                glDeleteFramebuffers( 1, &m_fboTransform );
-            }
-            if( m_fboArrow )
+            // Frames of a time series only change vectors and labels. Keep everything else.
+            if( m_VAO && ( m_uploadedTriangleData == m_visTriangleData ) )
             {
-                glDeleteFramebuffers( 1, &m_fboArrow );
+                updateAttributes();
+                return;
             }
-            if( m_fboCompose )
+
+            uploadMesh();
+        }
+
+        void RenderIllustrativeLines::resizeFramebuffers()
+        {
+            LogD << "Resizing FBO textures" << LogEnd;
+
+            // NOTE: to use an FBO, the texture needs to be initalized empty.
+            m_step1ColorTex->bind();
+            m_step1ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
+            m_step1VecTex->bind();
+            m_step1VecTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
+            m_step1NormalTex->bind();
+            m_step1NormalTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
+            m_step1PosTex->bind();
+            m_step1PosTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
+            m_step1DepthTex->bind();
+            m_step1DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
+            m_step2ColorTex->bind();
+            m_step2ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
+            m_step2DepthTex->bind();
+            m_step2DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
+            m_step3ColorTex->bind();
+            m_step3ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
+            m_step3AOTex->bind();
+            m_step3AOTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
+            m_step3DepthTex->bind();
+            m_step3DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
+            logGLError();
+
+            GLuint fbos[ 3 ] = { m_fboTransform, m_fboArrow, m_fboCompose };
+            for( size_t step = 0; step < 3; ++step )
             {
-                glDeleteFramebuffers( 1, &m_fboCompose );
+                glBindFramebuffer( GL_DRAW_FRAMEBUFFER, fbos[ step ] );
+                if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
+                {
+                    LogE << "glCheckFramebufferStatus failed for Step " << ( step + 1 ) << "." << LogEnd;
+                }
             }
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+            logGLError();
+        }
 
+        void RenderIllustrativeLines::uploadMesh()
+        {
             /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Create Vertex Array Object VAO and the corresponding Vertex Buffer Objects VBO for the mesh itself
             /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -636,354 +974,61 @@ namespace di
 
             logGLError();
 
-            // Create the VAO
-            glGenVertexArrays( 1, &m_VAO );
+            // Create the VAO once. A new mesh only replaces the buffers bound to it.
+            if( !m_VAO )
+            {
+                glGenVertexArrays( 1, &m_VAO );
+            }
             glBindVertexArray( m_VAO );
             logGLError();
 
-            // Create some buffers
-            m_vertexBuffer = std::make_shared< core::Buffer >();
-            m_normalBuffer = std::make_shared< core::Buffer >();
-            m_colorBuffer = std::make_shared< core::Buffer >();
-            m_vectorsBuffer = std::make_shared< core::Buffer >();
-            m_labelsBuffer = std::make_shared< core::Buffer >();
-            m_indexBuffer = std::make_shared< core::Buffer >( core::Buffer::BufferType::ElementArray );
+            // The buffers of the mesh are shared with other visualizations of the same mesh. Vectors and labels change per frame.
+            auto grid = m_visTriangleData->getGrid();
+            m_vertexBuffer = core::BufferCache::get( grid, grid->getVertices(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_normalBuffer = core::BufferCache::get( grid, grid->getNormals(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_colorBuffer = core::BufferCache::get( m_visTriangleData->getAttributes() );
+            if( !m_vectorsBuffer )
+            {
+                m_vectorsBuffer = std::make_shared< core::DoubleBuffer >();
+                m_labelsBuffer = std::make_shared< core::DoubleBuffer >();
+            }
+            m_indexBuffer = core::BufferCache::get( grid, grid->getTriangles(), core::Buffer::BufferType::ElementArray, grid->getVersion() );
             logGLError();
 
-            // Set the data using the triangle mesh. Also set the location mapping of the shader using the VAO
-            m_vertexBuffer->realize();
+            // Set the location mapping of the shader using the VAO
             m_vertexBuffer->bind();
-            m_vertexBuffer->data( m_visTriangleData->getGrid()->getVertices() );
             logGLError();
 
             glEnableVertexAttribArray( vertexLoc );
             glVertexAttribPointer( vertexLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_colorBuffer->realize();
             m_colorBuffer->bind();
-            m_colorBuffer->data( m_visTriangleData->getAttributes() );
             glEnableVertexAttribArray( colorLoc );
             glVertexAttribPointer( colorLoc, 4, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_normalBuffer->realize();
             m_normalBuffer->bind();
-            m_normalBuffer->data( m_visTriangleData->getGrid()->getNormals() );
             glEnableVertexAttribArray( normalLoc );
             glVertexAttribPointer( normalLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_vectorsBuffer->realize();
-            m_vectorsBuffer->bind();
-            m_vectorsBuffer->data( m_visTriangleVectorData->getAttributes() );
+            m_uploadedVectorData = m_visTriangleVectorData;
+            m_vectorsBuffer->data( m_uploadedVectorData->getAttributes() );
             glEnableVertexAttribArray( vectorsLoc );
             glVertexAttribPointer( vectorsLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_labelsBuffer->realize();
-            m_labelsBuffer->bind();
-            m_labelsBuffer->data( *m_visTriangleLabelDataUInt32 );
+            m_uploadedLabelData = m_visTriangleLabelDataUInt32;
+            m_labelsBuffer->data( *m_uploadedLabelData );
             glEnableVertexAttribArray( labelsLoc );
             glVertexAttribIPointer( labelsLoc, 1, GL_UNSIGNED_INT, 0, 0 );
             logGLError();
 
-            m_indexBuffer->realize();
             m_indexBuffer->bind();
-            m_indexBuffer->data( m_visTriangleData->getGrid()->getTriangles() );
-            logGLError();
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Create Vertex Array Object VAO and the corresponding Vertex Buffer Objects VBO for the mesh itself
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-            LogD << "Creating Point VAO" << LogEnd;
-
-            m_arrowShaderProgram->bind();
-            logGLError();
-
-            // get the location of attribute "position" in program
-            GLint vertexPointLoc = m_arrowShaderProgram->getAttribLocation( "position" );
-            logGLError();
-
-            // Create the VAO
-            glGenVertexArrays( 1, &m_pointVAO );
-            glBindVertexArray( m_pointVAO );
-            logGLError();
-
-            // Create some buffers
-            m_vertexBuffer = std::make_shared< core::Buffer >();
-            logGLError();
-
-            // Set the data using the triangle mesh. Also set the location mapping of the shader using the VAO
-            m_vertexBuffer->realize();
-            m_vertexBuffer->bind();
-
-            // NOTE: filled during rendering
-
-            glEnableVertexAttribArray( vertexLoc );
-            glVertexAttribPointer( vertexPointLoc, 3, GL_FLOAT, 0, 0, 0 );
-            logGLError();
-
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Create a Framebuffer Object (FBO) and setup LIC pipeline
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 1: Render and transform to image space
-            LogD << "Creating Transform Pass FBO" << LogEnd;
-
-            m_transformShaderProgram->bind();
-
-            // The framebuffer
-            glGenFramebuffers( 1, & m_fboTransform );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboTransform );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step1ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1ColorTex->realize();
-            m_step1ColorTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step1ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            m_step1VecTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1VecTex->realize();
-            m_step1VecTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1VecTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
-            logGLError();
-
-            m_step1NormalTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1NormalTex->realize();
-            m_step1NormalTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1NormalTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
-            logGLError();
-
-            m_step1PosTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1PosTex->realize();
-            m_step1PosTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1PosTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
-            logGLError();
-
-            m_step1DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1DepthTex->realize();
-            m_step1DepthTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
-            m_step1DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step1ColorTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step1VecTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_step1NormalTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, m_step1PosTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step1DepthTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_transformShaderProgram->getObjectID(), 0, "fragColor" );
-            logGLError();
-            glBindFragDataLocation( m_transformShaderProgram->getObjectID(), 1, "fragVec" );
-            logGLError();
-            glBindFragDataLocation( m_transformShaderProgram->getObjectID(), 2, "fragNormal" );
-            logGLError();
-            glBindFragDataLocation( m_transformShaderProgram->getObjectID(), 3, "fragPos" );
-            logGLError();
-
-            // Final Check
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 1." << LogEnd;
-            }
-
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 2: Render and transform to image space
-            LogD << "Creating Arrow Pass FBO" << LogEnd;
-
-            m_arrowShaderProgram->bind();
-
-            // The framebuffer
-            glGenFramebuffers( 1, &m_fboArrow );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboArrow );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step2ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step2ColorTex->realize();
-            m_step2ColorTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step2ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            m_step2DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step2DepthTex->realize();
-            m_step2DepthTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step2DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
-            m_step2DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step2ColorTex->getObjectID() , 0 );
-            logGLError();
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step2DepthTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_arrowShaderProgram->getObjectID(), 0, "fragColor" );
-            logGLError();
-
-            // Check for validity
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 2." << LogEnd;
-            }
-
-            // We need 3D noise.
-            m_whiteNoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_whiteNoiseTex->realize();
-            m_whiteNoiseTex->bind();
-            logGLError();
-
-            const size_t noiseWidth = 128;
-
-            // create some noise
-            std::srand( time( 0 ) );
-            std::vector< unsigned char > randData;
-            randData.reserve( noiseWidth * noiseWidth * 3 );
-            for( size_t i = 0; i < noiseWidth * noiseWidth * 3; ++i )
-            {
-                unsigned char r = static_cast< unsigned char >( std::rand() % 255 );  // NOLINT - no we want std::rand instead of rand_r
-                randData.push_back( r );
-            }
-
-            // Commit data
-            m_whiteNoiseTex->data( randData.data(), noiseWidth, noiseWidth, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
-
-            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 3 - Compose
-            LogD << "Creating flat VAO" << LogEnd;
-
-            // Create the full-screen quad.
-            float points[] = {
-             -1.0f,  1.0f,  0.0f,
-              1.0f,  1.0f,  0.0f,
-              1.0f, -1.0f,  0.0f,
-
-              1.0f, -1.0f,  0.0f,
-             -1.0f, -1.0f,  0.0f,
-             -1.0f,  1.0f,  0.0f
-            };
-
-            // Create Vertex Array Object
-            glGenVertexArrays( 1, &m_screenQuadVAO );
-            glBindVertexArray( m_screenQuadVAO );
-            logGLError();
-
-            m_screenQuadVertexBuffer = std::make_shared< core::Buffer >();
-            m_screenQuadVertexBuffer->realize();
-            m_screenQuadVertexBuffer->bind();
-            m_screenQuadVertexBuffer->data( 9 * 2 * sizeof( float ), points );
-            logGLError();
-
-            glEnableVertexAttribArray( 0 );
-            glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, nullptr );
-            logGLError();
-
-            // Do not forget to make the textures available to the final step
-            if( view.isHQMode() )
-            {
-                m_composeShaderProgram->setDefine( "d_samples", 64 );
-            }
-            else
-            {
-                m_composeShaderProgram->setDefine( "d_samples", 16 );
-            }
-            m_composeShaderProgram->bind();
-            m_composeShaderProgram->setUniform( "u_meshColorSampler",  0 );
-            m_composeShaderProgram->setUniform( "u_arrowColorSampler", 1 );
-            m_composeShaderProgram->setUniform( "u_meshDepthSampler",  2 );
-            m_composeShaderProgram->setUniform( "u_arrowDepthSampler", 3 );
-            m_composeShaderProgram->setUniform( "u_meshNormalSampler",  4 );
-            m_composeShaderProgram->setUniform( "u_noiseSampler",  5 );
-            logGLError();
-
-            LogD << "Creating Compose Pass FBO" << LogEnd;
-
-            // The framebuffer
-            glGenFramebuffers( 1, &m_fboCompose );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboCompose );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step3ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step3ColorTex->realize();
-            m_step3ColorTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step3ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step3AOTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step3AOTex->realize();
-            m_step3AOTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step3AOTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            m_step3DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step3DepthTex->realize();
-            m_step3DepthTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step3DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
-            m_step3DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step3ColorTex->getObjectID() , 0 );
-            logGLError();
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step3AOTex->getObjectID() , 0 );
-            logGLError();
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,  m_step3DepthTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_composeShaderProgram->getObjectID(), 0, "fragColor" );
-            glBindFragDataLocation( m_composeShaderProgram->getObjectID(), 1, "fragAO" );
-            logGLError();
-
-            // Check for validity
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 3." << LogEnd;
-            }
-
-            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 4 - Compose
-
-            m_finalShaderProgram->bind();
-            m_finalShaderProgram->setUniform( "u_colorSampler",  0 );
-            m_finalShaderProgram->setUniform( "u_depthSampler", 1 );
-            m_finalShaderProgram->setUniform( "u_aoSampler",  2 );
+            glBindVertexArray( 0 );
             logGLError();
+            m_uploadedTriangleData = m_visTriangleData;
         }
     }
 }
-
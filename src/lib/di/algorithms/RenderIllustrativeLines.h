@@ -25,7 +25,10 @@
 #ifndef DI_RENDERILLUSTRATIVELINES_H
 #define DI_RENDERILLUSTRATIVELINES_H
 
+#include <di/gfx/DoubleBuffer.h>
 #include <di/gfx/GL.h>
+#include <di/gfx/GPUTimer.h>
+#include <di/gfx/Uniform.h>
 
 #include <di/core/Algorithm.h>
 #include <di/core/ParameterTypes.h>
@@ -129,6 +132,21 @@ namespace di
             virtual void onParameterChange( SPtr< core::ParameterBase > parameter ) override;
 
         private:
+            /**
+             * Upload changed vectors and labels to the back buffers and use them. Requires the VAO to exist for the current mesh.
+             */
+            void updateAttributes();
+
+            /**
+             * Give the framebuffer textures the size \ref m_fboResolution. The framebuffers and their attachments stay.
+             */
+            void resizeFramebuffers();
+
+            /**
+             * Bind the buffers of the current mesh, vectors and labels to the VAO. Creates the VAO if needed.
+             */
+            void uploadMesh();
+
             /**
              * To mask all other labels
              */
@@ -290,25 +308,99 @@ namespace di
              */
             SPtr< di::core::Program > m_finalShaderProgram = nullptr;
 
+            /**
+             * The uniforms of the transform pass set each frame.
+             */
+            struct
+            {
+                core::Uniform m_specularity = "u_specularity";
+                core::Uniform m_maskLabel = "u_maskLabel";
+                core::Uniform m_maskLabelEnable = "u_maskLabelEnable";
+                core::Uniform m_desaturationIntensity = "u_desaturationIntensity";
+                core::Uniform m_maxVectorLength = "u_maxVectorLength";
+                core::Uniform m_emphasizeSingularPointsEnable = "u_emphasizeSingularPointsEnable";
+            } m_transformUniforms;
+
+            /**
+             * The uniforms of the arrow pass set each frame.
+             */
+            struct
+            {
+                core::Uniform m_viewportScale = "u_viewportScale";
+                core::Uniform m_width = "u_width";
+                core::Uniform m_widthTails = "u_widthTails";
+                core::Uniform m_height = "u_height";
+                core::Uniform m_dist = "u_dist";
+                core::Uniform m_arrowColor = "u_arrowColor";
+                core::Uniform m_colorSampler = "u_colorSampler";
+                core::Uniform m_vecSampler = "u_vecSampler";
+                core::Uniform m_normalSampler = "u_normalSampler";
+                core::Uniform m_posSampler = "u_posSampler";
+            } m_arrowUniforms;
+
+            /**
+             * The uniforms of the compose pass set each frame.
+             */
+            struct
+            {
+                core::Uniform m_meshColorSampler = "u_meshColorSampler";
+                core::Uniform m_arrowColorSampler = "u_arrowColorSampler";
+                core::Uniform m_meshDepthSampler = "u_meshDepthSampler";
+                core::Uniform m_arrowDepthSampler = "u_arrowDepthSampler";
+                core::Uniform m_meshNormalSampler = "u_meshNormalSampler";
+                core::Uniform m_noiseSampler = "u_noiseSampler";
+                core::Uniform m_viewportScale = "u_viewportScale";
+                core::Uniform m_bbSize = "u_bbSize";
+                core::Uniform m_enableSSAO = "u_enableSSAO";
+            } m_composeUniforms;
+
+            /**
+             * The uniforms of the final pass set each frame.
+             */
+            struct
+            {
+                core::Uniform m_viewportScale = "u_viewportScale";
+            } m_finalUniforms;
+
             /**
              * Vertex data.
              */
             SPtr< di::core::Buffer > m_vertexBuffer = nullptr;
 
+            /**
+             * The arrow positions.
+             */
+            SPtr< di::core::Buffer > m_pointBuffer = nullptr;
+
             /**
              * Color data.
              */
             SPtr< di::core::Buffer > m_colorBuffer = nullptr;
 
             /**
-             * Vector data
+             * Vector data. Double-buffered, as it changes with each frame of a time series.
+             */
+            SPtr< di::core::DoubleBuffer > m_vectorsBuffer = nullptr;
+
+            /**
+             * Label data. Double-buffered, as it changes with each frame of a time series.
              */
-            SPtr< di::core::Buffer > m_vectorsBuffer = nullptr;
+            SPtr< di::core::DoubleBuffer > m_labelsBuffer = nullptr;
 
             /**
-             * Label data
+             * The mesh in the buffers.
              */
-            SPtr< di::core::Buffer > m_labelsBuffer = nullptr;
+            ConstSPtr< di::core::TriangleDataSet > m_uploadedTriangleData = nullptr;
+
+            /**
+             * The vectors in the buffers.
+             */
+            ConstSPtr< di::core::TriangleVectorField > m_uploadedVectorData = nullptr;
+
+            /**
+             * The labels in the buffers.
+             */
+            SPtr< std::vector< uint32_t > > m_uploadedLabelData = nullptr;
 
             /**
              * Normal data.
@@ -396,9 +488,14 @@ namespace di
             SPtr< di::core::Texture > m_step3DepthTex = nullptr;
 
             /**
-             * Current FBO resolution.
+             * Current FBO resolution. Zero until the textures got a size.
+             */
+            glm::ivec2 m_fboResolution = glm::ivec2( 0 );
+
+            /**
+             * Measures the GPU time of the render passes.
              */
-            glm::ivec2 m_fboResolution = glm::ivec2( 2048, 2048 );
+            core::GPUTimer m_gpuTimer;
         };
     }
 }
@@ -26,10 +26,10 @@
 #include <vector>
 
 #include <di/core/data/LineDataSet.h>
-#include <di/core/Filesystem.h>
 
 #include <di/gfx/GL.h>
 #include <di/gfx/GLError.h>
+#include <di/gfx/ShaderSources.h>
 
 #include "RenderLines.h"
 
@@ -96,11 +96,11 @@ namespace di
             SPtr< di::core::Shader > vertexShader = nullptr;
             SPtr< di::core::Shader > fragmentShader = nullptr;
 
-            std::string localShaderPath = core::getResourcePath() + "/algorithms/shaders/";
+            std::string localShaderPath = "algorithms/shaders/";
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "RenderLines-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "RenderLines-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "RenderLines-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "RenderLines-fragment.glsl" ) );
 
             // Link them to build the program itself
             // m_shaderProgram = std::make_shared< di::core::Program >( { m_vertexShader, m_fragmentShader } );
@@ -119,7 +119,7 @@ namespace di
             LogD << "Vis Finalize" << LogEnd;
         }
 
-        void RenderLines::render( const core::View& view )
+        void RenderLines::render( const core::View& /* view */ )
         {
             if( !( m_VAO && m_shaderProgram && m_vertexBuffer ) )
             {
@@ -128,8 +128,6 @@ namespace di
             // LogD << "Vis Render" << LogEnd;
 
             m_shaderProgram->bind();
-            m_shaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            m_shaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
             logGLError();
 
             glEnable( GL_BLEND );
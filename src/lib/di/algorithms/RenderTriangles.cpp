@@ -26,10 +26,11 @@
 #include <vector>
 
 #include <di/core/data/TriangleDataSet.h>
-#include <di/core/Filesystem.h>
 
+#include <di/gfx/BufferCache.h>
 #include <di/gfx/GL.h>
 #include <di/gfx/GLError.h>
+#include <di/gfx/ShaderSources.h>
 
 #include "RenderTriangles.h"
 
@@ -94,11 +95,11 @@ namespace di
             SPtr< di::core::Shader > vertexShader = nullptr;
             SPtr< di::core::Shader > fragmentShader = nullptr;
 
-            std::string localShaderPath = core::getResourcePath() + "/algorithms/shaders/";
+            std::string localShaderPath = "algorithms/shaders/";
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "RenderTriangles-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "RenderTriangles-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "RenderTriangles-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "RenderTriangles-fragment.glsl" ) );
 
             // Link them to build the program itself
             // m_shaderProgram = std::make_shared< di::core::Program >( { m_vertexShader, m_fragmentShader } );
@@ -108,7 +109,7 @@ namespace di
                             vertexShader,
                             fragmentShader,
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "Shading.glsl" ) )
+                                                              core::ShaderSources::get( localShaderPath + "Shading.glsl" ) )
                         }
             ) );
             m_shaderProgram->realize();
@@ -119,7 +120,7 @@ namespace di
             LogD << "Vis Finalize" << LogEnd;
         }
 
-        void RenderTriangles::render( const core::View& view )
+        void RenderTriangles::render( const core::View& /* view */ )
         {
             if( !( m_VAO && m_shaderProgram && m_vertexBuffer ) )
             {
@@ -128,8 +129,6 @@ namespace di
             // LogD << "Vis Render" << LogEnd;
 
             m_shaderProgram->bind();
-            m_shaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            m_shaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
             logGLError();
 
             glEnable( GL_BLEND );
@@ -177,40 +176,33 @@ namespace di
             glBindVertexArray( m_VAO );
             logGLError();
 
-            // Create some buffers
-            m_vertexBuffer = std::make_shared< core::Buffer >();
-            m_normalBuffer = std::make_shared< core::Buffer >();
-            m_colorBuffer = std::make_shared< core::Buffer >();
-            m_indexBuffer = std::make_shared< core::Buffer >( core::Buffer::BufferType::ElementArray );
+            // Get the buffers of the mesh. Other visualizations of the same mesh share them.
+            auto grid = m_visTriangleData->getGrid();
+            m_vertexBuffer = core::BufferCache::get( grid, grid->getVertices(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_normalBuffer = core::BufferCache::get( grid, grid->getNormals(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_colorBuffer = core::BufferCache::get( m_visTriangleData->getAttributes() );
+            m_indexBuffer = core::BufferCache::get( grid, grid->getTriangles(), core::Buffer::BufferType::ElementArray, grid->getVersion() );
             logGLError();
 
-            // Set the data using the triangle mesh. Also set the location mapping of the shader using the VAO
-            m_vertexBuffer->realize();
+            // Set the location mapping of the shader using the VAO
             m_vertexBuffer->bind();
-            m_vertexBuffer->data( m_visTriangleData->getGrid()->getVertices() );
             logGLError();
 
             glEnableVertexAttribArray( vertexLoc );
             glVertexAttribPointer( vertexLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_colorBuffer->realize();
             m_colorBuffer->bind();
-            m_colorBuffer->data( m_visTriangleData->getAttributes() );
             glEnableVertexAttribArray( colorLoc );
             glVertexAttribPointer( colorLoc, 4, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_normalBuffer->realize();
             m_normalBuffer->bind();
-            m_normalBuffer->data( m_visTriangleData->getGrid()->getNormals() );
             glEnableVertexAttribArray( normalLoc );
             glVertexAttribPointer( normalLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_indexBuffer->realize();
             m_indexBuffer->bind();
-            m_indexBuffer->data( m_visTriangleData->getGrid()->getTriangles() );
             logGLError();
         }
     }
@@ -22,14 +22,20 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <random>
 #include <string>
 #include <vector>
 
 #include <di/core/data/TriangleDataSet.h>
-#include <di/core/Filesystem.h>
 
+#include <di/gfx/BufferCache.h>
 #include <di/gfx/GL.h>
 #include <di/gfx/GLError.h>
+#include <di/gfx/ShaderSources.h>
 
 #include "SurfaceLIC.h"
 
@@ -44,7 +50,8 @@ namespace di
             Algorithm( "Surface LIC",
                        "This algorithm takes a triangle mesh and scalar information defined on the mesh. "
                        "It creates a smearing pattern along the gradient information." ),
-            Visualization()
+            Visualization(),
+            m_gpuTimer( "SurfaceLIC" )
         {
             // We require some inputs.
 
@@ -101,6 +108,23 @@ namespace di
 
         }
 
+        void SurfaceLIC::updateAttributes()
+        {
+            // process() replaces it concurrently.
+            auto vectors = m_visTriangleVectorData;
+            if( vectors == m_uploadedVectorData )
+            {
+                return;
+            }
+
+            glBindVertexArray( m_VAO );
+            m_vectorsBuffer->data( vectors->getAttributes() );
+            glVertexAttribPointer( m_shaderProgram->getAttribLocation( "vectors" ), 3, GL_FLOAT, 0, 0, 0 );
+            m_uploadedVectorData = vectors;
+            glBindVertexArray( 0 );
+            logGLError();
+        }
+
         core::BoundingBox SurfaceLIC::getBoundingBox() const
         {
             if( m_visTriangleData )
@@ -115,16 +139,21 @@ namespace di
 
         void SurfaceLIC::prepare()
         {
+            // Shaders, noise and framebuffers are built once. Only a forced reload in update() builds them again.
+            if( m_shaderProgram )
+            {
+                return;
+            }
             LogD << "Vis Prepare" << LogEnd;
 
             SPtr< di::core::Shader > vertexShader = nullptr;
             SPtr< di::core::Shader > fragmentShader = nullptr;
 
-            std::string localShaderPath = core::getResourcePath() + "/algorithms/shaders/";
+            std::string localShaderPath = "algorithms/shaders/";
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "LICMeshTransform-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "LICMeshTransform-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "LICMeshTransform-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "LICMeshTransform-fragment.glsl" ) );
 
             // Link them to build the program itself
             // m_shaderProgram = std::make_shared< di::core::Program >( { m_vertexShader, m_fragmentShader } );
@@ -134,15 +163,15 @@ namespace di
                             vertexShader,
                             fragmentShader,
                             std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                              core::readTextFile( localShaderPath + "Shading.glsl" ) )
+                                                              core::ShaderSources::get( localShaderPath + "Shading.glsl" ) )
                         }
             ) );
             m_shaderProgram->realize();
 
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "LICEdge-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "LICEdge-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "LICEdge-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "LICEdge-fragment.glsl" ) );
 
             // Link them to build the program itself
             m_edgeProgram = SPtr< di::core::Program >( new di::core::Program(
@@ -154,9 +183,9 @@ namespace di
             m_edgeProgram->realize();
 
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "LICAdvect-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "LICAdvect-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "LICAdvect-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "LICAdvect-fragment.glsl" ) );
 
             // Link them to build the program itself
             m_advectProgram = SPtr< di::core::Program >( new di::core::Program(
@@ -168,9 +197,9 @@ namespace di
             m_advectProgram->realize();
 
             vertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "LICCompose-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "LICCompose-vertex.glsl" ) );
             fragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "LICCompose-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "LICCompose-fragment.glsl" ) );
 
             // Link them to build the program itself
             m_composeProgram = SPtr< di::core::Program >( new di::core::Program(
@@ -180,11 +209,217 @@ namespace di
                         }
             ) );
             m_composeProgram->realize();
-       }
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Texture input data
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+            // We need 3D noise.
+            m_whiteNoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex3D );
+            m_whiteNoiseTex->realize();
+            m_whiteNoiseTex->bind();
+            logGLError();
+
+            const size_t noiseWidth = 128;
+
+            // create some noise. Each random number provides four bytes.
+            std::mt19937 generator( time( 0 ) );
+            std::vector< uint32_t > randData( noiseWidth * noiseWidth * noiseWidth / 4 );
+            std::generate( randData.begin(), randData.end(), std::ref( generator ) );
+
+            // Commit data
+            m_whiteNoiseTex->data( randData.data(), noiseWidth, noiseWidth, noiseWidth, GL_R8, GL_RED, GL_UNSIGNED_BYTE );
+
+            // Bind to the shader
+            m_shaderProgram->bind();
+            m_shaderProgram->setPersistentUniform( "u_noiseSampler", 0 );
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create the Framebuffer Objects (FBO) of the LIC pipeline. Their textures get their size in resizeFramebuffers().
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 1: Render and transform to image space
+            LogD << "Creating Transform Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, & m_fboTransform );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboTransform );
+            logGLError();
+
+            // We need two target texture: color and noise
+            m_step1ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1ColorTex->realize();
+            m_step1VecTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1VecTex->realize();
+            m_step1NoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1NoiseTex->realize();
+            m_step1DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step1DepthTex->realize();
+            m_step1DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step1ColorTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step1VecTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_step1NoiseTex->getObjectID() , 0 );
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_step1DepthTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_shaderProgram->bindFragDataLocation( 0, "fragColor" );
+            m_shaderProgram->bindFragDataLocation( 1, "fragVec" );
+            m_shaderProgram->bindFragDataLocation( 2, "fragNoise" );
+            logGLError();
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 2: Edges in depth buffer
+            LogD << "Creating Edge Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, & m_fboEdge );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboEdge );
+            logGLError();
+
+            m_step2EdgeTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step2EdgeTex->realize();
+            m_step2EdgeTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step2EdgeTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_edgeProgram->bindFragDataLocation( 0, "fragEdge" );
+            logGLError();
+
+            // Samplers
+            m_edgeProgram->bind();
+            m_edgeProgram->setPersistentUniform( "u_depthSampler", 0 );
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 3: Advect
+            LogD << "Creating Advect Pass FBO" << LogEnd;
+
+            // The framebuffer
+            glGenFramebuffers( 1, & m_fboAdvect );
+
+            // Bind it to be able to modify and configure:
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboAdvect );
+            logGLError();
+
+            m_step3AdvectTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
+            m_step3AdvectTex->realize();
+            logGLError();
+
+            // Bind textures to FBO
+            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step3AdvectTex->getObjectID() , 0 );
+            logGLError();
+
+            // Define the out vars to bind to the attachments
+            m_advectProgram->bindFragDataLocation( 0, "fragAdvect" );
+            logGLError();
+
+            // Samplers
+            m_advectProgram->bind();
+            m_advectProgram->setPersistentUniform( "u_depthSampler", 0 );
+            m_advectProgram->setPersistentUniform( "u_noiseSampler", 1 );
+            m_advectProgram->setPersistentUniform( "u_vecSampler",   2 );
+            m_advectProgram->setPersistentUniform( "u_edgeSampler",   3 );
+
+            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Step 4: Compose
+            LogD << "Creating Compose Pass" << LogEnd;
+
+            // Unbind other FBO
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+
+            // Bind the result textures to the next step
+            m_composeProgram->bind();
+            m_composeProgram->setPersistentUniform( "u_colorSampler", 0 );
+            m_composeProgram->setPersistentUniform( "u_vecSampler", 1 );
+            m_composeProgram->setPersistentUniform( "u_depthSampler", 2 );
+            m_composeProgram->setPersistentUniform( "u_edgeSampler", 3 );
+            m_composeProgram->setPersistentUniform( "u_noiseSampler", 4 );
+            m_composeProgram->setPersistentUniform( "u_advectSampler", 5 );
+
+            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create an VAO containing the full-screen quad
+            LogD << "Creating flat VAO" << LogEnd;
+
+            // Create the full-screen quad.
+            float points[] = {
+             -1.0f,  1.0f,  0.0f,
+              1.0f,  1.0f,  0.0f,
+              1.0f, -1.0f,  0.0f,
+
+              1.0f, -1.0f,  0.0f,
+             -1.0f, -1.0f,  0.0f,
+             -1.0f,  1.0f,  0.0f
+            };
+
+            // Create Vertex Array Object
+            glGenVertexArrays( 1, &m_screenQuadVAO );
+            glBindVertexArray( m_screenQuadVAO );
+            logGLError();
+
+            m_screenQuadVertexBuffer = std::make_shared< core::Buffer >();
+            m_screenQuadVertexBuffer->realize();
+            m_screenQuadVertexBuffer->bind();
+            m_screenQuadVertexBuffer->data( 9 * 2 * sizeof( float ), points );
+            logGLError();
+
+            glEnableVertexAttribArray( 0 );
+            glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, nullptr );
+            glBindVertexArray( 0 );
+            logGLError();
+        }
 
         void SurfaceLIC::finalize()
         {
             LogD << "Vis Finalize" << LogEnd;
+            m_gpuTimer.finalize();
+
+            // Vertex arrays and framebuffers are not shared between contexts and have no wrapper. Everything else deletes itself when released.
+            glDeleteVertexArrays( 1, &m_VAO );
+            glDeleteVertexArrays( 1, &m_screenQuadVAO );
+            glDeleteFramebuffers( 1, &m_fboTransform );
+            glDeleteFramebuffers( 1, &m_fboEdge );
+            glDeleteFramebuffers( 1, &m_fboAdvect );
+            m_VAO = 0;
+            m_screenQuadVAO = 0;
+            m_fboTransform = 0;
+            m_fboEdge = 0;
+            m_fboAdvect = 0;
+            logGLError();
+
+            m_shaderProgram = nullptr;
+            m_edgeProgram = nullptr;
+            m_advectProgram = nullptr;
+            m_composeProgram = nullptr;
+
+            m_vertexBuffer = nullptr;
+            m_colorBuffer = nullptr;
+            m_normalBuffer = nullptr;
+            m_vectorsBuffer = nullptr;
+            m_indexBuffer = nullptr;
+            m_screenQuadVertexBuffer = nullptr;
+            m_uploadedTriangleData = nullptr;
+            m_uploadedVectorData = nullptr;
+
+            m_whiteNoiseTex = nullptr;
+            m_step1ColorTex = nullptr;
+            m_step1VecTex = nullptr;
+            m_step1NoiseTex = nullptr;
+            m_step1DepthTex = nullptr;
+            m_step2EdgeTex = nullptr;
+            m_step3AdvectTex = nullptr;
+            m_fboResolution = glm::ivec2( 0 );
         }
 
         void SurfaceLIC::render( const core::View& view )
@@ -195,9 +430,10 @@ namespace di
             }
             // LogD << "Vis Render" << LogEnd;
 
+            m_gpuTimer.beginFrame();
+            m_gpuTimer.beginPass( "transform" );
+
             m_shaderProgram->bind();
-            m_shaderProgram->setUniform( "u_ProjectionMatrix", view.getCamera().getProjectionMatrix() );
-            m_shaderProgram->setUniform( "u_ViewMatrix",       view.getCamera().getViewMatrix() );
             logGLError();
 
             glActiveTexture( GL_TEXTURE0 );
@@ -229,6 +465,8 @@ namespace di
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Step 2 - Edge detection on depth buffer
 
+            m_gpuTimer.beginPass( "edge" );
+
             // Bind it to be able to modify and configure:
             glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboEdge );
             logGLError();
@@ -241,7 +479,6 @@ namespace di
 
             // draw a big quad
             m_edgeProgram->bind();
-            m_edgeProgram->setUniform( "u_viewportSize", view.getViewportSize() );
             logGLError();
 
             glActiveTexture( GL_TEXTURE0 );
@@ -253,6 +490,8 @@ namespace di
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Step 3 - Advect along the vec field
 
+            m_gpuTimer.beginPass( "advect" );
+
             // Bind it to be able to modify and configure:
             glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboAdvect );
             logGLError();
@@ -265,8 +504,7 @@ namespace di
 
             // draw a big quad
             m_advectProgram->bind();
-            m_advectProgram->setUniform( "u_viewportSize", view.getViewportSize() );
-            m_advectProgram->setUniform( "u_viewportScale", view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
+            m_advectProgram->setUniform( m_advectViewportScale, view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
             logGLError();
 
             glActiveTexture( GL_TEXTURE0 );
@@ -282,12 +520,14 @@ namespace di
             ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Final Step - Merge everything and output to the normal framebuffer:
 
+            m_gpuTimer.beginPass( "compose" );
+
             // Set the view to be the target.
             view.bind();
 
             // draw a big quad
             m_composeProgram->bind();
-            m_composeProgram->setUniform( "u_viewportScale", view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
+            m_composeProgram->setUniform( m_composeViewportScale, view.getViewportSize() / glm::vec2( m_fboResolution.x, m_fboResolution.y ) );
             logGLError();
 
             glActiveTexture( GL_TEXTURE0 );
@@ -307,11 +547,20 @@ namespace di
             glBindVertexArray( m_screenQuadVAO );
             glDrawArrays( GL_TRIANGLES, 0, 6 ); // 3 indices starting at 0 -> 1 triangle
             logGLError();
+
+            m_gpuTimer.endFrame();
         }
 
         void SurfaceLIC::update( const core::View& view, bool reload )
         {
-            // Force update if resolution mismatch
+            // A forced reload, like after editing the shaders, builds everything again.
+            if( reload )
+            {
+                finalize();
+            }
+            prepare();
+
+            // A resize only needs new framebuffer textures.
             auto resolution = di::core::Texture::powerOfTwoResolution( view.getViewportSize() );
             if( m_fboResolution != resolution )
             {
@@ -320,8 +569,8 @@ namespace di
                         ", Current FBO: " << m_fboResolution.x << "x" << m_fboResolution.y <<
                         ", New FBO: " << resolution.x << "x" << resolution.y << LogEnd;
 
-                reload = true;
                 m_fboResolution = resolution;
+                resizeFramebuffers();
             }
 
             if( !m_visTriangleData )
@@ -329,29 +578,57 @@ namespace di
                 return;
             }
 
-            if( !isRenderingRequested() && !reload )
+            if( !isRenderingRequested() && m_VAO )
             {
                 return;
             }
             LogD << "Vis Update" << LogEnd;
             resetRenderingRequest();
 
-            prepare();
-
-            // house-keeping
-            if( m_fboEdge )
+            // Frames of a time series only change the vectors. Keep everything else.
+            if( m_VAO && ( m_uploadedTriangleData == m_visTriangleData ) )
             {
-                glDeleteFramebuffers( 1, &m_fboEdge );
-            }
-            if( m_fboAdvect )
-            {
-                glDeleteFramebuffers( 1, &m_fboAdvect );
+                updateAttributes();
+                return;
             }
-            if( m_fboTransform )
+
+            uploadMesh();
+        }
+
+        void SurfaceLIC::resizeFramebuffers()
+        {
+            LogD << "Resizing FBO textures" << LogEnd;
+
+            // NOTE: to use an FBO, the texture needs to be initalized empty.
+            m_step1ColorTex->bind();
+            m_step1ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
+            m_step1VecTex->bind();
+            m_step1VecTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
+            m_step1NoiseTex->bind();
+            m_step1NoiseTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_R8, GL_RED, GL_UNSIGNED_BYTE );
+            m_step1DepthTex->bind();
+            m_step1DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
+            m_step2EdgeTex->bind();
+            m_step2EdgeTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
+            m_step3AdvectTex->bind();
+            m_step3AdvectTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
+            logGLError();
+
+            GLuint fbos[ 3 ] = { m_fboTransform, m_fboEdge, m_fboAdvect };
+            for( size_t step = 0; step < 3; ++step )
             {
-                glDeleteFramebuffers( 1, &m_fboTransform );
+                glBindFramebuffer( GL_DRAW_FRAMEBUFFER, fbos[ step ] );
+                if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
+                {
+                    LogE << "glCheckFramebufferStatus failed for Step " << ( step + 1 ) << "." << LogEnd;
+                }
             }
+            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+            logGLError();
+        }
 
+        void SurfaceLIC::uploadMesh()
+        {
             /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Create Vertex Array Object VAO and the corresponding Vertex Buffer Objects VBO for the mesh itself
             /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -367,279 +644,59 @@ namespace di
             GLint vectorsLoc = m_shaderProgram->getAttribLocation( "vectors" );
             logGLError();
 
-            // Create the VAO
-            glGenVertexArrays( 1, &m_VAO );
+            // Create the VAO once. A new mesh only replaces the buffers bound to it.
+            if( !m_VAO )
+            {
+                glGenVertexArrays( 1, &m_VAO );
+            }
             glBindVertexArray( m_VAO );
             logGLError();
 
-            // Create some buffers
-            m_vertexBuffer = std::make_shared< core::Buffer >();
-            m_normalBuffer = std::make_shared< core::Buffer >();
-            m_colorBuffer = std::make_shared< core::Buffer >();
-            m_vectorsBuffer = std::make_shared< core::Buffer >();
-            m_indexBuffer = std::make_shared< core::Buffer >( core::Buffer::BufferType::ElementArray );
+            // The buffers of the mesh are shared with other visualizations of the same mesh. The vectors change per frame.
+            auto grid = m_visTriangleData->getGrid();
+            m_vertexBuffer = core::BufferCache::get( grid, grid->getVertices(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_normalBuffer = core::BufferCache::get( grid, grid->getNormals(), core::Buffer::BufferType::Array, grid->getVersion() );
+            m_colorBuffer = core::BufferCache::get( m_visTriangleData->getAttributes() );
+            if( !m_vectorsBuffer )
+            {
+                m_vectorsBuffer = std::make_shared< core::DoubleBuffer >();
+            }
+            m_indexBuffer = core::BufferCache::get( grid, grid->getTriangles(), core::Buffer::BufferType::ElementArray, grid->getVersion() );
             logGLError();
 
-            // Set the data using the triangle mesh. Also set the location mapping of the shader using the VAO
-            m_vertexBuffer->realize();
+            // Set the location mapping of the shader using the VAO
             m_vertexBuffer->bind();
-            m_vertexBuffer->data( m_visTriangleData->getGrid()->getVertices() );
             logGLError();
 
             glEnableVertexAttribArray( vertexLoc );
             glVertexAttribPointer( vertexLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_colorBuffer->realize();
             m_colorBuffer->bind();
-            m_colorBuffer->data( m_visTriangleData->getAttributes() );
             glEnableVertexAttribArray( colorLoc );
             glVertexAttribPointer( colorLoc, 4, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_normalBuffer->realize();
             m_normalBuffer->bind();
-            m_normalBuffer->data( m_visTriangleData->getGrid()->getNormals() );
             glEnableVertexAttribArray( normalLoc );
             glVertexAttribPointer( normalLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_vectorsBuffer->realize();
-            m_vectorsBuffer->bind();
-            m_vectorsBuffer->data( m_visTriangleVectorData->getAttributes() );
+            m_uploadedVectorData = m_visTriangleVectorData;
+            m_vectorsBuffer->data( m_uploadedVectorData->getAttributes() );
             glEnableVertexAttribArray( vectorsLoc );
             glVertexAttribPointer( vectorsLoc, 3, GL_FLOAT, 0, 0, 0 );
             logGLError();
 
-            m_indexBuffer->realize();
             m_indexBuffer->bind();
-            m_indexBuffer->data( m_visTriangleData->getGrid()->getTriangles() );
             logGLError();
+            m_uploadedTriangleData = m_visTriangleData;
 
             // for texture coordinates, we use the [0,1]-scaled vertex coordinates -> we need the BB to scale.
             core::BoundingBox bb = m_visTriangleData->getGrid()->getBoundingBox();
-            m_shaderProgram->setUniform( "u_meshBBMin", bb.getMin() );
-            m_shaderProgram->setUniform( "u_meshBBMax", bb.getMax() );
-            logGLError();
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Texture input data
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-            // We need 3D noise.
-            m_whiteNoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex3D );
-            m_whiteNoiseTex->realize();
-            //glActiveTexture( GL_TEXTURE0 );
-            m_whiteNoiseTex->bind();
-            logGLError();
-
-            const size_t noiseWidth = 128;
-
-            // create some noise
-            std::srand( time( 0 ) );
-            std::vector< unsigned char > randData;
-            randData.reserve( noiseWidth * noiseWidth * noiseWidth );
-            for( size_t i = 0; i < noiseWidth * noiseWidth * noiseWidth; ++i )
-            {
-                unsigned char r = static_cast< unsigned char >( std::rand() % 255 );  // NOLINT - no we want std::rand instead of rand_r
-                randData.push_back( r );
-            }
-
-            // Commit data
-            m_whiteNoiseTex->data( randData.data(), noiseWidth, noiseWidth, noiseWidth, GL_R8, GL_RED, GL_UNSIGNED_BYTE );
-
-            // Bind to the shader
-            m_shaderProgram->setUniform( "u_noiseSampler", 0 );
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Create a Framebuffer Object (FBO) and setup LIC pipeline
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 1: Render and transform to image space
-            LogD << "Creating Transform Pass FBO" << LogEnd;
-
-            // The framebuffer
-            glGenFramebuffers( 1, & m_fboTransform );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboTransform );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step1ColorTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1ColorTex->realize();
-            m_step1ColorTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step1ColorTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            m_step1VecTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1VecTex->realize();
-            m_step1VecTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1VecTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGBA16F, GL_RGBA, GL_FLOAT );
-            logGLError();
-
-            m_step1NoiseTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1NoiseTex->realize();
-            m_step1NoiseTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1NoiseTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_R8, GL_RED, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            m_step1DepthTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step1DepthTex->realize();
-            m_step1DepthTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            m_step1DepthTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_FLOAT );
-            m_step1DepthTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step1ColorTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, m_step1VecTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, m_step1NoiseTex->getObjectID() , 0 );
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_step1DepthTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_shaderProgram->getObjectID(), 0, "fragColor" );
-            glBindFragDataLocation( m_shaderProgram->getObjectID(), 1, "fragVec" );
-            glBindFragDataLocation( m_shaderProgram->getObjectID(), 2, "fragNoise" );
-            logGLError();
-
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 1." << LogEnd;
-            }
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 2: Edges in depth buffer
-            LogD << "Creating Edge Pass FBO" << LogEnd;
-
-            // The framebuffer
-            glGenFramebuffers( 1, & m_fboEdge );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboEdge );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step2EdgeTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step2EdgeTex->realize();
-            m_step2EdgeTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step2EdgeTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
-            m_step2EdgeTex->setTextureFilter( core::Texture::TextureFilter::LinearMipmapLinear, core::Texture::TextureFilter::Linear );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step2EdgeTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_edgeProgram->getObjectID(), 0, "fragEdge" );
-            logGLError();
-
-            // Samplers
-            m_edgeProgram->bind();
-            m_edgeProgram->setUniform( "u_depthSampler", 0 );
-
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 2." << LogEnd;
-            }
-
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 3: Advect
-            LogD << "Creating Advect Pass FBO" << LogEnd;
-
-            // The framebuffer
-            glGenFramebuffers( 1, & m_fboAdvect );
-
-            // Bind it to be able to modify and configure:
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, m_fboAdvect );
-            logGLError();
-
-            // We need two target texture: color and noise
-            m_step3AdvectTex = std::make_shared< core::Texture >( core::Texture::TextureType::Tex2D );
-            m_step3AdvectTex->realize();
-            m_step3AdvectTex->bind();
-            // NOTE: to use an FBO, the texture needs to be initalized empty.
-            // TODO(sebastian): fixed size textures are a problem ...
-            m_step3AdvectTex->data( nullptr, m_fboResolution.x, m_fboResolution.y, 1, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE );
-            logGLError();
-
-            // Bind textures to FBO
-            glFramebufferTexture( GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_step3AdvectTex->getObjectID() , 0 );
-            logGLError();
-
-            // Define the out vars to bind to the attachments
-            glBindFragDataLocation( m_advectProgram->getObjectID(), 0, "fragAdvect" );
-            logGLError();
-
-            // Samplers
-            m_advectProgram->bind();
-            m_advectProgram->setUniform( "u_depthSampler", 0 );
-            m_advectProgram->setUniform( "u_noiseSampler", 1 );
-            m_advectProgram->setUniform( "u_vecSampler",   2 );
-            m_advectProgram->setUniform( "u_edgeSampler",   3 );
-
-            if( glCheckFramebufferStatus( GL_DRAW_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
-            {
-                LogE << "glCheckFramebufferStatus failed for Step 3." << LogEnd;
-            }
-
-            /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Step 4: Compose
-            LogD << "Creating Compose Pass FBO" << LogEnd;
-
-            // Unbind other FBO
-            glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
-
-            // Bind the result textures to the next step
-            m_composeProgram->bind();
-            m_composeProgram->setUniform( "u_colorSampler", 0 );
-            m_composeProgram->setUniform( "u_vecSampler", 1 );
-            m_composeProgram->setUniform( "u_depthSampler", 2 );
-            m_composeProgram->setUniform( "u_edgeSampler", 3 );
-            m_composeProgram->setUniform( "u_noiseSampler", 4 );
-            m_composeProgram->setUniform( "u_advectSampler", 5 );
-
-            //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-            // Create an VAO containing the full-screen quad
-            LogD << "Creating flat VAO" << LogEnd;
-
-            // Create the full-screen quad.
-            float points[] = {
-             -1.0f,  1.0f,  0.0f,
-              1.0f,  1.0f,  0.0f,
-              1.0f, -1.0f,  0.0f,
-
-              1.0f, -1.0f,  0.0f,
-             -1.0f, -1.0f,  0.0f,
-             -1.0f,  1.0f,  0.0f
-            };
-
-            // Create Vertex Array Object
-            glGenVertexArrays( 1, &m_screenQuadVAO );
-            glBindVertexArray( m_screenQuadVAO );
-            logGLError();
-
-            m_screenQuadVertexBuffer = std::make_shared< core::Buffer >();
-            m_screenQuadVertexBuffer->realize();
-            m_screenQuadVertexBuffer->bind();
-            m_screenQuadVertexBuffer->data( 9 * 2 * sizeof( float ), points );
-            logGLError();
-
-            glEnableVertexAttribArray( 0 );
-            glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, 0, nullptr );
+            m_shaderProgram->setPersistentUniform( "u_meshBBMin", bb.getMin() );
+            m_shaderProgram->setPersistentUniform( "u_meshBBMax", bb.getMax() );
             logGLError();
         }
     }
 }
-
@@ -25,7 +25,10 @@
 #ifndef DI_SURFACELIC_H
 #define DI_SURFACELIC_H
 
+#include <di/gfx/DoubleBuffer.h>
 #include <di/gfx/GL.h>
+#include <di/gfx/GPUTimer.h>
+#include <di/gfx/Uniform.h>
 
 #include <di/core/Algorithm.h>
 #include <di/core/Visualization.h>
@@ -117,6 +120,21 @@ namespace di
 
         protected:
         private:
+            /**
+             * Upload changed vectors to the back buffer and use it. Requires the VAO to exist for the current mesh.
+             */
+            void updateAttributes();
+
+            /**
+             * Give the framebuffer textures the size \ref m_fboResolution. The framebuffers and their attachments stay.
+             */
+            void resizeFramebuffers();
+
+            /**
+             * Bind the buffers of the current mesh and vectors to the VAO. Creates the VAO if needed.
+             */
+            void uploadMesh();
+
             /**
              * The triangle mesh input to use.
              */
@@ -168,9 +186,19 @@ namespace di
             SPtr< di::core::Buffer > m_normalBuffer = nullptr;
 
             /**
-             * Vector data
+             * Vector data. Double-buffered, as it changes with each frame of a time series.
+             */
+            SPtr< di::core::DoubleBuffer > m_vectorsBuffer = nullptr;
+
+            /**
+             * The mesh in the buffers.
              */
-            SPtr< di::core::Buffer > m_vectorsBuffer = nullptr;
+            ConstSPtr< di::core::TriangleDataSet > m_uploadedTriangleData = nullptr;
+
+            /**
+             * The vectors in the buffers.
+             */
+            ConstSPtr< di::core::TriangleVectorField > m_uploadedVectorData = nullptr;
 
             /**
              * Index array.
@@ -248,9 +276,24 @@ namespace di
             SPtr< di::core::Program > m_composeProgram = nullptr;
 
             /**
-             * Current FBO resolution.
+             * u_viewportScale of the advection, set each frame.
+             */
+            core::Uniform m_advectViewportScale = "u_viewportScale";
+
+            /**
+             * u_viewportScale of the composition, set each frame.
+             */
+            core::Uniform m_composeViewportScale = "u_viewportScale";
+
+            /**
+             * Current FBO resolution. Zero until the textures got a size.
+             */
+            glm::ivec2 m_fboResolution = glm::ivec2( 0 );
+
+            /**
+             * Measures the GPU time of the render passes.
              */
-            glm::ivec2 m_fboResolution = glm::ivec2( 2048, 2048 );
+            core::GPUTimer m_gpuTimer;
         };
     }
 }
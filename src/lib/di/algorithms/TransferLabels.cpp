@@ -0,0 +1,207 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include <di/core/ParallelFor.h>
+
+#include "TransferLabels.h"
+
+#include <di/core/Logger.h>
+#define LogTag "algorithms/TransferLabels"
+
+namespace di
+{
+    namespace algorithms
+    {
+        TransferLabels::TransferLabels():
+            Algorithm( "Transfer Labels",
+                       "Transfer labels and directions of one mesh to the nearest vertices of another mesh." )
+        {
+            // 1: the outputs
+            m_labelOutput = addOutput< di::io::RegionLabelReader::DataSetType >(
+                    "Triangle Labels",
+                    "The labels of the target mesh vertices."
+            );
+
+            m_vectorOutput = addOutput< di::core::TriangleVectorField >(
+                    "Directionality",
+                    "The directions on the target mesh. Only if source directions are given."
+            );
+
+            // 2: the inputs
+            m_sourceMeshInput = addInput< di::core::TriangleDataSet >(
+                    "Source Mesh",
+                    "The mesh the labels are defined on."
+            );
+
+            m_sourceLabelInput = addInput< di::io::RegionLabelReader::DataSetType >(
+                    "Source Labels",
+                    "Labels of the source mesh vertices."
+            );
+
+            m_sourceVectorInput = addInput< di::core::TriangleVectorField >(
+                    "Source Directions",
+                    "Directions on the source mesh. Optional."
+            );
+
+            m_targetMeshInput = addInput< di::core::TriangleDataSet >(
+                    "Target Mesh",
+                    "The mesh to transfer the labels to."
+            );
+
+            m_neighbours = addParameter< int >(
+                    "Neighbours",
+                    "The number of nearest source vertices per target vertex. Labels are chosen by a distance weighted vote, directions are "
+                    "interpolated by inverse distance weighting.",
+                    1
+            );
+            m_neighbours->setRangeHint( 1, 32 );
+            m_neighbours->setValidator( []( const int& value )
+                {
+                    return ( value >= 1 ) && ( value <= 32 );
+                }
+            );
+        }
+
+        TransferLabels::~TransferLabels()
+        {
+            // nothing to clean up so far
+        }
+
+        void TransferLabels::process()
+        {
+            // Get input data
+            auto sourceDataSet = m_sourceMeshInput->getData();
+            auto sourceLabelDataSet = m_sourceLabelInput->getData();
+            auto sourceVectorDataSet = m_sourceVectorInput->getData();
+            auto targetDataSet = m_targetMeshInput->getData();
+            if( !sourceDataSet || !sourceLabelDataSet || !targetDataSet )
+            {
+                return;
+            }
+
+            auto source = sourceDataSet->getGrid();
+            auto sourceLabels = sourceLabelDataSet->getAttributes< 0 >();
+            auto target = targetDataSet->getGrid();
+            if( source->getNumVertices() == 0 )
+            {
+                LogW << "The source mesh has no vertices. There is nothing to transfer." << LogEnd;
+                m_labelOutput->setData( nullptr );
+                m_vectorOutput->setData( nullptr );
+                return;
+            }
+
+            if( sourceLabels->size() != source->getNumVertices() )
+            {
+                LogE << "The source mesh has " << source->getNumVertices() << " vertices but there are " << sourceLabels->size() << " labels."
+                     << LogEnd;
+                return;
+            }
+
+            auto sourceVectors = sourceVectorDataSet ? sourceVectorDataSet->getAttributes< 0 >() : nullptr;
+            if( sourceVectors && ( sourceVectors->size() != source->getNumVertices() ) )
+            {
+                LogW << "The source directions do not belong to the source mesh. Ignoring them." << LogEnd;
+                sourceVectors = nullptr;
+            }
+
+            // The tree only depends on the source mesh. Transferring other labels defined on it reuses the tree.
+            if( !m_tree || ( m_treeMesh != source ) )
+            {
+                getProgress().begin( "Building search tree", 1 );
+                m_tree = std::make_shared< di::core::KdTree >( source->getVertices() );
+                m_treeMesh = source;
+                getProgress().end();
+            }
+
+            size_t k = std::min< size_t >( m_neighbours->get(), source->getNumVertices() );
+            std::vector< size_t > indices;
+            std::vector< float > distances;
+            getProgress().begin( "Finding nearest vertices", 1 );
+            m_tree->nearest( target->getVertices(), k, &indices, &distances );
+            getProgress().end();
+
+            auto labels = std::make_shared< di::io::RegionLabelReader::AttributeType >( target->getNumVertices() );
+            auto vectors = sourceVectors ? std::make_shared< di::Vec3Array >( target->getNumVertices() ) : nullptr;
+            di::core::parallelFor( 0, target->getNumVertices(),
+                [ & ]( size_t from, size_t to )
+                {
+                    std::map< di::io::RegionLabelReader::value_type, float > votes;
+                    for( size_t vertexID = from; vertexID < to; ++vertexID )
+                    {
+                        const auto* nearest = &indices[ vertexID * k ];
+                        const auto* distance = &distances[ vertexID * k ];
+
+                        // A target vertex on a source vertex takes its values. Otherwise, nearer vertices weigh more.
+                        if( ( k == 1 ) || ( distance[ 0 ] == 0.0f ) )
+                        {
+                            ( *labels )[ vertexID ] = ( *sourceLabels )[ nearest[ 0 ] ];
+                            if( vectors )
+                            {
+                                ( *vectors )[ vertexID ] = ( *sourceVectors )[ nearest[ 0 ] ];
+                            }
+                            continue;
+                        }
+
+                        votes.clear();
+                        glm::vec3 vector( 0.0f );
+                        for( size_t n = 0; n < k; ++n )
+                        {
+                            float weight = 1.0f / std::sqrt( distance[ n ] );
+                            votes[ ( *sourceLabels )[ nearest[ n ] ] ] += weight;
+                            if( vectors )
+                            {
+                                vector += weight * ( *sourceVectors )[ nearest[ n ] ];
+                            }
+                        }
+
+                        // Ties are won by the label of the nearest vertex.
+                        auto best = votes.find( ( *sourceLabels )[ nearest[ 0 ] ] );
+                        for( auto vote = votes.begin(); vote != votes.end(); ++vote )
+                        {
+                            if( vote->second > best->second )
+                            {
+                                best = vote;
+                            }
+                        }
+                        ( *labels )[ vertexID ] = best->first;
+
+                        if( vectors )
+                        {
+                            ( *vectors )[ vertexID ] = ( glm::length( vector ) > 0.0f ) ? glm::normalize( vector ) : vector;
+                        }
+                    }
+                }
+            );
+
+            m_labelOutput->setData( std::make_shared< di::io::RegionLabelReader::DataSetType >( "Transferred Labels", labels ) );
+            m_vectorOutput->setData( vectors ? std::make_shared< di::core::TriangleVectorField >( "Transferred Directionality", target, vectors )
+                                             : nullptr );
+        }
+    }
+}
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_TRANSFERLABELS_H
+#define DI_TRANSFERLABELS_H
+
+#include <di/core/Algorithm.h>
+#include <di/core/ParameterTypes.h>
+#include <di/core/data/DataSetTypes.h>
+#include <di/core/data/KdTree.h>
+#include <di/io/RegionLabelReader.h>
+
+namespace di
+{
+    namespace algorithms
+    {
+        /**
+         * Transfer labels and directions from one mesh to another, like from a low to a high resolution version of the same surface. Each target
+         * vertex gets the values of its nearest source vertices.
+         */
+        class TransferLabels: public di::core::Algorithm
+        {
+        public:
+            /**
+             * Constructor. Initialize all inputs, outputs and parameters.
+             */
+            TransferLabels();
+
+            /**
+             * Destructor. Clean up if needed.
+             */
+            virtual ~TransferLabels();
+
+            /**
+             * Find the nearest source vertices of each target vertex and transfer the labels and directions.
+             */
+            virtual void process();
+
+        protected:
+        private:
+            /**
+             * The mesh the labels are defined on.
+             */
+            SPtr< di::core::Connector< di::core::TriangleDataSet > > m_sourceMeshInput;
+
+            /**
+             * The labels of the source mesh vertices.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_sourceLabelInput;
+
+            /**
+             * Optional directions on the source mesh.
+             */
+            SPtr< di::core::Connector< di::core::TriangleVectorField > > m_sourceVectorInput;
+
+            /**
+             * The mesh to transfer to.
+             */
+            SPtr< di::core::Connector< di::core::TriangleDataSet > > m_targetMeshInput;
+
+            /**
+             * The labels of the target mesh vertices.
+             */
+            SPtr< di::core::Connector< di::io::RegionLabelReader::DataSetType > > m_labelOutput;
+
+            /**
+             * The directions on the target mesh.
+             */
+            SPtr< di::core::Connector< di::core::TriangleVectorField > > m_vectorOutput;
+
+            /**
+             * The number of source vertices to consider per target vertex.
+             */
+            core::ParamInt m_neighbours;
+
+            /**
+             * The mesh \ref m_tree was built for.
+             */
+            ConstSPtr< di::core::TriangleMesh > m_treeMesh;
+
+            /**
+             * The search tree over the source vertices. Kept as long as the source mesh does not change.
+             */
+            SPtr< di::core::KdTree > m_tree;
+        };
+    }
+}
+
+#endif  // DI_TRANSFERLABELS_H
@@ -30,7 +30,6 @@ uniform sampler2D u_noiseSampler;
 uniform sampler2D u_vecSampler;
 uniform sampler2D u_edgeSampler;
 
-uniform vec2 u_viewportSize;
 uniform vec2 u_viewportScale;
 
 // Varyings
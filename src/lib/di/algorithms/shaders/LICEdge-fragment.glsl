@@ -26,8 +26,6 @@
 
 // Uniforms
 uniform sampler2D u_depthSampler;
-uniform vec2 u_viewportSize;
-
 // Varyings
 in vec2 v_texCoord; // normalized texel coords!
 
@@ -30,7 +30,6 @@ in vec3 v_vector;
 in vec3 v_noiseCoord;
 
 uniform sampler3D u_noiseSampler;
-uniform mat4 u_ViewMatrix;
 
 out vec4 fragColor;
 out vec4 fragVec;
@@ -31,8 +31,6 @@ in vec3 normal;
 in vec3 vectors;
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
 // BB of the geometry
 uniform vec3 u_meshBBMax;
 uniform vec3 u_meshBBMin;
@@ -29,9 +29,6 @@ in vec3 position;
 in vec4 color;
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
-
 // Varying out
 out vec4 v_color;
 
@@ -33,8 +33,6 @@ layout( triangle_strip, max_vertices = 4 ) out;
 #endif
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
 uniform vec2 u_viewportScale = vec2( 1.0 );
 
 uniform float u_width = 1.5;
@@ -26,7 +26,6 @@
 
 // Uniforms
 uniform vec2 u_viewportScale = vec2( 1.0 );
-uniform mat4 u_ViewMatrix;
 uniform vec3 u_bbSize;
 
 // Attribute data
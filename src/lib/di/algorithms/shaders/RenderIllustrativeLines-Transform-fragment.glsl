@@ -37,7 +37,6 @@ in vec4 v_posView;
 in vec3 v_vector;
 in float v_vectorLength;
 
-uniform mat4 u_ViewMatrix;
 uniform float u_specularity = 0.25;
 uniform float u_maxVectorLength = 1.0;
 uniform bool u_emphasizeSingularPointsEnable = false;
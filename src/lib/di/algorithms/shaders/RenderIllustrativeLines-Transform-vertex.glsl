@@ -34,8 +34,6 @@ in vec3 vectors;
 in uint label;
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
 uniform int[NumLabels] u_maskLabel;
 uniform bool u_maskLabelEnable;
 uniform float u_desaturationIntensity;
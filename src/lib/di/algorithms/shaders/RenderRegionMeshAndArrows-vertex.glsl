@@ -30,9 +30,6 @@ in vec3 normal;
 in vec4 color;
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
-
 // Varying out
 out vec4 v_color;
 
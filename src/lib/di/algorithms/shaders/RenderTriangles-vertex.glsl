@@ -30,9 +30,6 @@ in vec4 color;
 in vec3 normal;
 
 // Uniforms
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ViewMatrix;
-
 // Varying out
 out vec4 v_color;
 out vec3 v_normal;
@@ -25,6 +25,7 @@
 #ifndef DI_CALLBACK_H
 #define DI_CALLBACK_H
 
+#include <functional>
 #include <string>
 
 #include <di/core/CommandObserver.h>
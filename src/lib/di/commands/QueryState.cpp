@@ -58,5 +58,15 @@ namespace di
         {
             return m_state;
         }
+
+        void QueryState::setMemoryFootprint( const di::core::State& state )
+        {
+            m_memoryFootprint = state;
+        }
+
+        const di::core::State& QueryState::getMemoryFootprint() const
+        {
+            return m_memoryFootprint;
+        }
     }
 }
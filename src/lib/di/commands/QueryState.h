@@ -84,12 +84,31 @@ namespace di
              */
             void setState( const di::core::State& state );
 
+            /**
+             * Get the memory footprint of the network at the time of the query. See ProcessingNetwork::getMemoryFootprint.
+             *
+             * \return the state. All values in bytes.
+             */
+            const di::core::State& getMemoryFootprint() const;
+
+            /**
+             * Set the memory footprint result.
+             *
+             * \param state the state
+             */
+            void setMemoryFootprint( const di::core::State& state );
+
         protected:
         private:
             /**
              * The result state
              */
             di::core::State m_state;
+
+            /**
+             * The memory footprint per algorithm and connector.
+             */
+            di::core::State m_memoryFootprint;
         };
     }
 }
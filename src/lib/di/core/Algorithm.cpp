@@ -23,10 +23,13 @@
 //---------------------------------------------------------------------------------------
 
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 
+#include <di/core/AllocationTracker.h>
 #include <di/core/ObserverCallback.h>
 #include <di/core/ObserverParameter.h>
+#include <di/core/Trace.h>
 
 #include "Algorithm.h"
 
@@ -44,6 +47,7 @@ namespace di
         {
             // init
             m_active.store( true );
+            m_runCount.store( 0 );
         }
 
         Algorithm::~Algorithm()
@@ -71,6 +75,18 @@ namespace di
             return m_parameters;
         }
 
+        SPtr< ParameterBase > Algorithm::getParameter( const std::string& name ) const
+        {
+            for( auto param : m_parameters )
+            {
+                if( param->getName() == name )
+                {
+                    return param;
+                }
+            }
+            throw std::invalid_argument( "Could not find parameter \"" + name + "\" in algorithm \"" + getName() + "\"." );
+        }
+
         void Algorithm::addInput( SPtr< ConnectorBase > input )
         {
             m_inputs.insert( input );
@@ -202,7 +218,32 @@ namespace di
 
         void Algorithm::run()
         {
-            process();
+            TraceSpan span( LogTag, getName() );
+            {
+                AllocationScope allocations( getName() );
+                process();
+                if( AllocationTracker::isEnabled() )
+                {
+                    span.setArgument( "allocations", static_cast< double >( allocations.getAllocations() ) );
+                }
+            }
+            requestUpdate( false );
+            ++m_runCount;
+        }
+
+        size_t Algorithm::getRunCount() const
+        {
+            return m_runCount.load();
+        }
+
+        void Algorithm::restoreOutput( const std::string& name, ConstSPtr< ConnectorTransferable > data )
+        {
+            // Outputs are only stored const to keep others from setting them. Restoring is the exception.
+            std::const_pointer_cast< ConnectorBase >( getOutput( name ) )->setTransferable( data );
+        }
+
+        void Algorithm::resetUpdateRequest()
+        {
             requestUpdate( false );
         }
 
@@ -211,6 +252,16 @@ namespace di
             return m_runtimeName;
         }
 
+        Progress& Algorithm::getProgress()
+        {
+            return m_progress;
+        }
+
+        const Progress& Algorithm::getProgress() const
+        {
+            return m_progress;
+        }
+
         void Algorithm::setRuntimeName( const std::string& name )
         {
             m_runtimeName = name;
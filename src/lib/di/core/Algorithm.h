@@ -35,6 +35,7 @@
 #include <di/core/Parameter.h>
 #include <di/core/Observable.h>
 #include <di/core/ConnectorTransferable.h>
+#include <di/core/Progress.h>
 
 #include <di/Types.h>
 
@@ -71,6 +72,18 @@ namespace di
              */
             void setRuntimeName( const std::string& name );
 
+            /**
+             * The progress of this algorithm while running. Algorithms with long running loops should update it.
+             *
+             * \return the progress
+             */
+            Progress& getProgress();
+
+            /**
+             * \copydoc getProgress
+             */
+            const Progress& getProgress() const;
+
             /**
              * Returns a useful description for the algorithm. Everything is allowed in the string. Please use a description that helps the user to
              * understand your algorithm. Refer to papers if necessary.
@@ -158,6 +171,17 @@ namespace di
              */
             const SPtrVec< ParameterBase >& getParameters() const;
 
+            /**
+             * Query a parameter by name.
+             *
+             * \param name name of the parameter to get.
+             *
+             * \throw std::invalid_argument if the parameter does not exist.
+             *
+             * \return the parameter
+             */
+            SPtr< ParameterBase > getParameter( const std::string& name ) const;
+
             /**
              * Get the list of inputs of this algorithm.
              *
@@ -230,6 +254,30 @@ namespace di
              * \return true if so.
              */
             bool isUpdateRequested() const;
+
+            /**
+             * How often \ref run was called. Use it to check whether results were reused.
+             *
+             * \return the number of runs
+             */
+            size_t getRunCount() const;
+
+            /**
+             * Set the data of an output from outside, like when restoring a snapshot of an earlier run. Usually, only the algorithm itself sets
+             * its outputs.
+             *
+             * \param name the output
+             * \param data the data
+             *
+             * \throw std::invalid_argument if the output does not exist.
+             */
+            void restoreOutput( const std::string& name, ConstSPtr< ConnectorTransferable > data );
+
+            /**
+             * Consider the algorithm up to date, like after restoring its inputs and outputs from a snapshot. It runs again as soon as a parameter
+             * or an input changes.
+             */
+            void resetUpdateRequest();
         protected:
             /**
              * Constructor.
@@ -419,6 +467,11 @@ namespace di
              */
             std::string m_runtimeName = "";
 
+            /**
+             * Progress while running.
+             */
+            Progress m_progress;
+
             /**
              * The description of the algorithm.
              */
@@ -433,6 +486,11 @@ namespace di
              * If true, an update was requested.
              */
             bool m_updateRequested = false;
+
+            /**
+             * Number of runs.
+             */
+            std::atomic< size_t > m_runCount;
         };
 
         /**
@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.h"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * The allocations of this thread. Plain data to avoid any dynamic initialization inside operator new.
+             */
+            thread_local AllocationTracker::Counters g_threadCounters = { 0, 0 };
+
+            /**
+             * Protects the records.
+             */
+            std::mutex g_recordsMutex;
+
+            /**
+             * All records by name.
+             */
+            std::map< std::string, AllocationTracker::Record > g_records;
+
+#ifdef DI_ALLOCATION_TRACKING
+            /**
+             * Allocate and count. Used by the replaced global operators.
+             *
+             * \param size the number of bytes
+             *
+             * \return the memory or nullptr.
+             */
+            void* countedAllocation( size_t size )
+            {
+                g_threadCounters.m_allocations++;
+                g_threadCounters.m_bytes += size;
+                return std::malloc( size ? size : 1 );
+            }
+#endif
+        }
+
+        bool AllocationTracker::isEnabled()
+        {
+#ifdef DI_ALLOCATION_TRACKING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        AllocationTracker::Counters AllocationTracker::getThreadCounters()
+        {
+            return g_threadCounters;
+        }
+
+        void AllocationTracker::addToThread( const Counters& counters )
+        {
+            g_threadCounters.m_allocations += counters.m_allocations;
+            g_threadCounters.m_bytes += counters.m_bytes;
+        }
+
+        void AllocationTracker::record( const std::string& name, uint64_t allocations, uint64_t bytes, double time )
+        {
+            std::lock_guard< std::mutex > lock( g_recordsMutex );
+            auto& record = g_records[ name ];
+            record.m_name = name;
+            record.m_runs++;
+            record.m_allocations += allocations;
+            record.m_bytes += bytes;
+            record.m_time += time;
+        }
+
+        std::vector< AllocationTracker::Record > AllocationTracker::getRecords()
+        {
+            std::lock_guard< std::mutex > lock( g_recordsMutex );
+            std::vector< Record > result;
+            for( const auto& record : g_records )
+            {
+                result.push_back( record.second );
+            }
+            return result;
+        }
+
+        void AllocationTracker::write( std::ostream& os )
+        {
+            auto records = getRecords();
+            std::sort( records.begin(), records.end(),
+                []( const Record& a, const Record& b )
+                {
+                    return a.m_bytes > b.m_bytes;
+                }
+            );
+
+            os << std::left << std::setw( 60 ) << "Scope" << std::right
+               << std::setw( 8 ) << "Runs" << std::setw( 14 ) << "Allocations" << std::setw( 14 ) << "MB"
+               << std::setw( 14 ) << "Allocs/Run" << std::setw( 12 ) << "ms/Run" << std::endl;
+            os << std::fixed << std::setprecision( 3 );
+            for( const auto& record : records )
+            {
+                auto runs = static_cast< double >( std::max< uint64_t >( record.m_runs, 1 ) );
+                os << std::left << std::setw( 60 ) << record.m_name << std::right
+                   << std::setw( 8 ) << record.m_runs << std::setw( 14 ) << record.m_allocations
+                   << std::setw( 14 ) << static_cast< double >( record.m_bytes ) / ( 1024.0 * 1024.0 )
+                   << std::setw( 14 ) << static_cast< double >( record.m_allocations ) / runs
+                   << std::setw( 12 ) << record.m_time / runs << std::endl;
+            }
+            os << std::defaultfloat;
+        }
+
+        void AllocationTracker::clear()
+        {
+            std::lock_guard< std::mutex > lock( g_recordsMutex );
+            g_records.clear();
+        }
+
+        AllocationScope::AllocationScope( const std::string& name ):
+            m_start( AllocationTracker::getThreadCounters() )
+        {
+            if( AllocationTracker::isEnabled() )
+            {
+                m_name = name;
+                m_startTime = std::chrono::steady_clock::now();
+                // Do not count the name.
+                m_start = AllocationTracker::getThreadCounters();
+            }
+        }
+
+        AllocationScope::~AllocationScope()
+        {
+            if( AllocationTracker::isEnabled() )
+            {
+                auto time = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - m_startTime ).count();
+                AllocationTracker::record( m_name, getAllocations(), getBytes(), time );
+            }
+        }
+
+        uint64_t AllocationScope::getAllocations() const
+        {
+            return AllocationTracker::getThreadCounters().m_allocations - m_start.m_allocations;
+        }
+
+        uint64_t AllocationScope::getBytes() const
+        {
+            return AllocationTracker::getThreadCounters().m_bytes - m_start.m_bytes;
+        }
+    }
+}
+
+#ifdef DI_ALLOCATION_TRACKING
+
+// Replace the global allocation functions. The deallocation functions need to be replaced too, as they have to match the allocation.
+
+void* operator new( size_t size )
+{
+    void* memory = di::core::countedAllocation( size );
+    if( !memory )
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    return di::core::countedAllocation( size );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+    return di::core::countedAllocation( size );
+}
+
+void operator delete( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+void operator delete[]( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+void operator delete( void* memory, const std::nothrow_t& ) noexcept
+{
+    std::free( memory );
+}
+
+void operator delete[]( void* memory, const std::nothrow_t& ) noexcept
+{
+    std::free( memory );
+}
+
+#endif
+
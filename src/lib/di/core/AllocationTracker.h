@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_ALLOCATIONTRACKER_H
+#define DI_ALLOCATIONTRACKER_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Counts heap allocations. Only available if compiled with DI_ALLOCATION_TRACKING (CMake option of the same name). The global operator
+         * new gets replaced then and counts the allocations and allocated bytes of each thread. Use \ref AllocationScope to attribute them to
+         * an algorithm run or visualization update. Without DI_ALLOCATION_TRACKING, all counters stay 0 and scopes cost nothing.
+         */
+        class AllocationTracker
+        {
+        public:
+            /**
+             * The allocations of a thread.
+             */
+            struct Counters
+            {
+                /**
+                 * Number of allocations.
+                 */
+                uint64_t m_allocations;
+
+                /**
+                 * Number of allocated bytes.
+                 */
+                uint64_t m_bytes;
+            };
+
+            /**
+             * The allocations of all scopes of the same name.
+             */
+            struct Record
+            {
+                /**
+                 * The scope name.
+                 */
+                std::string m_name;
+
+                /**
+                 * How often the scope was entered.
+                 */
+                uint64_t m_runs = 0;
+
+                /**
+                 * Number of allocations in all runs.
+                 */
+                uint64_t m_allocations = 0;
+
+                /**
+                 * Number of bytes allocated in all runs.
+                 */
+                uint64_t m_bytes = 0;
+
+                /**
+                 * Time spent in all runs, in ms.
+                 */
+                double m_time = 0.0;
+            };
+
+            /**
+             * Check whether the allocation tracking was compiled in.
+             *
+             * \return true if allocations get counted.
+             */
+            static bool isEnabled();
+
+            /**
+             * The allocations of the calling thread since it started.
+             *
+             * \return the counters.
+             */
+            static Counters getThreadCounters();
+
+            /**
+             * Add allocations done by a helper thread to the calling thread. Used by \ref parallelFor to attribute the allocations of its
+             * worker threads to the scope of the caller.
+             *
+             * \param counters the allocations to add
+             */
+            static void addToThread( const Counters& counters );
+
+            /**
+             * Add the allocations of a scope to the record of the same name.
+             *
+             * \param name the scope name
+             * \param allocations number of allocations
+             * \param bytes number of bytes
+             * \param time the time spent in the scope, in ms.
+             */
+            static void record( const std::string& name, uint64_t allocations, uint64_t bytes, double time );
+
+            /**
+             * Get all records.
+             *
+             * \return the records, sorted by name.
+             */
+            static std::vector< Record > getRecords();
+
+            /**
+             * Write all records as human readable table, sorted by allocated bytes.
+             *
+             * \param os the stream to write to
+             */
+            static void write( std::ostream& os );
+
+            /**
+             * Remove all records.
+             */
+            static void clear();
+        };
+
+        /**
+         * Attributes the allocations of the calling thread during the lifetime of this object to a name. On destruction, allocations and time
+         * get added to the record of the name in \ref AllocationTracker. Does nothing if tracking is not compiled in.
+         *
+         * \code
+         * AllocationScope allocations( getName() );
+         * process();
+         * \endcode
+         */
+        class AllocationScope
+        {
+        public:
+            /**
+             * Start counting.
+             *
+             * \param name the name to attribute the allocations to. Gets copied if tracking is enabled.
+             */
+            explicit AllocationScope( const std::string& name );
+
+            /**
+             * Stop counting and record.
+             */
+            ~AllocationScope();
+
+            /**
+             * The number of allocations since construction.
+             *
+             * \return the count.
+             */
+            uint64_t getAllocations() const;
+
+            /**
+             * The number of allocated bytes since construction.
+             *
+             * \return the bytes.
+             */
+            uint64_t getBytes() const;
+
+        private:
+            /**
+             * Non-copyable.
+             */
+            AllocationScope( const AllocationScope& ) = delete;
+
+            /**
+             * Non-copyable.
+             */
+            AllocationScope& operator=( const AllocationScope& ) = delete;
+
+            /**
+             * The name. Empty if tracking is disabled.
+             */
+            std::string m_name;
+
+            /**
+             * The counters at construction.
+             */
+            AllocationTracker::Counters m_start;
+
+            /**
+             * The time of construction.
+             */
+            std::chrono::steady_clock::time_point m_startTime;
+        };
+    }
+}
+
+#endif  // DI_ALLOCATIONTRACKER_H
+
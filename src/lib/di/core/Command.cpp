@@ -25,6 +25,7 @@
 #include <string>
 
 #include <di/Types.h>
+#include <di/core/Trace.h>
 
 #include "Command.h"
 
@@ -37,7 +38,10 @@ namespace di
     {
         Command::Command( SPtr< CommandObserver > observer ):
             std::enable_shared_from_this< Command >(),
-            m_observer( observer )
+            m_observer( observer ),
+            m_commitTime( 0 ),
+            m_startTime( 0 ),
+            m_finishTime( 0 )
         {
         }
 
@@ -61,6 +65,7 @@ namespace di
             LogD << "Command \"" << getName() << "\", instance " << static_cast< void* >( this ) << ": busy." << LogEnd;
 
             // Change state and notify
+            m_startTime = Trace::now();
             m_isBusy = true;
             m_isWaiting = false;
             if( m_observer )
@@ -85,6 +90,7 @@ namespace di
             LogD << "Command \"" << getName() << "\", instance " << static_cast< void* >( this ) << ": waiting." << LogEnd;
 
             // Change state and notify
+            m_commitTime = Trace::now();
             m_isWaiting = true;
             if( m_observer )
             {
@@ -108,6 +114,7 @@ namespace di
             LogD << "Command \"" << getName() << "\", instance " << static_cast< void* >( this ) << ": success." << LogEnd;
 
             // Change state and notify
+            m_finishTime = Trace::now();
             m_isSuccessful = true;
             m_isWaiting = false;
             m_isBusy = false;
@@ -133,6 +140,7 @@ namespace di
             LogD << "Command \"" << getName() << "\", instance " << static_cast< void* >( this ) << ": abort." << LogEnd;
 
             // Change state and notify
+            m_finishTime = Trace::now();
             m_isAborted = true;
             m_isWaiting = false;
             m_isBusy = false;
@@ -159,6 +167,7 @@ namespace di
             LogE << "Command \"" << getName() << "\", instance " << static_cast< void* >( this ) << ": failed - Reason: " << reason << "" << LogEnd;
 
             // Change state and notify
+            m_finishTime = Trace::now();
             m_isFailed = true;
             m_isAborted = true;
             m_isWaiting = false;
@@ -191,5 +200,28 @@ namespace di
         {
             return m_failureReason;
         }
+
+        void Command::progress( const std::string& stage, double fraction, double remaining )
+        {
+            if( m_observer && isBusy() )
+            {
+                m_observer->progress( shared_from_this(), stage, fraction, remaining );
+            }
+        }
+
+        uint64_t Command::getCommitTime() const
+        {
+            return m_commitTime;
+        }
+
+        uint64_t Command::getStartTime() const
+        {
+            return m_startTime;
+        }
+
+        uint64_t Command::getFinishTime() const
+        {
+            return m_finishTime;
+        }
     }
 }
@@ -25,6 +25,8 @@
 #ifndef DI_COMMAND_H
 #define DI_COMMAND_H
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <exception>
 #include <string>
@@ -168,6 +170,38 @@ namespace di
              */
             virtual const std::string& getFailureReason() const;
 
+            /**
+             * Report the progress of a busy command to the observer.
+             *
+             * \param stage a human readable description of what is going on right now.
+             * \param fraction the progress of the stage in [0,1].
+             * \param remaining the estimated remaining time of the stage in seconds. Negative if unknown.
+             */
+            virtual void progress( const std::string& stage, double fraction, double remaining );
+
+            // Timestamps. All are in ns of the trace clock (see \ref Trace::now) and 0 if the command did not reach this state yet.
+
+            /**
+             * The time when the command was committed to a queue and started waiting.
+             *
+             * \return the time in ns.
+             */
+            uint64_t getCommitTime() const;
+
+            /**
+             * The time when the command became busy.
+             *
+             * \return the time in ns.
+             */
+            uint64_t getStartTime() const;
+
+            /**
+             * The time when the command was done. This includes the positive and negative cases.
+             *
+             * \return the time in ns.
+             */
+            uint64_t getFinishTime() const;
+
         protected:
         private:
             /**
@@ -204,6 +238,21 @@ namespace di
              * The reason for failure.
              */
             std::string m_failureReason = "";
+
+            /**
+             * Time of commit.
+             */
+            std::atomic< uint64_t > m_commitTime;
+
+            /**
+             * Time of start.
+             */
+            std::atomic< uint64_t > m_startTime;
+
+            /**
+             * Time of finish.
+             */
+            std::atomic< uint64_t > m_finishTime;
         };
     }
 }
@@ -22,6 +22,8 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <string>
+
 #include "CommandObserver.h"
 
 namespace di
@@ -37,5 +39,11 @@ namespace di
         {
             // nothing to do.
         }
+
+        void CommandObserver::progress( SPtr< Command > /* command */, const std::string& /* stage */, double /* fraction */,
+                                        double /* remaining */ )
+        {
+            // nothing to do by default.
+        }
     }
 }
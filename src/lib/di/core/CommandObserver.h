@@ -25,6 +25,8 @@
 #ifndef DI_COMMANDOBSERVER_H
 #define DI_COMMANDOBSERVER_H
 
+#include <string>
+
 #include <di/core/Observer.h>
 
 #include <di/Types.h>
@@ -84,6 +86,16 @@ namespace di
              */
             virtual void fail( SPtr< Command > command ) = 0;
 
+            /**
+             * Called while the command is busy to report its progress. Calls are throttled by the issuer. The default implementation does nothing.
+             *
+             * \param command the command that issued this notification.
+             * \param stage a human readable description of what is going on right now.
+             * \param fraction the progress of the stage in [0,1].
+             * \param remaining the estimated remaining time of the stage in seconds. Negative if unknown.
+             */
+            virtual void progress( SPtr< Command > command, const std::string& stage, double fraction, double remaining );
+
         protected:
             /**
              * Constructor. Does nothing.
@@ -22,8 +22,12 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <map>
 #include <string>
 
+#include <di/core/Trace.h>
+
 #include "CommandQueue.h"
 
 #include <di/core/Logger.h>
@@ -44,6 +48,8 @@ namespace di
 
         void CommandQueue::run()
         {
+            Trace::setThreadName( "CommandQueue" );
+
             // Used to lock the command queue mutex
             std::unique_lock< std::mutex > lock( m_commandQueueMutex );
 
@@ -108,10 +114,13 @@ namespace di
                         continue;
                     }
 
+                    Trace::counter( LogTag, "Queue Depth", static_cast< double >( m_commandQueue.size() ) );
+
                     // unlock as this would (otherwise) block the queue itself when "processCommand" is blocking
-                    m_commandQueueMutex.unlock();
+                    lock.unlock();
                     // process
                     processCommand( command );
+                    lock.lock();
                 }
             }
         }
@@ -124,8 +133,15 @@ namespace di
                 return;
             }
 
+            TraceSpan span( LogTag, command->getName() );
+
             // The command is now busy ...
             command->busy();
+            // NOTE: the times are 0 if a state was skipped.
+            uint64_t commitTime = command->getCommitTime();
+            uint64_t startTime = std::max( commitTime, command->getStartTime() );
+            double wait = 1e-6 * static_cast< double >( startTime - commitTime );
+            span.setArgument( "queue wait ms", wait );
             try
             {
                 process( command );
@@ -141,6 +157,40 @@ namespace di
 
             // maybe someone is waiting ... notify
             command->success();
+
+            double execution = 1e-6 * static_cast< double >( std::max( startTime, command->getFinishTime() ) - startTime );
+            std::lock_guard< std::mutex > lock( m_statisticsMutex );
+            auto& series = m_statistics[ command->getName() ];
+            series.m_wait.add( wait );
+            series.m_execution.add( execution );
+        }
+
+        void CommandQueue::recordDepth( const std::string& name, size_t depth )
+        {
+            Trace::counter( LogTag, "Queue Depth", static_cast< double >( depth ) );
+
+            std::lock_guard< std::mutex > lock( m_statisticsMutex );
+            m_statistics[ name ].m_depth.add( static_cast< double >( depth ) );
+        }
+
+        std::map< std::string, CommandQueue::Statistics > CommandQueue::getStatistics() const
+        {
+            std::lock_guard< std::mutex > lock( m_statisticsMutex );
+            std::map< std::string, Statistics > result;
+            for( const auto& series : m_statistics )
+            {
+                auto& statistics = result[ series.first ];
+                statistics.m_wait = series.second.m_wait.getSummary( series.first + "/wait" );
+                statistics.m_execution = series.second.m_execution.getSummary( series.first + "/execution" );
+                statistics.m_depth = series.second.m_depth.getSummary( series.first + "/depth" );
+            }
+            return result;
+        }
+
+        void CommandQueue::clearStatistics()
+        {
+            std::lock_guard< std::mutex > lock( m_statisticsMutex );
+            m_statistics.clear();
         }
 
         void CommandQueue::start()
@@ -165,6 +215,14 @@ namespace di
                 notifyThread();
                 m_thread->join();
                 m_thread = nullptr;
+
+                for( const auto& statistics : getStatistics() )
+                {
+                    LogD << "Command \"" << statistics.first << "\": " << statistics.second.m_execution.m_count << " processed. "
+                         << "Queue wait p50/p95: " << statistics.second.m_wait.m_p50 << "/" << statistics.second.m_wait.m_p95 << " ms, "
+                         << "execution p50/p95: " << statistics.second.m_execution.m_p50 << "/" << statistics.second.m_execution.m_p95 << " ms, "
+                         << "max. queue depth: " << statistics.second.m_depth.m_max << "." << LogEnd;
+                }
             }
         }
 
@@ -27,6 +27,7 @@
 
 #include <condition_variable>
 #include <list>
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -34,6 +35,7 @@
 #include <di/Types.h>
 
 #include <di/core/Command.h>
+#include <di/core/RollingStatistics.h>
 
 namespace di
 {
@@ -45,6 +47,27 @@ namespace di
         class CommandQueue
         {
         public:
+            /**
+             * Latency statistics of all commands of one type. All times are in milliseconds.
+             */
+            struct Statistics
+            {
+                /**
+                 * Time between commit and start of the commands.
+                 */
+                RollingStatistics::Summary m_wait;
+
+                /**
+                 * Time between start and finish of the commands.
+                 */
+                RollingStatistics::Summary m_execution;
+
+                /**
+                 * Number of commands in the queue when a command was committed, including the command itself.
+                 */
+                RollingStatistics::Summary m_depth;
+            };
+
             /**
              * Create an empty command queue. This does not start the queue. Use \ref start() to start processing.
              * After construction, the queue already accepts commands.
@@ -83,6 +106,7 @@ namespace di
 
                 // add and notify processing thread ...
                 m_commandQueue.push_back( command );
+                auto depth = m_commandQueue.size();
 
                 // Change command state.
                 command->waiting();
@@ -90,12 +114,26 @@ namespace di
                 // Done.
                 theLock.unlock();
 
+                recordDepth( command->getName(), depth );
+
                 // Notify thread
                 notifyThread();
 
                 return command;
             }
 
+            /**
+             * Get the latency statistics of the commands processed so far.
+             *
+             * \return the statistics by command name, like "Read File" or "Run Network".
+             */
+            std::map< std::string, Statistics > getStatistics() const;
+
+            /**
+             * Forget the statistics.
+             */
+            void clearStatistics();
+
         protected:
             /**
              * Thread method. Runs inside the m_thread - thread. Processes the currently commited threads.
@@ -156,6 +194,45 @@ namespace di
              * \param command the command to handle
              */
             void processCommand( SPtr< Command > command );
+
+            /**
+             * Record the queue depth at commit of a command.
+             *
+             * \param name the command name
+             * \param depth the queue size after adding the command
+             */
+            void recordDepth( const std::string& name, size_t depth );
+
+            /**
+             * The recorded samples of a command type.
+             */
+            struct StatisticsSeries
+            {
+                /**
+                 * Queue wait.
+                 */
+                RollingStatistics m_wait;
+
+                /**
+                 * Execution time.
+                 */
+                RollingStatistics m_execution;
+
+                /**
+                 * Queue depth.
+                 */
+                RollingStatistics m_depth;
+            };
+
+            /**
+             * The statistics by command name.
+             */
+            std::map< std::string, StatisticsSeries > m_statistics;
+
+            /**
+             * Protects the statistics. They are written by the committing threads and the queue thread.
+             */
+            mutable std::mutex m_statisticsMutex;
         };
     }
 }
@@ -25,8 +25,13 @@
 #include <string>
 #include <sstream>
 
+#include <di/core/Trace.h>
+
 #include "Connection.h"
 
+#include <di/core/Logger.h>
+#define LogTag "core/Connection"
+
 namespace di
 {
     namespace core
@@ -54,6 +59,7 @@ namespace di
 
         bool Connection::propagate()
         {
+            TraceSpan span( LogTag, m_target->getName() );
             m_packageInfo = "0";
 
             // only propagate if needed
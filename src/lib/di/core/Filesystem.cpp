@@ -22,11 +22,19 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <streambuf>
 #include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+    #include <direct.h>
+#endif
 
 #include "Filesystem.h"
 
@@ -63,6 +71,29 @@ namespace di
             return str;
         }
 
+        uint64_t hashFile( const std::string& filename )
+        {
+            std::ifstream file( filename, std::ios::binary );
+            if( !file.good() )
+            {
+                throw std::invalid_argument( "File \"" + filename + "\" could not be opened for reading." );
+            }
+
+            uint64_t hash = 14695981039346656037ull;
+            std::vector< char > buffer( 1 << 20 );
+            while( file )
+            {
+                file.read( buffer.data(), buffer.size() );
+                auto read = file.gcount();
+                for( std::streamsize i = 0; i < read; ++i )
+                {
+                    hash ^= static_cast< uint8_t >( buffer[ i ] );
+                    hash *= 1099511628211ull;
+                }
+            }
+            return hash;
+        }
+
         static std::string g_runtimePath = "";
 
         std::string getRuntimePath()
@@ -76,6 +107,52 @@ namespace di
             return getRuntimePath() + "../share/" + ResourceName + "/";
         }
 
+        std::string getCachePath()
+        {
+#ifdef _WIN32
+            const char* base = std::getenv( "LOCALAPPDATA" );
+            if( base && *base )
+            {
+                return std::string( base ) + "/" + ResourceName + "/";
+            }
+#else
+            const char* xdg = std::getenv( "XDG_CACHE_HOME" );
+            if( xdg && *xdg )
+            {
+                return std::string( xdg ) + "/" + ResourceName + "/";
+            }
+            const char* home = std::getenv( "HOME" );
+            if( home && *home )
+            {
+                return std::string( home ) + "/.cache/" + ResourceName + "/";
+            }
+#endif
+            return "";
+        }
+
+        bool makeDirectories( const std::string& path )
+        {
+            // Create each parent in turn. Existing ones are fine.
+            for( size_t pos = path.find_first_of( "/\\", 1 ); ; pos = path.find_first_of( "/\\", pos + 1 ) )
+            {
+                std::string directory = path.substr( 0, pos );
+#ifdef _WIN32
+                int result = _mkdir( directory.c_str() );
+#else
+                int result = mkdir( directory.c_str(), 0755 );
+#endif
+                if( ( result != 0 ) && ( errno != EEXIST ) )
+                {
+                    return false;
+                }
+
+                if( ( pos == std::string::npos ) || ( pos + 1 == path.size() ) )
+                {
+                    return true;
+                }
+            }
+        }
+
         void initRuntimePath( const std::string& path )
         {
             if( ( path.back() == '/' ) || ( path.back() == '\\' ) )
@@ -25,6 +25,7 @@
 #ifndef DI_FILESYSTEM_H
 #define DI_FILESYSTEM_H
 
+#include <cstdint>
 #include <string>
 
 // This file implements some utils we all love from boost::filesystem
@@ -53,6 +54,17 @@ namespace di
          */
         std::string readTextFile( const std::string& filename );
 
+        /**
+         * Hash the contents of a file. Use it to detect identical files with different names. The hash is the 64 bit FNV-1a hash of the bytes.
+         *
+         * \param filename the filename
+         *
+         * \return the hash
+         *
+         * \throw std::invalid_argument if the file could not be read.
+         */
+        uint64_t hashFile( const std::string& filename );
+
         /**
          * The runtime path of the program. Guaranteed to end with a directory separator.
          *
@@ -67,6 +79,23 @@ namespace di
          */
         std::string getResourcePath();
 
+        /**
+         * The directory to keep caches in, like "~/.cache/DirectionalityIndicator/". Guaranteed to end with a directory separator. Might not exist
+         * yet.
+         *
+         * \return the cache path. Empty if there is no known place for caches.
+         */
+        std::string getCachePath();
+
+        /**
+         * Create a directory and all missing parents.
+         *
+         * \param path the directory
+         *
+         * \return true if the directory exists now.
+         */
+        bool makeDirectories( const std::string& path );
+
         /**
          * Initialize runtime path. Call this as soon as possible.
          *
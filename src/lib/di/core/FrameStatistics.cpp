@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "FrameStatistics.h"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * Protects the series.
+             */
+            std::mutex g_seriesMutex;
+
+            /**
+             * All series by name.
+             */
+            std::map< std::string, RollingStatistics > g_series;
+        }
+
+        std::atomic< bool > FrameStatistics::m_enabled( true );
+
+        void FrameStatistics::setEnabled( bool enable )
+        {
+            m_enabled.store( enable, std::memory_order_relaxed );
+        }
+
+        bool FrameStatistics::isEnabled()
+        {
+            return m_enabled.load( std::memory_order_relaxed );
+        }
+
+        void FrameStatistics::record( const std::string& name, double milliseconds )
+        {
+            if( !isEnabled() )
+            {
+                return;
+            }
+
+            std::lock_guard< std::mutex > lock( g_seriesMutex );
+            g_series[ name ].add( milliseconds );
+        }
+
+        FrameStatistics::Summary FrameStatistics::get( const std::string& name )
+        {
+            std::lock_guard< std::mutex > lock( g_seriesMutex );
+            auto series = g_series.find( name );
+            if( series == g_series.end() )
+            {
+                Summary empty;
+                empty.m_name = name;
+                return empty;
+            }
+            return series->second.getSummary( name );
+        }
+
+        std::vector< FrameStatistics::Summary > FrameStatistics::getAll()
+        {
+            std::lock_guard< std::mutex > lock( g_seriesMutex );
+            std::vector< Summary > result;
+            for( const auto& series : g_series )
+            {
+                result.push_back( series.second.getSummary( series.first ) );
+            }
+            return result;
+        }
+
+        std::vector< double > FrameStatistics::getRecent( const std::string& name )
+        {
+            std::lock_guard< std::mutex > lock( g_seriesMutex );
+            auto series = g_series.find( name );
+            if( series == g_series.end() )
+            {
+                return std::vector< double >();
+            }
+
+            return series->second.getRecent();
+        }
+
+        void FrameStatistics::write( std::ostream& os )
+        {
+            auto all = getAll();
+            os << std::left << std::setw( 40 ) << "Series" << std::right
+               << std::setw( 8 ) << "Count"
+               << std::setw( 10 ) << "Mean" << std::setw( 10 ) << "p50" << std::setw( 10 ) << "p90"
+               << std::setw( 10 ) << "p99" << std::setw( 10 ) << "Max" << "  (ms)" << std::endl;
+            os << std::fixed << std::setprecision( 3 );
+            for( const auto& summary : all )
+            {
+                os << std::left << std::setw( 40 ) << summary.m_name << std::right
+                   << std::setw( 8 ) << summary.m_count
+                   << std::setw( 10 ) << summary.m_mean << std::setw( 10 ) << summary.m_p50 << std::setw( 10 ) << summary.m_p90
+                   << std::setw( 10 ) << summary.m_p99 << std::setw( 10 ) << summary.m_max << std::endl;
+            }
+            os << std::defaultfloat;
+        }
+
+        void FrameStatistics::clear()
+        {
+            std::lock_guard< std::mutex > lock( g_seriesMutex );
+            g_series.clear();
+        }
+    }
+}
+
@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_FRAMESTATISTICS_H
+#define DI_FRAMESTATISTICS_H
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <di/core/RollingStatistics.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Collects timings of things that happen once per frame, like the frame itself or the render passes of a visualization, and aggregates
+         * them into histograms and percentiles. Each series is identified by a name like "SurfaceLIC/advect". Recording and querying is thread-safe.
+         * All times are in milliseconds.
+         */
+        class FrameStatistics
+        {
+        public:
+            /**
+             * The aggregated statistics of a series. See \ref RollingStatistics.
+             */
+            typedef RollingStatistics::Summary Summary;
+
+            /**
+             * Enable or disable recording. Enabled by default. Series are kept when disabling.
+             *
+             * \param enable true to enable
+             */
+            static void setEnabled( bool enable = true );
+
+            /**
+             * Check whether samples get recorded.
+             *
+             * \return true if enabled.
+             */
+            static bool isEnabled();
+
+            /**
+             * Add a sample to a series. Creates the series if needed. Ignored if disabled.
+             *
+             * \param name the series
+             * \param milliseconds the time
+             */
+            static void record( const std::string& name, double milliseconds );
+
+            /**
+             * Get the statistics of a series.
+             *
+             * \param name the series
+             *
+             * \return the summary. The count is 0 if there is no such series.
+             */
+            static Summary get( const std::string& name );
+
+            /**
+             * Get the statistics of all series.
+             *
+             * \return the summaries, sorted by name.
+             */
+            static std::vector< Summary > getAll();
+
+            /**
+             * Get the most recent samples of a series, oldest first.
+             *
+             * \param name the series
+             *
+             * \return the samples. At most RollingStatistics::WindowSize.
+             */
+            static std::vector< double > getRecent( const std::string& name );
+
+            /**
+             * Write all series as human readable table.
+             *
+             * \param os the stream to write to
+             */
+            static void write( std::ostream& os );
+
+            /**
+             * Remove all series.
+             */
+            static void clear();
+
+        private:
+            /**
+             * The global switch.
+             */
+            static std::atomic< bool > m_enabled;
+        };
+    }
+}
+
+#endif  // DI_FRAMESTATISTICS_H
+
@@ -0,0 +1,427 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "Logger.h"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * A queued record. Records form an intrusive, singly linked list.
+             */
+            struct LogQueueNode
+            {
+                /**
+                 * The level.
+                 */
+                LogLevel m_level;
+
+                /**
+                 * The tag. Static lifetime.
+                 */
+                const char* m_tag;
+
+                /**
+                 * The message.
+                 */
+                std::string m_message;
+
+                /**
+                 * The next (older) record.
+                 */
+                LogQueueNode* m_next;
+            };
+
+            /**
+             * The pending (unfinished) record of a thread.
+             */
+            struct PendingRecord
+            {
+                /**
+                 * True if there is a pending record.
+                 */
+                bool m_active = false;
+
+                /**
+                 * The level.
+                 */
+                LogLevel m_level = LogLevel::Info;
+
+                /**
+                 * The tag.
+                 */
+                const char* m_tag = nullptr;
+
+                /**
+                 * The message so far.
+                 */
+                std::string m_message;
+            };
+
+            /**
+             * Get the pending record of this thread.
+             *
+             * \return the record
+             */
+            PendingRecord& getPendingRecord()
+            {
+                static thread_local PendingRecord pending;
+                return pending;
+            }
+
+            /**
+             * Format and write a record to the output stream.
+             *
+             * \param node the record
+             */
+            void writeRecord( const LogQueueNode& node )
+            {
+                if( node.m_tag )
+                {
+                    switch( node.m_level )
+                    {
+                        case LogLevel::Debug:
+                            std::cout << "DEBUG [";
+                            break;
+                        case LogLevel::Info:
+                            std::cout << "INFO  [";
+                            break;
+                        case LogLevel::Warning:
+                            std::cout << "WARN  [";
+                            break;
+                        case LogLevel::Error:
+                            std::cout << "ERROR [";
+                            break;
+                    }
+                    std::cout << node.m_tag << "]: ";
+                }
+                std::cout << node.m_message << '\n';
+            }
+
+            /**
+             * True if the background writer is used.
+             */
+            std::atomic< bool > logAsynchronous( true );
+
+            /**
+             * The queue and the writer thread. Producers push onto a lock-free stack. The writer takes the whole stack at once, reverses it to
+             * restore the order and writes it. The mutex is only used for sleeping and waking up the writer.
+             *
+             * The writer is never destroyed. Threads might still log while static objects are destroyed at exit. See \ref getLogWriter.
+             */
+            class LogWriter
+            {
+            public:
+                /**
+                 * Start the writer thread. It runs until the process ends.
+                 */
+                LogWriter()
+                {
+                    std::thread( &LogWriter::run, this ).detach();
+                }
+
+                /**
+                 * Queue a record. Lock-free.
+                 *
+                 * \param node the record. Ownership is transferred.
+                 */
+                void push( LogQueueNode* node )
+                {
+                    node->m_next = m_head.load( std::memory_order_relaxed );
+                    while( !m_head.compare_exchange_weak( node->m_next, node, std::memory_order_release, std::memory_order_relaxed ) )
+                    {
+                    }
+                    m_pushed.fetch_add( 1, std::memory_order_relaxed );
+                    m_wakeUp.notify_one();
+                }
+
+                /**
+                 * Wait until everything pushed so far is written.
+                 */
+                void flush()
+                {
+                    auto target = m_pushed.load();
+                    std::unique_lock< std::mutex > lock( m_mutex );
+                    m_wakeUp.notify_one();
+                    m_written.wait( lock, [ this, target ]()
+                                          {
+                                              return m_writtenCount >= target;
+                                          }
+                                  );
+                }
+
+            private:
+                /**
+                 * The writer loop.
+                 */
+                void run()
+                {
+                    std::unique_lock< std::mutex > lock( m_mutex );
+                    while( true )
+                    {
+                        // NOTE: the timeout handles notifications issued while the writer was busy writing.
+                        m_wakeUp.wait_for( lock, std::chrono::milliseconds( 100 ) );
+
+                        lock.unlock();
+                        auto count = drain();
+                        lock.lock();
+
+                        m_writtenCount += count;
+                        m_written.notify_all();
+                    }
+                }
+
+                /**
+                 * Write all queued records.
+                 *
+                 * \return the number of written records
+                 */
+                size_t drain()
+                {
+                    size_t count = 0;
+                    LogQueueNode* node = m_head.exchange( nullptr, std::memory_order_acquire );
+                    while( node )
+                    {
+                        // The stack has the newest record on top. Reverse.
+                        LogQueueNode* reversed = nullptr;
+                        while( node )
+                        {
+                            auto next = node->m_next;
+                            node->m_next = reversed;
+                            reversed = node;
+                            node = next;
+                        }
+
+                        while( reversed )
+                        {
+                            auto next = reversed->m_next;
+                            writeRecord( *reversed );
+                            delete reversed;
+                            reversed = next;
+                            ++count;
+                        }
+                        std::cout.flush();
+
+                        node = m_head.exchange( nullptr, std::memory_order_acquire );
+                    }
+                    return count;
+                }
+
+                /**
+                 * Top of the stack.
+                 */
+                std::atomic< LogQueueNode* > m_head{ nullptr };
+
+                /**
+                 * Number of records ever pushed.
+                 */
+                std::atomic< uint64_t > m_pushed{ 0 };
+
+                /**
+                 * Number of records written by the thread. Protected by m_mutex.
+                 */
+                uint64_t m_writtenCount = 0;
+
+                /**
+                 * Used for sleeping.
+                 */
+                std::mutex m_mutex;
+
+                /**
+                 * Wakes up the writer.
+                 */
+                std::condition_variable m_wakeUp;
+
+                /**
+                 * Notifies flush() about written records.
+                 */
+                std::condition_variable m_written;
+            };
+
+            /**
+             * Serializes synchronous writes.
+             */
+            std::mutex logSyncMutex;
+
+            /**
+             * Get the writer. Started on first use. Intentionally leaked: a static writer would be destroyed at exit while other threads and
+             * static objects still log. At exit, what is left gets written and records issued after this point are written directly.
+             *
+             * \return the writer
+             */
+            LogWriter& getLogWriter()
+            {
+                static LogWriter* writer = []()
+                {
+                    std::atexit( []()
+                                 {
+                                     logAsynchronous.store( false );
+                                     getLogWriter().flush();
+                                 }
+                               );
+                    return new LogWriter();  // NOLINT: never deleted on purpose
+                }();
+                return *writer;
+            }
+        }
+
+#ifdef DEBUG
+        std::atomic< int > Logger::m_level( static_cast< int >( LogLevel::Debug ) );
+#else
+        std::atomic< int > Logger::m_level( static_cast< int >( LogLevel::Info ) );
+#endif
+
+        void Logger::setLevel( LogLevel level )
+        {
+            m_level.store( static_cast< int >( level ) );
+        }
+
+        LogLevel Logger::getLevel()
+        {
+            return static_cast< LogLevel >( m_level.load() );
+        }
+
+        bool Logger::parseLevel( const std::string& name, LogLevel& level )
+        {
+            std::string lower( name );
+            std::transform( lower.begin(), lower.end(), lower.begin(), ::tolower );
+
+            if( lower == "debug" )
+            {
+                level = LogLevel::Debug;
+            }
+            else if( lower == "info" )
+            {
+                level = LogLevel::Info;
+            }
+            else if( ( lower == "warning" ) || ( lower == "warn" ) )
+            {
+                level = LogLevel::Warning;
+            }
+            else if( lower == "error" )
+            {
+                level = LogLevel::Error;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        void Logger::setAsynchronous( bool async )
+        {
+            if( !async )
+            {
+                flush();
+            }
+            logAsynchronous.store( async );
+        }
+
+        void Logger::write( LogLevel level, const char* tag, std::string&& message )
+        {
+            if( logAsynchronous.load( std::memory_order_relaxed ) )
+            {
+                getLogWriter().push( new LogQueueNode{ level, tag, std::move( message ), nullptr } );  // NOLINT: ownership moves to the writer
+            }
+            else
+            {
+                std::lock_guard< std::mutex > lock( logSyncMutex );
+                writeRecord( LogQueueNode{ level, tag, std::move( message ), nullptr } );
+                std::cout.flush();
+            }
+        }
+
+        void Logger::flush()
+        {
+            if( logAsynchronous.load() )
+            {
+                getLogWriter().flush();
+            }
+        }
+
+        bool Logger::hasPendingRecord()
+        {
+            return getPendingRecord().m_active;
+        }
+
+        LogRecord::LogRecord( LogLevel level, const char* tag ):
+            m_level( level ),
+            m_tag( tag )
+        {
+        }
+
+        LogRecord::LogRecord():
+            m_continuation( true )
+        {
+            auto& pending = getPendingRecord();
+            m_level = pending.m_level;
+            m_tag = pending.m_tag;
+        }
+
+        LogRecord::~LogRecord()
+        {
+            auto& pending = getPendingRecord();
+
+            // A new record while another one is unfinished? Write the unfinished one as is.
+            if( pending.m_active && !m_continuation )
+            {
+                pending.m_active = false;
+                Logger::write( pending.m_level, pending.m_tag, std::move( pending.m_message ) );
+                pending.m_message = std::string();
+            }
+
+            if( !pending.m_active )
+            {
+                pending.m_active = true;
+                pending.m_level = m_level;
+                pending.m_tag = m_tag;
+                pending.m_message.clear();
+            }
+            pending.m_message += m_stream.str();
+
+            if( m_finished )
+            {
+                pending.m_active = false;
+                Logger::write( pending.m_level, pending.m_tag, std::move( pending.m_message ) );
+                pending.m_message = std::string();
+            }
+        }
+    }
+}
+
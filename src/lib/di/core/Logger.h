@@ -30,42 +30,256 @@
 #ifndef DI_LOGGER_H
 #define DI_LOGGER_H
 
-#include <iostream>
-#include <iomanip>
+#include <atomic>
+#include <sstream>
+#include <string>
 
-// This file contains the preprocessor based logger. This is a rather simple logger, but as it uses a simple ostream interface, it can be replaced
-// later without the need for changes in the code.
+// This file contains the preprocessor based logger. It uses a simple ostream interface:
+//
+//   LogD << "Loaded " << n << " vertices." << LogEnd;
+//
+// Records below the compile-time level (DI_LOG_LEVEL) are removed by the compiler. Records below the runtime level (Logger::setLevel) are
+// skipped before anything gets formatted. Accepted records are handed to a background thread which writes them to std::cout.
 
-#ifndef LogStream
-    #define LogStream std::cout << std::resetiosflags( std::ios_base::basefield | std::ios_base::floatfield | std::ios_base::adjustfield )
+// Compile-time level. 0 = debug, 1 = info, 2 = warnings, 3 = errors only.
+#ifndef DI_LOG_LEVEL
+    #define DI_LOG_LEVEL 0
 #endif
 
+namespace di
+{
+    namespace core
+    {
+        /**
+         * The severity of a log record.
+         */
+        enum class LogLevel: int
+        {
+            Debug = 0,
+            Info = 1,
+            Warning = 2,
+            Error = 3
+        };
+
+        /**
+         * The logging backend. Records get queued without locking and are written by a background thread.
+         */
+        class Logger
+        {
+        public:
+            /**
+             * Check whether records of the given level get logged. This is evaluated before a record gets formatted.
+             *
+             * \param level the level
+             *
+             * \return true if enabled
+             */
+            static bool isEnabled( LogLevel level )
+            {
+                return static_cast< int >( level ) >= m_level.load( std::memory_order_relaxed );
+            }
+
+            /**
+             * Set the minimum level of records to log. Defaults to LogLevel::Debug in debug builds and LogLevel::Info otherwise.
+             *
+             * \param level the level
+             */
+            static void setLevel( LogLevel level );
+
+            /**
+             * Get the minimum level of records to log.
+             *
+             * \return the level
+             */
+            static LogLevel getLevel();
+
+            /**
+             * Parse a level name like "debug", "info", "warning" or "error".
+             *
+             * \param name the name. Case-insensitive.
+             * \param level the parsed level. Untouched if the name is unknown.
+             *
+             * \return true if the name was valid.
+             */
+            static bool parseLevel( const std::string& name, LogLevel& level );
+
+            /**
+             * Enable or disable the background writer. If disabled, records are written directly by the logging thread. Enabled by default.
+             *
+             * \param async true to use the background writer
+             */
+            static void setAsynchronous( bool async );
+
+            /**
+             * Queue a finished record for writing.
+             *
+             * \param level the level of the record
+             * \param tag the tag of the record. Can be nullptr for records without prefix.
+             * \param message the message
+             */
+            static void write( LogLevel level, const char* tag, std::string&& message );
+
+            /**
+             * Block until all records queued so far are written.
+             */
+            static void flush();
+
+            /**
+             * Check whether the calling thread has an unfinished record (a record without LogEnd). LogContinue appends to it.
+             *
+             * \return true if there is a record to continue.
+             */
+            static bool hasPendingRecord();
+
+        private:
+            /**
+             * The runtime level.
+             */
+            static std::atomic< int > m_level;
+        };
+
+        /**
+         * Marks the end of a record. Use LogEnd.
+         */
+        struct LogRecordEnd
+        {
+        };
+
+        /**
+         * Collects the parts of a single record. A record without LogRecordEnd is kept as pending record of the thread and can be continued using
+         * LogContinue.
+         */
+        class LogRecord
+        {
+        public:
+            /**
+             * Start a new record.
+             *
+             * \param level the level
+             * \param tag the tag. Has to be a string with static lifetime.
+             */
+            LogRecord( LogLevel level, const char* tag );
+
+            /**
+             * Continue the pending record of this thread.
+             */
+            LogRecord();
+
+            /**
+             * Hand the record to the Logger or keep it as pending record.
+             */
+            ~LogRecord();
+
+            /**
+             * Append something to the record.
+             *
+             * \tparam T the type. Needs to provide the << operator.
+             * \param value the value to append
+             *
+             * \return this record
+             */
+            template< typename T >
+            LogRecord& operator<<( const T& value )
+            {
+                m_stream << value;
+                return *this;
+            }
+
+            /**
+             * Finish the record.
+             *
+             * \return this record
+             */
+            LogRecord& operator<<( const LogRecordEnd& /* end */ )
+            {
+                m_finished = true;
+                return *this;
+            }
+
+        private:
+            /**
+             * Non-copyable.
+             */
+            LogRecord( const LogRecord& ) = delete;
+
+            /**
+             * Non-copyable.
+             */
+            LogRecord& operator=( const LogRecord& ) = delete;
+
+            /**
+             * The message so far.
+             */
+            std::ostringstream m_stream;
+
+            /**
+             * Level of this record.
+             */
+            LogLevel m_level = LogLevel::Info;
+
+            /**
+             * Tag of this record.
+             */
+            const char* m_tag = nullptr;
+
+            /**
+             * True if LogEnd was appended.
+             */
+            bool m_finished = false;
+
+            /**
+             * True if this record continues the pending record.
+             */
+            bool m_continuation = false;
+        };
+    }
+}
+
+// NOTE: the single-pass "for" ensures that nothing right of the macro gets evaluated if the level is disabled. Unlike an "if", it cannot take
+// over an "else" that follows the log statement.
+#define DI_LOG_RECORD( level ) \
+    for( bool diLogEnabled = di::core::Logger::isEnabled( level ); diLogEnabled; diLogEnabled = false ) \
+        di::core::LogRecord( level, LogTag )    // NOLINT: no braces on purpose
+
+#define DI_LOG_DISABLED \
+    for( ; false; ) di::core::LogRecord( di::core::LogLevel::Debug, LogTag )    // NOLINT: no braces on purpose
+
 #ifndef LogEnd
-    #define LogEnd std::endl;
+    #define LogEnd di::core::LogRecordEnd();
 #endif
 
 #ifndef LogContinue
-    #define LogContinue LogStream
+    #define LogContinue \
+        for( bool diLogPending = di::core::Logger::hasPendingRecord(); diLogPending; diLogPending = false ) \
+            di::core::LogRecord()    // NOLINT: no braces on purpose
 #endif
 
 #ifndef LogD
-    #define LogD LogStream << "DEBUG [" << LogTag << "]: "
+    #if DI_LOG_LEVEL <= 0
+        #define LogD DI_LOG_RECORD( di::core::LogLevel::Debug )
+    #else
+        #define LogD DI_LOG_DISABLED
+    #endif
 #endif
 
 #ifndef LogI
-    #define LogI LogStream << "INFO  [" << LogTag << "]: "
+    #if DI_LOG_LEVEL <= 1
+        #define LogI DI_LOG_RECORD( di::core::LogLevel::Info )
+    #else
+        #define LogI DI_LOG_DISABLED
+    #endif
 #endif
 
 #ifndef LogW
-    #define LogW LogStream << "WARN  [" << LogTag << "]: "
+    #if DI_LOG_LEVEL <= 2
+        #define LogW DI_LOG_RECORD( di::core::LogLevel::Warning )
+    #else
+        #define LogW DI_LOG_DISABLED
+    #endif
 #endif
 
 #ifndef LogE
-    #define LogE LogStream << "ERROR [" << LogTag << "]: "
-#endif
-
-#ifndef LogGL
-    #define LogGL LogStream
+    #define LogE DI_LOG_RECORD( di::core::LogLevel::Error )
 #endif
 
 #endif  // DI_LOGGER_H
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_PARALLELFOR_H
+#define DI_PARALLELFOR_H
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <di/core/AllocationTracker.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Split the index range [begin, end) into contiguous blocks and call the given function for each block in its own thread. The calling
+         * thread processes the last block. The function must only write to data associated with its own block. The results are then
+         * independent of the number of threads. Allocations of the worker threads are attributed to the calling thread, see
+         * \ref AllocationTracker. If the function throws, all blocks are waited for and the first exception is rethrown in the calling thread.
+         *
+         * \code
+         * parallelFor( 0, values.size(),
+         *     [ & ]( size_t from, size_t to )
+         *     {
+         *         for( size_t i = from; i < to; ++i )
+         *         {
+         *             values[ i ] = compute( i );
+         *         }
+         *     }
+         * );
+         * \endcode
+         *
+         * \tparam FunctionType a callable taking the block's first and one-past-last index.
+         * \param begin the first index
+         * \param end one past the last index
+         * \param function the function to call for each block
+         * \param minBlockSize do not split into blocks smaller than this. Avoids creating threads for tiny ranges.
+         */
+        template< typename FunctionType >
+        void parallelFor( size_t begin, size_t end, FunctionType function, size_t minBlockSize = 1024 )
+        {
+            if( end <= begin )
+            {
+                return;
+            }
+
+            size_t count = end - begin;
+            size_t numThreads = std::max< size_t >( 1, std::thread::hardware_concurrency() );
+            numThreads = std::max< size_t >( 1, std::min( numThreads, count / std::max< size_t >( 1, minBlockSize ) ) );
+            size_t blockSize = ( count + numThreads - 1 ) / numThreads;
+
+            std::vector< std::thread > threads;
+            AllocationTracker::Counters none = { 0, 0 };
+            std::vector< AllocationTracker::Counters > allocations( numThreads, none );
+
+            // An exception leaving a thread terminates the program. Keep the first one and rethrow it here.
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            auto call = [ &function, &error, &errorMutex ]( size_t from, size_t to )
+            {
+                try
+                {
+                    function( from, to );
+                }
+                catch( ... )
+                {
+                    std::lock_guard< std::mutex > lock( errorMutex );
+                    if( !error )
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            };
+
+            threads.reserve( numThreads - 1 );
+            for( size_t from = begin; from < end; from += blockSize )
+            {
+                size_t to = std::min( end, from + blockSize );
+                if( to == end )
+                {
+                    call( from, to );
+                }
+                else
+                {
+                    size_t index = threads.size();
+                    threads.push_back( std::thread(
+                        [ &call, &allocations, index, from, to ]()
+                        {
+                            call( from, to );
+                            allocations[ index ] = AllocationTracker::getThreadCounters();
+                        }
+                    ) );
+                }
+            }
+
+            for( auto& thread : threads )
+            {
+                thread.join();
+            }
+
+            for( const auto& workerAllocations : allocations )
+            {
+                AllocationTracker::addToThread( workerAllocations );
+            }
+
+            if( error )
+            {
+                std::rethrow_exception( error );
+            }
+        }
+    }
+}
+
+#endif  // DI_PARALLELFOR_H
+
@@ -25,6 +25,7 @@
 #ifndef DI_PARAMETER_H
 #define DI_PARAMETER_H
 
+#include <functional>
 #include <string>
 #include <sstream>
 #include <ostream>
@@ -164,7 +165,7 @@ namespace di
 
             /**
              * Convert from string to target type, set the resulting value. Uses di::core::fromString. Accordingly, it might throw conversion
-             * exceptions.
+             * exceptions. Values equal to the current value are ignored and do not notify.
              *
              * \param source the string. Can be empty. Will be ignored in this case.
              */
@@ -316,6 +317,12 @@ namespace di
             }
             ValueType v;
             fromParameterString( source, v );
+
+            // Restoring a state should not cause updates if nothing changes. Compare the string representation. Not all types are comparable.
+            if( toParameterString( v ) == toString() )
+            {
+                return;
+            }
             set( v );
         }
     }
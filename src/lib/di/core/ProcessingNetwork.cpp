@@ -28,6 +28,8 @@
 
 #include <di/core/Reader.h>
 #include <di/core/ObserverCallback.h>
+#include <di/core/Trace.h>
+#include <di/core/data/DataSetBase.h>
 
 #include <di/commands/ReadFile.h>
 #include <di/commands/Callback.h>
@@ -137,6 +139,55 @@ namespace di
             return s;
         }
 
+        di::core::State ProcessingNetwork::getMemoryFootprint() const
+        {
+            // Avoid concurrent access:
+            std::lock_guard< std::mutex > lockAlgo( m_algorithmsMutex );
+            return getMemoryFootprintNoLock();
+        }
+
+        di::core::State ProcessingNetwork::getMemoryFootprintNoLock() const
+        {
+            State s;
+            MemoryFootprintParts networkParts;
+            for( auto algo : m_algorithms )
+            {
+                State algoState;
+                MemoryFootprintParts algoParts;
+
+                for( auto input : algo->getInputs() )
+                {
+                    auto dataSet = std::dynamic_pointer_cast< const DataSetBase >( input->getTransferable() );
+                    if( dataSet )
+                    {
+                        MemoryFootprintParts parts;
+                        dataSet->collectMemoryFootprint( parts );
+                        networkParts.insert( parts.begin(), parts.end() );
+                        algoState.set( "Inputs/" + input->getName(), DataSetBase::sumMemoryFootprint( parts ) );
+                    }
+                }
+
+                for( auto output : algo->getOutputs() )
+                {
+                    auto dataSet = std::dynamic_pointer_cast< const DataSetBase >( output->getTransferable() );
+                    if( dataSet )
+                    {
+                        MemoryFootprintParts parts;
+                        dataSet->collectMemoryFootprint( parts );
+                        networkParts.insert( parts.begin(), parts.end() );
+                        algoParts.insert( parts.begin(), parts.end() );
+                        algoState.set( "Outputs/" + output->getName(), DataSetBase::sumMemoryFootprint( parts ) );
+                    }
+                }
+
+                algoState.set( "Total", DataSetBase::sumMemoryFootprint( algoParts ) );
+                s.set( algo->getRuntimeName(), algoState );
+            }
+
+            s.set( "Total", DataSetBase::sumMemoryFootprint( networkParts ) );
+            return s;
+        }
+
         bool ProcessingNetwork::setState( const di::core::State& state )
         {
             LogD << "Restoring the processing network's parameter state." << LogEnd;
@@ -428,6 +479,7 @@ namespace di
                 if( reader )
                 {
                     // NOTE: exceptions get handled in CommandQueue
+                    TraceSpan span( LogTag, "Reader::load" );
                     readFileCmd->setResult( reader->load( fn ) );
                 }
                 else
@@ -479,7 +531,7 @@ namespace di
             if( runCmd )
             {
                 // Call the proper function. Keep in mind that this is a temporary solution. The will be done by a scheduler in the future.
-                runNetworkImpl();
+                runNetworkImpl( runCmd );
             }
 
             // Trigger callback?
@@ -494,6 +546,7 @@ namespace di
             if( queryStateCmd )
             {
                 queryStateCmd->setState( getState() );
+                queryStateCmd->setMemoryFootprint( getMemoryFootprint() );
             }
         }
 
@@ -603,7 +656,20 @@ namespace di
             return result;
         }
 
-        void ProcessingNetwork::runNetworkImpl()
+        SPtrVec< Algorithm > ProcessingNetwork::getRunOrder()
+        {
+            std::lock_guard< std::mutex > lockAlgo( m_algorithmsMutex );
+            std::lock_guard< std::mutex > lockCon( m_connectionsMutex );
+
+            SPtrVec< Algorithm > result;
+            for( auto layer : buildRunOrder() )
+            {
+                result.insert( result.end(), layer.first.begin(), layer.first.end() );
+            }
+            return result;
+        }
+
+        void ProcessingNetwork::runNetworkImpl( SPtr< Command > command )
         {
             // Avoid concurrent access:
             std::lock_guard< std::mutex > lockAlgo( m_algorithmsMutex );
@@ -641,7 +707,20 @@ namespace di
                              << " - " << *algo << " { Dirty: " << algo->isUpdateRequested() << ", Active: " << algo->isActive()
                              << ", Data: " << dataPropagated[ algo ] << " }"
                              << LogEnd;
+
+                        // Forward the progress of the algorithm to the command while running.
+                        if( command )
+                        {
+                            auto name = algo->getRuntimeName();
+                            algo->getProgress().setCallback( [ command, name ]( const Progress& progress )
+                                {
+                                    command->progress( name + ": " + progress.getStage(), progress.getFraction(),
+                                                       progress.getEstimatedRemainingTime() );
+                                }
+                            );
+                        }
                         algo->run();
+                        algo->getProgress().setCallback( nullptr );
                     }
                     else
                     {
@@ -661,6 +740,15 @@ namespace di
                     dataPropagated[ m_connections[ con ].second ] = dataPropagated[ m_connections[ con ].second ] || result;
                 }
             }
+
+            // Report who holds which amount of memory now
+            auto memory = getMemoryFootprintNoLock();
+            LogI << "Memory held by the network: " << formatMemorySize( memory.getValue< size_t >( "Total", 0 ) ) << LogEnd;
+            for( auto algo : m_algorithms )
+            {
+                LogD << "    - " << algo->getRuntimeName() << ": "
+                     << formatMemorySize( memory.getState( algo->getRuntimeName() ).getValue< size_t >( "Total", 0 ) ) << LogEnd;
+            }
         }
     }
 }
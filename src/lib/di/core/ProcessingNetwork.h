@@ -251,6 +251,14 @@ namespace di
              */
             virtual SPtr< di::commands::Callback > callback( std::function< void() > callback );
 
+            /**
+             * Get the algorithms in the order they are run. Each algorithm only depends on algorithms before it. Use it to find out which
+             * algorithms are upstream of others.
+             *
+             * \return the algorithms in execution order.
+             */
+            SPtrVec< Algorithm > getRunOrder();
+
             /**
              * Is an update requested? Convenience method to check all algorithms at once.
              *
@@ -296,6 +304,15 @@ namespace di
              */
             di::core::State getState() const;
 
+            /**
+             * Get the memory held by the datasets in the network. For each algorithm (by runtime name), the state contains the bytes of each
+             * connected dataset in "Inputs" and "Outputs", and the "Total" of all outputs. Data shared between connectors is counted once in each
+             * total. The network-wide sum is stored as "Total" in the returned state.
+             *
+             * \return the state. All values are in bytes.
+             */
+            di::core::State getMemoryFootprint() const;
+
         protected:
             /**
              * Process the specified command. Use Command::handle to mark the command as being handled.
@@ -360,8 +377,17 @@ namespace di
 
             /**
              * Re-run the whole network.
+             *
+             * \param command the command that caused the run. The progress of each algorithm gets reported to it. Can be nullptr.
+             */
+            virtual void runNetworkImpl( SPtr< Command > command = nullptr );
+
+            /**
+             * \note does not lock!
+             *
+             * \copydoc getMemoryFootprint
              */
-            virtual void runNetworkImpl();
+            di::core::State getMemoryFootprintNoLock() const;
 
             /**
              * \note does not lock!
@@ -0,0 +1,159 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "Progress.h"
+
+namespace di
+{
+    namespace core
+    {
+        Progress::Progress():
+            m_done( 0 ),
+            m_total( 0 ),
+            m_nextCheck( 0 )
+        {
+        }
+
+        Progress::~Progress()
+        {
+        }
+
+        void Progress::begin( const std::string& stage, size_t total )
+        {
+            Callback callback;
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+                m_stage = stage;
+                m_stageStart = std::chrono::steady_clock::now();
+                m_lastReport = m_stageStart;
+                m_done.store( 0 );
+                m_total.store( total );
+                // Check the clock about every 0.1% of the work. Unknown totals check every 1024 steps.
+                m_nextCheck.store( total ? std::max< size_t >( 1, total / 1000 ) : 1024 );
+                callback = m_callback;
+            }
+
+            if( callback )
+            {
+                callback( *this );
+            }
+        }
+
+        void Progress::end()
+        {
+            Callback callback;
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+                m_done.store( std::max( m_done.load(), m_total.load() ) );
+                m_nextCheck.store( std::numeric_limits< size_t >::max() );
+                callback = m_callback;
+            }
+
+            if( callback )
+            {
+                callback( *this );
+            }
+        }
+
+        void Progress::check( size_t done )
+        {
+            Callback callback;
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+                auto total = m_total.load();
+                m_nextCheck.store( done + ( total ? std::max< size_t >( 1, total / 1000 ) : 1024 ) );
+
+                auto now = std::chrono::steady_clock::now();
+                if( !m_callback || ( now - m_lastReport < m_reportInterval ) )
+                {
+                    return;
+                }
+                m_lastReport = now;
+                callback = m_callback;
+            }
+
+            callback( *this );
+        }
+
+        std::string Progress::getStage() const
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            return m_stage;
+        }
+
+        size_t Progress::getDone() const
+        {
+            return m_done.load();
+        }
+
+        size_t Progress::getTotal() const
+        {
+            return m_total.load();
+        }
+
+        double Progress::getFraction() const
+        {
+            auto total = m_total.load();
+            if( !total )
+            {
+                return 0.0;
+            }
+            return std::min( 1.0, static_cast< double >( m_done.load() ) / static_cast< double >( total ) );
+        }
+
+        double Progress::getEstimatedRemainingTime() const
+        {
+            auto fraction = getFraction();
+            if( fraction <= 0.0 )
+            {
+                return -1.0;
+            }
+
+            std::chrono::steady_clock::time_point start;
+            {
+                std::lock_guard< std::mutex > lock( m_mutex );
+                start = m_stageStart;
+            }
+            std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+            return elapsed.count() * ( 1.0 - fraction ) / fraction;
+        }
+
+        void Progress::setCallback( Callback callback )
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_callback = callback;
+        }
+
+        void Progress::setReportInterval( std::chrono::milliseconds interval )
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_reportInterval = interval;
+        }
+    }
+}
+
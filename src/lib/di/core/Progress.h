@@ -0,0 +1,205 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_PROGRESS_H
+#define DI_PROGRESS_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Progress of a long running operation, split into stages. Advancing the progress is cheap (two relaxed atomic operations), so it can be
+         * done from inner loops, ideally not more often than every few hundred iterations. A callback is called at most every report interval
+         * from the advancing thread.
+         *
+         * \code
+         * getProgress().begin( "Marching regions", numVertices );
+         * for( ... )
+         * {
+         *     ...
+         *     getProgress().advance();
+         * }
+         * getProgress().end();
+         * \endcode
+         */
+        class Progress
+        {
+        public:
+            /**
+             * Called with the progress whenever it should be reported.
+             */
+            typedef std::function< void( const Progress& ) > Callback;
+
+            /**
+             * Create an empty progress.
+             */
+            Progress();
+
+            /**
+             * Destructor.
+             */
+            virtual ~Progress();
+
+            /**
+             * Begin a new stage. Resets the counter.
+             *
+             * \param stage a human readable stage name
+             * \param total the number of steps in this stage. 0 if unknown.
+             */
+            void begin( const std::string& stage, size_t total = 0 );
+
+            /**
+             * Advance the progress.
+             *
+             * \param steps the number of steps done since the last call.
+             */
+            void advance( size_t steps = 1 )
+            {
+                auto done = m_done.fetch_add( steps, std::memory_order_relaxed ) + steps;
+                if( done >= m_nextCheck.load( std::memory_order_relaxed ) )
+                {
+                    check( done );
+                }
+            }
+
+            /**
+             * Finish the current stage. Reports the progress one last time.
+             */
+            void end();
+
+            /**
+             * Get the name of the current stage.
+             *
+             * \return the stage
+             */
+            std::string getStage() const;
+
+            /**
+             * Number of steps done in this stage.
+             *
+             * \return the steps
+             */
+            size_t getDone() const;
+
+            /**
+             * Number of steps in this stage. 0 if unknown.
+             *
+             * \return the steps
+             */
+            size_t getTotal() const;
+
+            /**
+             * The progress in [0,1] of the current stage. 0 if the total is unknown.
+             *
+             * \return the fraction
+             */
+            double getFraction() const;
+
+            /**
+             * Estimate the remaining time of the current stage, assuming a constant rate.
+             *
+             * \return the time in seconds. Negative if unknown.
+             */
+            double getEstimatedRemainingTime() const;
+
+            /**
+             * Set the callback. Set nullptr to remove.
+             *
+             * \param callback the callback
+             */
+            void setCallback( Callback callback );
+
+            /**
+             * Set the minimum time between two reports.
+             *
+             * \param interval the interval
+             */
+            void setReportInterval( std::chrono::milliseconds interval );
+
+        protected:
+        private:
+            /**
+             * Check whether a report is due and report.
+             *
+             * \param done the current step count
+             */
+            void check( size_t done );
+
+            /**
+             * The steps done.
+             */
+            std::atomic< size_t > m_done;
+
+            /**
+             * The total number of steps.
+             */
+            std::atomic< size_t > m_total;
+
+            /**
+             * The step count at which to check the clock again. Avoids reading the clock on each advance.
+             */
+            std::atomic< size_t > m_nextCheck;
+
+            /**
+             * Start of the current stage.
+             */
+            std::chrono::steady_clock::time_point m_stageStart;
+
+            /**
+             * Time of the last report.
+             */
+            std::chrono::steady_clock::time_point m_lastReport;
+
+            /**
+             * Minimum time between reports.
+             */
+            std::chrono::milliseconds m_reportInterval = std::chrono::milliseconds( 250 );
+
+            /**
+             * The stage name.
+             */
+            std::string m_stage;
+
+            /**
+             * The callback.
+             */
+            Callback m_callback;
+
+            /**
+             * Protects stage, times and callback.
+             */
+            mutable std::mutex m_mutex;
+        };
+    }
+}
+
+#endif  // DI_PROGRESS_H
+
@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "RollingStatistics.h"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * Find the histogram bucket of a sample.
+             *
+             * \param value the sample
+             *
+             * \return the bucket index
+             */
+            size_t getBucket( double value )
+            {
+                if( !( value > 0.0 ) )
+                {
+                    return 0;
+                }
+                auto bucket = static_cast< int >( std::floor( std::log2( value ) ) ) + 5;
+                return static_cast< size_t >( std::max( 0, std::min( bucket, static_cast< int >( RollingStatistics::NumBuckets ) - 1 ) ) );
+            }
+
+            /**
+             * Get a percentile of sorted samples, using the nearest rank.
+             *
+             * \param sorted the sorted samples. Must not be empty.
+             * \param percent the percentile in [0, 100]
+             *
+             * \return the value
+             */
+            double getPercentile( const std::vector< double >& sorted, double percent )
+            {
+                auto rank = static_cast< size_t >( std::ceil( percent / 100.0 * static_cast< double >( sorted.size() ) ) );
+                return sorted[ std::min( sorted.size() - 1, std::max< size_t >( rank, 1 ) - 1 ) ];
+            }
+        }
+
+        void RollingStatistics::add( double value )
+        {
+            if( m_window.size() < WindowSize )
+            {
+                m_window.push_back( value );
+            }
+            else
+            {
+                m_window[ m_next ] = value;
+                m_next = ( m_next + 1 ) % WindowSize;
+            }
+
+            m_min = m_count ? std::min( m_min, value ) : value;
+            m_max = m_count ? std::max( m_max, value ) : value;
+            m_sum += value;
+            m_count++;
+            m_histogram[ getBucket( value ) ]++;
+        }
+
+        RollingStatistics::Summary RollingStatistics::getSummary( const std::string& name ) const
+        {
+            Summary summary;
+            summary.m_name = name;
+            summary.m_count = m_count;
+            summary.m_min = m_min;
+            summary.m_max = m_max;
+            summary.m_mean = m_count ? m_sum / static_cast< double >( m_count ) : 0.0;
+            summary.m_histogram = m_histogram;
+
+            if( !m_window.empty() )
+            {
+                auto sorted = m_window;
+                std::sort( sorted.begin(), sorted.end() );
+                summary.m_p50 = getPercentile( sorted, 50.0 );
+                summary.m_p90 = getPercentile( sorted, 90.0 );
+                summary.m_p95 = getPercentile( sorted, 95.0 );
+                summary.m_p99 = getPercentile( sorted, 99.0 );
+            }
+            return summary;
+        }
+
+        std::vector< double > RollingStatistics::getRecent() const
+        {
+            // Unroll the ring buffer
+            std::vector< double > result( m_window.begin() + m_next, m_window.end() );
+            result.insert( result.end(), m_window.begin(), m_window.begin() + m_next );
+            return result;
+        }
+
+        void RollingStatistics::clear()
+        {
+            *this = RollingStatistics();
+        }
+
+        double RollingStatistics::getBucketLowerBound( size_t bucket )
+        {
+            return ( bucket == 0 ) ? 0.0 : std::ldexp( 1.0, static_cast< int >( bucket ) - 5 );
+        }
+    }
+}
+
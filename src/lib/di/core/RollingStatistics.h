@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_ROLLINGSTATISTICS_H
+#define DI_ROLLINGSTATISTICS_H
+
+#include <string>
+#include <vector>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Aggregates a series of samples, like timings, into mean, extremes, a histogram and percentiles. The percentiles are calculated on a
+         * window of the most recent samples, everything else on all samples. Not thread-safe.
+         */
+        class RollingStatistics
+        {
+        public:
+            /**
+             * Number of most recent samples kept. The percentiles are calculated on these.
+             */
+            static const size_t WindowSize = 512;
+
+            /**
+             * Number of histogram buckets. Bucket i counts the samples in [2^(i-5), 2^(i-4)). The first bucket also counts all smaller samples,
+             * the last all larger samples. For milliseconds, this covers 1/32 ms to 4 s.
+             */
+            static const size_t NumBuckets = 18;
+
+            /**
+             * The aggregated statistics.
+             */
+            struct Summary
+            {
+                /**
+                 * The name of the series.
+                 */
+                std::string m_name;
+
+                /**
+                 * Number of samples since the last clear.
+                 */
+                size_t m_count = 0;
+
+                /**
+                 * Smallest sample since the last clear.
+                 */
+                double m_min = 0.0;
+
+                /**
+                 * Largest sample since the last clear.
+                 */
+                double m_max = 0.0;
+
+                /**
+                 * Mean of all samples since the last clear.
+                 */
+                double m_mean = 0.0;
+
+                /**
+                 * Median of the recent samples.
+                 */
+                double m_p50 = 0.0;
+
+                /**
+                 * 90th percentile of the recent samples.
+                 */
+                double m_p90 = 0.0;
+
+                /**
+                 * 95th percentile of the recent samples.
+                 */
+                double m_p95 = 0.0;
+
+                /**
+                 * 99th percentile of the recent samples.
+                 */
+                double m_p99 = 0.0;
+
+                /**
+                 * Histogram of all samples since the last clear. See \ref NumBuckets and \ref getBucketLowerBound.
+                 */
+                std::vector< size_t > m_histogram = std::vector< size_t >( NumBuckets, 0 );
+            };
+
+            /**
+             * Add a sample.
+             *
+             * \param value the sample
+             */
+            void add( double value );
+
+            /**
+             * Calculate the statistics.
+             *
+             * \param name the name to put into the summary
+             *
+             * \return the summary.
+             */
+            Summary getSummary( const std::string& name = "" ) const;
+
+            /**
+             * Get the most recent samples, oldest first.
+             *
+             * \return the samples. At most \ref WindowSize.
+             */
+            std::vector< double > getRecent() const;
+
+            /**
+             * Remove all samples.
+             */
+            void clear();
+
+            /**
+             * The lower bound of the given histogram bucket.
+             *
+             * \param bucket the bucket index
+             *
+             * \return the lower bound. 0 for the first bucket.
+             */
+            static double getBucketLowerBound( size_t bucket );
+
+        protected:
+        private:
+            /**
+             * Ring buffer of the recent samples.
+             */
+            std::vector< double > m_window;
+
+            /**
+             * Next write position in the ring buffer, once it is full.
+             */
+            size_t m_next = 0;
+
+            /**
+             * Number of samples.
+             */
+            size_t m_count = 0;
+
+            /**
+             * Smallest sample.
+             */
+            double m_min = 0.0;
+
+            /**
+             * Largest sample.
+             */
+            double m_max = 0.0;
+
+            /**
+             * Sum of all samples.
+             */
+            double m_sum = 0.0;
+
+            /**
+             * The histogram.
+             */
+            std::vector< size_t > m_histogram = std::vector< size_t >( NumBuckets, 0 );
+        };
+    }
+}
+
+#endif  // DI_ROLLINGSTATISTICS_H
+
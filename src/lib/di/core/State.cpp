@@ -170,12 +170,15 @@ namespace di
         State State::fromFile( const std::string& filename )
         {
             LogD << "Loading state file \"" << filename << "\"." << LogEnd;
-            auto file = core::readTextFile( filename );
+            return fromString( core::readTextFile( filename ) );
+        }
 
+        State State::fromString( const std::string& text )
+        {
             di::core::State s;
 
             // each line
-            auto items = core::split( file );
+            auto items = core::split( text );
             for( auto line : items )
             {
                 if( line.empty() )
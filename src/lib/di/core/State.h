@@ -242,6 +242,15 @@ namespace di
              */
             static State fromFile( const std::string& filename );
 
+            /**
+             * Parse a state in the format written by \ref toString. Forgiving like \ref fromFile.
+             *
+             * \param text the state as text
+             *
+             * \return the state
+             */
+            static State fromString( const std::string& text );
+
         protected:
         private:
             /**
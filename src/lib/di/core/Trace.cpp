@@ -0,0 +1,389 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Trace.h"
+
+#include <di/core/Logger.h>
+#define LogTag "core/Trace"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * A single recorded span.
+             */
+            struct TraceEvent
+            {
+                /**
+                 * Name, zero-terminated, possibly truncated.
+                 */
+                char m_name[ Trace::MaxNameLength ];
+
+                /**
+                 * Category. Static lifetime.
+                 */
+                const char* m_category;
+
+                /**
+                 * Begin in ns.
+                 */
+                uint64_t m_begin;
+
+                /**
+                 * End in ns.
+                 */
+                uint64_t m_end;
+
+                /**
+                 * Optional argument name. Static lifetime.
+                 */
+                const char* m_argName;
+
+                /**
+                 * Argument value.
+                 */
+                double m_argValue;
+
+                /**
+                 * Chrome trace phase. 'X' for spans, 'C' for counters.
+                 */
+                char m_phase;
+            };
+
+            /**
+             * The ring buffer of a thread. Only the owning thread writes. The exporter copies the last min( count, capacity ) entries. Both hold
+             * m_mutex while touching the events, so an export never sees a half-written event. The mutex is uncontended unless an export or
+             * clear is running.
+             */
+            struct TraceBuffer
+            {
+                /**
+                 * The events.
+                 */
+                std::vector< TraceEvent > m_events = std::vector< TraceEvent >( Trace::BufferCapacity );
+
+                /**
+                 * Protects m_events and m_count against the exporter and clear().
+                 */
+                std::mutex m_mutex;
+
+                /**
+                 * Number of events ever written. The next write goes to m_count % capacity.
+                 */
+                uint64_t m_count = 0;
+
+                /**
+                 * Thread id as shown in the trace.
+                 */
+                size_t m_threadID = 0;
+
+                /**
+                 * Optional thread name.
+                 */
+                std::string m_threadName;
+            };
+
+            /**
+             * All buffers ever created. Buffers outlive their threads to allow exporting after a thread ended.
+             */
+            struct TraceRegistry
+            {
+                /**
+                 * Protects the list and the thread names.
+                 */
+                std::mutex m_mutex;
+
+                /**
+                 * The buffers.
+                 */
+                std::vector< std::shared_ptr< TraceBuffer > > m_buffers;
+
+                /**
+                 * Reference point of the trace clock.
+                 */
+                std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+            };
+
+            /**
+             * Get the registry. Constructed on first use.
+             *
+             * \return the registry
+             */
+            TraceRegistry& getRegistry()
+            {
+                static TraceRegistry registry;
+                return registry;
+            }
+
+            /**
+             * Get the buffer of the calling thread. Creates and registers it on first use.
+             *
+             * \return the buffer
+             */
+            TraceBuffer& getThreadBuffer()
+            {
+                static thread_local std::shared_ptr< TraceBuffer > buffer;
+                if( !buffer )
+                {
+                    auto& registry = getRegistry();
+                    std::lock_guard< std::mutex > lock( registry.m_mutex );
+                    buffer = std::make_shared< TraceBuffer >();
+                    buffer->m_threadID = registry.m_buffers.size() + 1;
+                    registry.m_buffers.push_back( buffer );
+                }
+                return *buffer;
+            }
+
+            /**
+             * Write a string as JSON string literal.
+             *
+             * \param os the stream
+             * \param str the string
+             */
+            void writeJSONString( std::ostream& os, const char* str )
+            {
+                os << '"';
+                for( const char* c = str; *c; ++c )
+                {
+                    switch( *c )
+                    {
+                        case '"':
+                            os << "\\\"";
+                            break;
+                        case '\\':
+                            os << "\\\\";
+                            break;
+                        case '\n':
+                            os << "\\n";
+                            break;
+                        default:
+                            if( static_cast< unsigned char >( *c ) >= 0x20 )
+                            {
+                                os << *c;
+                            }
+                    }
+                }
+                os << '"';
+            }
+        }
+
+        std::atomic< bool > Trace::m_enabled( false );
+
+        void Trace::setEnabled( bool enable )
+        {
+            // Ensure the clock reference exists before the first span.
+            getRegistry();
+            m_enabled.store( enable );
+            LogD << "Tracing " << ( enable ? "enabled." : "disabled." ) << LogEnd;
+        }
+
+        bool Trace::isEnabled()
+        {
+            return m_enabled.load( std::memory_order_relaxed );
+        }
+
+        void Trace::setThreadName( const std::string& name )
+        {
+            auto& buffer = getThreadBuffer();
+            std::lock_guard< std::mutex > lock( getRegistry().m_mutex );
+            buffer.m_threadName = name;
+        }
+
+        uint64_t Trace::now()
+        {
+            return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - getRegistry().m_epoch ).count();
+        }
+
+        void Trace::record( const char* category, const char* name, uint64_t begin, uint64_t end, const char* argName, double argValue )
+        {
+            auto& buffer = getThreadBuffer();
+            std::lock_guard< std::mutex > lock( buffer.m_mutex );
+            auto& event = buffer.m_events[ buffer.m_count % BufferCapacity ];
+
+            std::strncpy( event.m_name, name, MaxNameLength - 1 );
+            event.m_name[ MaxNameLength - 1 ] = 0;
+            event.m_category = category;
+            event.m_begin = begin;
+            event.m_end = end;
+            event.m_argName = argName;
+            event.m_argValue = argValue;
+            event.m_phase = 'X';
+
+            ++buffer.m_count;
+        }
+
+        void Trace::counter( const char* category, const char* name, double value )
+        {
+            if( !isEnabled() )
+            {
+                return;
+            }
+
+            auto& buffer = getThreadBuffer();
+            std::lock_guard< std::mutex > lock( buffer.m_mutex );
+            auto& event = buffer.m_events[ buffer.m_count % BufferCapacity ];
+
+            std::strncpy( event.m_name, name, MaxNameLength - 1 );
+            event.m_name[ MaxNameLength - 1 ] = 0;
+            event.m_category = category;
+            event.m_begin = now();
+            event.m_end = event.m_begin;
+            event.m_argName = "value";
+            event.m_argValue = value;
+            event.m_phase = 'C';
+
+            ++buffer.m_count;
+        }
+
+        void Trace::writeChromeTrace( std::ostream& os )
+        {
+            auto& registry = getRegistry();
+            std::lock_guard< std::mutex > lock( registry.m_mutex );
+
+            os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+            bool first = true;
+            for( auto buffer : registry.m_buffers )
+            {
+                // Thread name as metadata event
+                if( !buffer->m_threadName.empty() )
+                {
+                    os << ( first ? "" : ",\n" ) << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->m_threadID
+                       << ",\"args\":{\"name\":";
+                    writeJSONString( os, buffer->m_threadName.c_str() );
+                    os << "}}";
+                    first = false;
+                }
+
+                // The spans. If the ring wrapped, only the newest BufferCapacity spans are available. Copy them, so the thread only waits for
+                // the copy and not for the stream.
+                std::vector< TraceEvent > events;
+                {
+                    std::lock_guard< std::mutex > bufferLock( buffer->m_mutex );
+                    uint64_t start = ( buffer->m_count > BufferCapacity ) ? buffer->m_count - BufferCapacity : 0;
+                    events.reserve( buffer->m_count - start );
+                    for( uint64_t i = start; i < buffer->m_count; ++i )
+                    {
+                        events.push_back( buffer->m_events[ i % BufferCapacity ] );
+                    }
+                }
+
+                for( auto event = events.begin(); event != events.end(); ++event )
+                {
+                    os << ( first ? "" : ",\n" ) << "{\"ph\":\"" << event->m_phase << "\",\"pid\":1,\"tid\":" << buffer->m_threadID << ",\"name\":";
+                    writeJSONString( os, event->m_name );
+                    os << ",\"cat\":";
+                    writeJSONString( os, event->m_category ? event->m_category : "" );
+                    os << ",\"ts\":" << static_cast< double >( event->m_begin ) / 1000.0;
+                    if( event->m_phase == 'X' )
+                    {
+                        os << ",\"dur\":" << static_cast< double >( event->m_end - event->m_begin ) / 1000.0;
+                    }
+                    if( event->m_argName )
+                    {
+                        os << ",\"args\":{";
+                        writeJSONString( os, event->m_argName );
+                        os << ":" << event->m_argValue << "}";
+                    }
+                    os << "}";
+                    first = false;
+                }
+            }
+            os << std::endl << "]}" << std::endl;
+        }
+
+        bool Trace::writeChromeTrace( const std::string& filename )
+        {
+            std::ofstream file( filename );
+            if( !file.is_open() )
+            {
+                LogE << "Could not open \"" << filename << "\" for writing the trace." << LogEnd;
+                return false;
+            }
+
+            file.precision( 15 );
+            writeChromeTrace( file );
+            LogI << "Wrote trace to \"" << filename << "\"." << LogEnd;
+            return file.good();
+        }
+
+        void Trace::clear()
+        {
+            auto& registry = getRegistry();
+            std::lock_guard< std::mutex > lock( registry.m_mutex );
+            for( auto buffer : registry.m_buffers )
+            {
+                std::lock_guard< std::mutex > bufferLock( buffer->m_mutex );
+                buffer->m_count = 0;
+            }
+        }
+
+        TraceSpan::TraceSpan( const char* category, const char* name ):
+            m_active( Trace::isEnabled() ),
+            m_category( category ),
+            m_name( name )
+        {
+            if( m_active )
+            {
+                m_begin = Trace::now();
+            }
+        }
+
+        TraceSpan::TraceSpan( const char* category, const std::string& name ):
+            m_active( Trace::isEnabled() ),
+            m_category( category )
+        {
+            if( m_active )
+            {
+                m_nameString = name;
+                m_begin = Trace::now();
+            }
+        }
+
+        TraceSpan::~TraceSpan()
+        {
+            if( m_active )
+            {
+                Trace::record( m_category, m_name ? m_name : m_nameString.c_str(), m_begin, Trace::now(), m_argName, m_argValue );
+            }
+        }
+
+        void TraceSpan::setArgument( const char* name, double value )
+        {
+            m_argName = name;
+            m_argValue = value;
+        }
+    }
+}
+
@@ -0,0 +1,224 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_TRACE_H
+#define DI_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Lightweight tracing facility. Spans get recorded into a fixed-size ring buffer per thread, so recording never allocates once the buffer
+         * of a thread exists. It only waits while an export copies or clear() resets the buffer of the thread. The recorded spans of all threads
+         * can be exported to the Chrome/Perfetto JSON trace format (load the file in chrome://tracing or ui.perfetto.dev). Tracing is disabled by
+         * default. A disabled tracer costs one atomic load per span.
+         */
+        class Trace
+        {
+        public:
+            /**
+             * Number of spans each thread keeps. Older spans get overwritten.
+             */
+            static const size_t BufferCapacity = 1 << 16;
+
+            /**
+             * Maximum length of a span name, including the terminating zero. Longer names get truncated.
+             */
+            static const size_t MaxNameLength = 64;
+
+            /**
+             * Enable or disable recording of spans. Already recorded spans are kept.
+             *
+             * \param enable true to enable.
+             */
+            static void setEnabled( bool enable = true );
+
+            /**
+             * Check whether spans get recorded right now.
+             *
+             * \return true if enabled.
+             */
+            static bool isEnabled();
+
+            /**
+             * Give the calling thread a name. It is shown in the trace viewer instead of the numeric thread id.
+             *
+             * \param name the name.
+             */
+            static void setThreadName( const std::string& name );
+
+            /**
+             * Current time of the trace clock in nanoseconds, relative to the first use of the tracer.
+             *
+             * \return the time
+             */
+            static uint64_t now();
+
+            /**
+             * Record a finished span into the buffer of the calling thread.
+             *
+             * \param category the category. Has to be a string with static lifetime (i.e. a literal or LogTag).
+             * \param name the name of the span. Gets copied.
+             * \param begin begin time as returned by now().
+             * \param end end time as returned by now().
+             * \param argName optional name of an argument to attach. Has to be a string with static lifetime. Can be nullptr.
+             * \param argValue the argument value.
+             */
+            static void record( const char* category, const char* name, uint64_t begin, uint64_t end,
+                                const char* argName = nullptr, double argValue = 0.0 );
+
+            /**
+             * Record the current value of a counter, like a queue length. The trace viewer shows counters as graph. Ignored if tracing is disabled.
+             *
+             * \param category the category. Has to be a string with static lifetime (i.e. a literal or LogTag).
+             * \param name the name of the counter. Gets copied.
+             * \param value the value.
+             */
+            static void counter( const char* category, const char* name, double value );
+
+            /**
+             * Write all recorded spans of all threads as Chrome trace JSON.
+             *
+             * \param os the stream to write to
+             */
+            static void writeChromeTrace( std::ostream& os );
+
+            /**
+             * Write all recorded spans of all threads as Chrome trace JSON to a file.
+             *
+             * \param filename the file to write
+             *
+             * \return true if the file could be written.
+             */
+            static bool writeChromeTrace( const std::string& filename );
+
+            /**
+             * Drop all recorded spans of all threads.
+             */
+            static void clear();
+
+        private:
+            /**
+             * The global switch.
+             */
+            static std::atomic< bool > m_enabled;
+        };
+
+        /**
+         * A scoped span. Records the time between construction and destruction. Spans created while tracing is disabled are not recorded.
+         *
+         * \code
+         * TraceSpan span( LogTag, "Loading" );
+         * span.setArgument( "bytes", size );
+         * \endcode
+         */
+        class TraceSpan
+        {
+        public:
+            /**
+             * Begin a span.
+             *
+             * \param category the category. Has to be a string with static lifetime (i.e. a literal or LogTag).
+             * \param name the name. Has to be a string with static lifetime.
+             */
+            TraceSpan( const char* category, const char* name );
+
+            /**
+             * Begin a span.
+             *
+             * \param category the category. Has to be a string with static lifetime (i.e. a literal or LogTag).
+             * \param name the name. Gets copied if tracing is enabled.
+             */
+            TraceSpan( const char* category, const std::string& name );
+
+            /**
+             * End the span and record it.
+             */
+            ~TraceSpan();
+
+            /**
+             * Attach a numeric argument to the span. Only one argument is kept.
+             *
+             * \param name the argument name. Has to be a string with static lifetime.
+             * \param value the value.
+             */
+            void setArgument( const char* name, double value );
+
+        private:
+            /**
+             * Non-copyable.
+             */
+            TraceSpan( const TraceSpan& ) = delete;
+
+            /**
+             * Non-copyable.
+             */
+            TraceSpan& operator=( const TraceSpan& ) = delete;
+
+            /**
+             * True if tracing was enabled when the span started.
+             */
+            bool m_active = false;
+
+            /**
+             * Category.
+             */
+            const char* m_category = nullptr;
+
+            /**
+             * Name as literal.
+             */
+            const char* m_name = nullptr;
+
+            /**
+             * Name as string. Used if m_name is nullptr. Only filled while tracing is enabled.
+             */
+            std::string m_nameString;
+
+            /**
+             * The optional argument name.
+             */
+            const char* m_argName = nullptr;
+
+            /**
+             * The optional argument value.
+             */
+            double m_argValue = 0.0;
+
+            /**
+             * Start time.
+             */
+            uint64_t m_begin = 0;
+        };
+    }
+}
+
+#endif  // DI_TRACE_H
+
@@ -22,6 +22,15 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+
+#include <di/core/ParallelFor.h>
+
 #include "DataBuilder.h"
 
 namespace di
@@ -142,6 +151,265 @@ namespace di
 
             return cuboid;
         }
+
+        /**
+         * The 12 vertices of an icosahedron with edge length 2.
+         */
+        const float IcosahedronVertices[ 12 ][ 3 ] =
+        {
+            { -1.0f,  1.618034f,  0.0f }, {  1.0f,  1.618034f,  0.0f }, { -1.0f, -1.618034f,  0.0f }, {  1.0f, -1.618034f,  0.0f },
+            {  0.0f, -1.0f,  1.618034f }, {  0.0f,  1.0f,  1.618034f }, {  0.0f, -1.0f, -1.618034f }, {  0.0f,  1.0f, -1.618034f },
+            {  1.618034f,  0.0f, -1.0f }, {  1.618034f,  0.0f,  1.0f }, { -1.618034f,  0.0f, -1.0f }, { -1.618034f,  0.0f,  1.0f }
+        };
+
+        /**
+         * The 20 faces of an icosahedron. Counter-clockwise when seen from outside.
+         */
+        const size_t IcosahedronFaces[ 20 ][ 3 ] =
+        {
+            { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+            { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+            { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+            { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+        };
+
+        SPtr< TriangleMesh > buildIcosphere( size_t frequency, float radius )
+        {
+            size_t n = std::max< size_t >( 1, frequency );
+
+            // Vertex layout: 12 corners, then n - 1 vertices per icosahedron edge, then the inner vertices of each face.
+            size_t verticesPerEdge = n - 1;
+            size_t verticesPerFace = ( n > 2 ) ? ( ( n - 1 ) * ( n - 2 ) / 2 ) : 0;
+
+            // Number the edges. Edges are stored with the smaller corner index first. This defines the direction of the edge vertices.
+            std::vector< std::pair< size_t, size_t > > edges;
+            std::map< std::pair< size_t, size_t >, size_t > edgeIDs;
+            // For each face: the edges AB, AC and BC
+            std::vector< std::array< size_t, 3 > > faceEdges( 20 );
+            for( size_t f = 0; f < 20; ++f )
+            {
+                const size_t* face = IcosahedronFaces[ f ];
+                const std::pair< size_t, size_t > sides[ 3 ] = { { face[ 0 ], face[ 1 ] }, { face[ 0 ], face[ 2 ] }, { face[ 1 ], face[ 2 ] } };
+                for( size_t s = 0; s < 3; ++s )
+                {
+                    auto key = std::make_pair( std::min( sides[ s ].first, sides[ s ].second ), std::max( sides[ s ].first, sides[ s ].second ) );
+                    auto it = edgeIDs.find( key );
+                    if( it == edgeIDs.end() )
+                    {
+                        it = edgeIDs.insert( std::make_pair( key, edges.size() ) ).first;
+                        edges.push_back( key );
+                    }
+                    faceEdges[ f ][ s ] = it->second;
+                }
+            }
+
+            size_t edgeBase = 12;
+            size_t faceBase = edgeBase + edges.size() * verticesPerEdge;
+            size_t numVertices = faceBase + 20 * verticesPerFace;
+
+            auto corner = [ & ]( size_t c )
+            {
+                return glm::vec3( IcosahedronVertices[ c ][ 0 ], IcosahedronVertices[ c ][ 1 ], IcosahedronVertices[ c ][ 2 ] );
+            };
+
+            // Index of the t-th vertex on the given edge, counted from corner "from".
+            auto edgeVertex = [ & ]( size_t edge, size_t from, size_t t )
+            {
+                size_t step = ( from == edges[ edge ].first ) ? t : ( n - t );
+                return edgeBase + edge * verticesPerEdge + step - 1;
+            };
+
+            // Index of the vertex at A + i/n * ( B - A ) + j/n * ( C - A ) of face f
+            auto faceVertex = [ & ]( size_t f, size_t i, size_t j )
+            {
+                const size_t* face = IcosahedronFaces[ f ];
+                if( j == 0 )
+                {
+                    return ( i == 0 ) ? face[ 0 ] : ( ( i == n ) ? face[ 1 ] : edgeVertex( faceEdges[ f ][ 0 ], face[ 0 ], i ) );
+                }
+                if( i == 0 )
+                {
+                    return ( j == n ) ? face[ 2 ] : edgeVertex( faceEdges[ f ][ 1 ], face[ 0 ], j );
+                }
+                if( i + j == n )
+                {
+                    return edgeVertex( faceEdges[ f ][ 2 ], face[ 1 ], j );
+                }
+
+                // Inner vertices are stored row by row.
+                return faceBase + f * verticesPerFace + ( j - 1 ) * ( n - 1 ) - ( ( j - 1 ) * j ) / 2 + ( i - 1 );
+            };
+
+            Vec3Array vertices( numVertices );
+            NormalArray normals( numVertices );
+            auto setVertex = [ & ]( size_t index, const glm::vec3& position )
+            {
+                normals[ index ] = glm::normalize( position );
+                vertices[ index ] = radius * normals[ index ];
+            };
+
+            for( size_t c = 0; c < 12; ++c )
+            {
+                setVertex( c, corner( c ) );
+            }
+
+            parallelFor( 0, edges.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t e = from; e < to; ++e )
+                    {
+                        auto a = corner( edges[ e ].first );
+                        auto b = corner( edges[ e ].second );
+                        for( size_t t = 1; t < n; ++t )
+                        {
+                            setVertex( edgeVertex( e, edges[ e ].first, t ), a + ( static_cast< float >( t ) / n ) * ( b - a ) );
+                        }
+                    }
+                }, 1
+            );
+
+            IndexVec3Array triangles( 20 * n * n );
+            parallelFor( 0, 20,
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t f = from; f < to; ++f )
+                    {
+                        auto a = corner( IcosahedronFaces[ f ][ 0 ] );
+                        auto b = corner( IcosahedronFaces[ f ][ 1 ] );
+                        auto c = corner( IcosahedronFaces[ f ][ 2 ] );
+
+                        // Inner vertices
+                        for( size_t j = 1; j + 1 < n; ++j )
+                        {
+                            for( size_t i = 1; i + j < n; ++i )
+                            {
+                                setVertex( faceVertex( f, i, j ),
+                                           a + ( static_cast< float >( i ) / n ) * ( b - a ) + ( static_cast< float >( j ) / n ) * ( c - a ) );
+                            }
+                        }
+
+                        // Triangles. Same orientation as the icosahedron face.
+                        size_t triangle = f * n * n;
+                        for( size_t j = 0; j < n; ++j )
+                        {
+                            for( size_t i = 0; i + j < n; ++i )
+                            {
+                                triangles[ triangle++ ] = glm::ivec3( faceVertex( f, i, j ), faceVertex( f, i + 1, j ), faceVertex( f, i, j + 1 ) );
+                                if( i + j + 1 < n )
+                                {
+                                    triangles[ triangle++ ] = glm::ivec3( faceVertex( f, i + 1, j ), faceVertex( f, i + 1, j + 1 ),
+                                                                          faceVertex( f, i, j + 1 ) );
+                                }
+                            }
+                        }
+                    }
+                }, 1
+            );
+
+            auto sphere = std::make_shared< TriangleMesh >();
+            sphere->setVertices( vertices );
+            sphere->setNormals( normals );
+            sphere->setTriangles( triangles );
+            return sphere;
+        }
+
+        SPtr< TriangleMesh > buildTorus( size_t majorSegments, size_t minorSegments, float majorRadius, float minorRadius )
+        {
+            size_t numMajor = std::max< size_t >( 3, majorSegments );
+            size_t numMinor = std::max< size_t >( 3, minorSegments );
+            const double twoPi = 2.0 * 3.14159265358979323846;
+
+            Vec3Array vertices( numMajor * numMinor );
+            NormalArray normals( numMajor * numMinor );
+            IndexVec3Array triangles( 2 * numMajor * numMinor );
+
+            parallelFor( 0, numMajor,
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t u = from; u < to; ++u )
+                    {
+                        double theta = twoPi * static_cast< double >( u ) / static_cast< double >( numMajor );
+                        size_t nextU = ( u + 1 ) % numMajor;
+                        for( size_t v = 0; v < numMinor; ++v )
+                        {
+                            double phi = twoPi * static_cast< double >( v ) / static_cast< double >( numMinor );
+                            size_t nextV = ( v + 1 ) % numMinor;
+
+                            auto normal = glm::vec3( std::cos( phi ) * std::cos( theta ), std::cos( phi ) * std::sin( theta ), std::sin( phi ) );
+                            auto center = glm::vec3( majorRadius * std::cos( theta ), majorRadius * std::sin( theta ), 0.0f );
+
+                            size_t index = u * numMinor + v;
+                            normals[ index ] = normal;
+                            vertices[ index ] = center + minorRadius * normal;
+
+                            // The quad between this ring and the next one
+                            glm::ivec3::value_type a = index;
+                            glm::ivec3::value_type b = nextU * numMinor + v;
+                            glm::ivec3::value_type c = nextU * numMinor + nextV;
+                            glm::ivec3::value_type d = u * numMinor + nextV;
+                            triangles[ 2 * index ] = glm::ivec3( a, b, c );
+                            triangles[ 2 * index + 1 ] = glm::ivec3( a, c, d );
+                        }
+                    }
+                }, 1
+            );
+
+            auto torus = std::make_shared< TriangleMesh >();
+            torus->setVertices( vertices );
+            torus->setNormals( normals );
+            torus->setTriangles( triangles );
+            return torus;
+        }
+
+        std::vector< size_t > buildVoronoiLabels( const TriangleMesh& mesh, size_t numRegions, unsigned int seed )
+        {
+            size_t numVertices = mesh.getNumVertices();
+            std::vector< size_t > labels( numVertices, 0 );
+            if( numVertices == 0 )
+            {
+                return labels;
+            }
+            numRegions = std::min( std::max< size_t >( 1, numRegions ), numVertices );
+
+            // NOTE: the distributions of the standard library are implementation-defined. Use the engine output directly to get the same
+            // centers everywhere.
+            std::mt19937 random( seed );
+            std::vector< bool > isCenter( numVertices, false );
+            std::vector< glm::vec3 > centers;
+            centers.reserve( numRegions );
+            while( centers.size() < numRegions )
+            {
+                size_t candidate = random() % numVertices;
+                if( !isCenter[ candidate ] )
+                {
+                    isCenter[ candidate ] = true;
+                    centers.push_back( mesh.getVertex( candidate ) );
+                }
+            }
+
+            parallelFor( 0, numVertices,
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t vertexID = from; vertexID < to; ++vertexID )
+                    {
+                        auto vertex = mesh.getVertex( vertexID );
+                        float closest = std::numeric_limits< float >::max();
+                        for( size_t c = 0; c < centers.size(); ++c )
+                        {
+                            auto diff = centers[ c ] - vertex;
+                            float distance = glm::dot( diff, diff );
+                            if( distance < closest )
+                            {
+                                closest = distance;
+                                labels[ vertexID ] = c;
+                            }
+                        }
+                    }
+                }
+            );
+
+            return labels;
+        }
     }
 }
 
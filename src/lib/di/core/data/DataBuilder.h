@@ -25,6 +25,8 @@
 #ifndef DI_DATABUILDER_H
 #define DI_DATABUILDER_H
 
+#include <vector>
+
 #include <di/core/BoundingBox.h>
 #include <di/core/data/TriangleMesh.h>
 #include <di/MathTypes.h>
@@ -57,6 +59,46 @@ namespace di
          * \return the resulting cuboid.
          */
         SPtr< TriangleMesh > buildCuboid( const glm::vec3& min, const glm::vec3& max );
+
+        /**
+         * Build a geodesic sphere by subdividing each edge of an icosahedron into the given number of segments and projecting the vertices onto
+         * the sphere. Unlike recursive subdivision, this allows arbitrary resolutions. The mesh has 10 * frequency^2 + 2 vertices and 20 *
+         * frequency^2 triangles. Vertices, triangles and normals are created in parallel.
+         *
+         * \param frequency the number of segments per icosahedron edge. At least 1.
+         * \param radius the sphere radius
+         *
+         * eturn the sphere, centered at the origin.
+         */
+        SPtr< TriangleMesh > buildIcosphere( size_t frequency, float radius = 1.0f );
+
+        /**
+         * Build a torus around the z axis. The mesh has majorSegments * minorSegments vertices and twice as many triangles. Vertices,
+         * triangles and normals are created in parallel.
+         *
+         * \param majorSegments the number of segments around the z axis. At least 3.
+         * \param minorSegments the number of segments around the tube. At least 3.
+         * \param majorRadius distance of the tube center to the origin
+         * \param minorRadius radius of the tube
+         *
+         * eturn the torus, centered at the origin.
+         */
+        SPtr< TriangleMesh > buildTorus( size_t majorSegments, size_t minorSegments, float majorRadius = 1.0f, float minorRadius = 0.35f );
+
+        /**
+         * Split the vertices of a mesh into Voronoi patches. The patch centers are vertices chosen pseudo-randomly using the seed. Each vertex
+         * gets the index of the closest center. The results only depend on mesh and seed, not on the platform or the number of threads used.
+         *
+         * 
+ote Distances are Euclidean, not geodesic. On strongly curved meshes, patches might consist of multiple components.
+         *
+         * \param mesh the mesh
+         * \param numRegions the number of patches. Limited to the number of vertices.
+         * \param seed the seed for choosing the centers
+         *
+         * eturn the patch index of each vertex.
+         */
+        std::vector< size_t > buildVoronoiLabels( const TriangleMesh& mesh, size_t numRegions, unsigned int seed );
     }
 }
 
@@ -27,6 +27,7 @@
 
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 #include <di/core/data/DataSetBase.h>
 
@@ -90,8 +91,42 @@ namespace di
                 return std::get< Index >( m_attributes );
             }
 
+            /**
+             * Collect the memory owned by this dataset. Adds the grid and each attribute.
+             *
+             * \param parts the map to add the parts to.
+             */
+            virtual void collectMemoryFootprint( MemoryFootprintParts& parts ) const;
+
         protected:
         private:
+            /**
+             * Add the attribute at Index and recurse to the next one.
+             *
+             * \tparam Index the attribute index
+             * \param parts the map to add the parts to.
+             */
+            template< size_t Index >
+            typename std::enable_if< ( Index < sizeof...( AttributeT ) ) >::type collectAttributeFootprint( MemoryFootprintParts& parts ) const
+            {
+                auto attribute = std::get< Index >( m_attributes );
+                if( attribute )
+                {
+                    parts[ attribute.get() ] = core::getMemoryFootprint( *attribute );
+                }
+                collectAttributeFootprint< Index + 1 >( parts );
+            }
+
+            /**
+             * End of recursion.
+             *
+             * \tparam Index the attribute index
+             */
+            template< size_t Index >
+            typename std::enable_if< ( Index >= sizeof...( AttributeT ) ) >::type collectAttributeFootprint( MemoryFootprintParts& /* parts */ ) const
+            {
+            }
+
             /**
              * The grid of the dataset.
              */
@@ -124,6 +159,17 @@ namespace di
         {
             return m_grid;
         }
+
+        template< typename GridT, typename... AttributeT >
+        void DataSet< GridT, AttributeT... >::collectMemoryFootprint( MemoryFootprintParts& parts ) const
+        {
+            DataSetBase::collectMemoryFootprint( parts );
+            if( m_grid )
+            {
+                parts[ m_grid.get() ] = core::getMemoryFootprint( *m_grid );
+            }
+            collectAttributeFootprint< 0 >( parts );
+        }
     }
 }
 
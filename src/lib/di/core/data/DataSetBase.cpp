@@ -44,5 +44,27 @@ namespace di
         {
             return m_name;
         }
+
+        void DataSetBase::collectMemoryFootprint( MemoryFootprintParts& parts ) const
+        {
+            parts[ this ] = sizeof( *this ) + getHeapFootprint( m_name );
+        }
+
+        size_t DataSetBase::getMemoryFootprint() const
+        {
+            MemoryFootprintParts parts;
+            collectMemoryFootprint( parts );
+            return sumMemoryFootprint( parts );
+        }
+
+        size_t DataSetBase::sumMemoryFootprint( const MemoryFootprintParts& parts )
+        {
+            size_t result = 0;
+            for( const auto& part : parts )
+            {
+                result += part.second;
+            }
+            return result;
+        }
     }
 }
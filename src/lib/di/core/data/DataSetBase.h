@@ -28,6 +28,7 @@
 #include <string>
 
 #include <di/core/ConnectorTransferable.h>
+#include <di/core/data/MemoryFootprint.h>
 
 #include <di/Types.h>
 
@@ -59,6 +60,30 @@ namespace di
              * \return the dataset name
              */
             const std::string& getName() const;
+
+            /**
+             * Collect the memory owned by this dataset. Each part (the dataset itself, grid, attributes) is stored with its address. This allows
+             * callers to collect multiple datasets sharing grids or attributes without counting them twice.
+             *
+             * \param parts the map to add the parts to.
+             */
+            virtual void collectMemoryFootprint( MemoryFootprintParts& parts ) const;
+
+            /**
+             * Get the memory footprint of this dataset in bytes, including grid, attributes and derived caches.
+             *
+             * \return the size in bytes
+             */
+            size_t getMemoryFootprint() const;
+
+            /**
+             * Sum up the collected parts.
+             *
+             * \param parts the parts
+             *
+             * \return the size in bytes
+             */
+            static size_t sumMemoryFootprint( const MemoryFootprintParts& parts );
         protected:
         private:
             /**
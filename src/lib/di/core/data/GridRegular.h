@@ -356,6 +356,16 @@ namespace di
                 return m_transform;
             }
 
+            /**
+             * Get the memory footprint of the grid in bytes. Regular grids are implicit, so this does not depend on the number of voxels.
+             *
+             * \return the size in bytes
+             */
+            size_t getMemoryFootprint() const
+            {
+                return sizeof( *this );
+            }
+
             //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
             //
             // Indexing
@@ -0,0 +1,220 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <di/core/ParallelFor.h>
+
+#include "KdTree.h"
+
+#include <di/core/Logger.h>
+#define LogTag "core/data/KdTree"
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Ranges smaller than this are not worth a thread.
+         */
+        static const size_t kdTreeMinParallelSize = 8192;
+
+        KdTree::KdTree( const Vec3Array& points ):
+            m_points( points ),
+            m_indices( points.size() ),
+            m_axes( points.size(), 0 )
+        {
+            for( size_t i = 0; i < m_indices.size(); ++i )
+            {
+                m_indices[ i ] = i;
+            }
+
+            // Two subtrees per level. Stop when each core has one.
+            size_t threads = std::max< size_t >( 1, std::thread::hardware_concurrency() );
+            while( ( size_t( 1 ) << m_parallelDepth ) < threads )
+            {
+                ++m_parallelDepth;
+            }
+
+            build( 0, m_points.size(), 0 );
+
+            // Store the points in tree order. Queries then walk the memory linearly.
+            Vec3Array sorted( m_points.size() );
+            for( size_t i = 0; i < m_indices.size(); ++i )
+            {
+                sorted[ i ] = m_points[ m_indices[ i ] ];
+            }
+            m_points.swap( sorted );
+        }
+
+        KdTree::~KdTree()
+        {
+            // nothing to clean up so far
+        }
+
+        size_t KdTree::size() const
+        {
+            return m_points.size();
+        }
+
+        void KdTree::build( size_t begin, size_t end, size_t depth )
+        {
+            if( end - begin < 2 )
+            {
+                return;
+            }
+
+            // Split the longest side of the bounding box of the range. This adapts to flat or elongated meshes better than cycling the axes.
+            glm::vec3 min = m_points[ m_indices[ begin ] ];
+            glm::vec3 max = min;
+            for( size_t i = begin + 1; i < end; ++i )
+            {
+                min = glm::min( min, m_points[ m_indices[ i ] ] );
+                max = glm::max( max, m_points[ m_indices[ i ] ] );
+            }
+            auto extent = max - min;
+            uint8_t axis = ( extent.x >= extent.y ) ? ( ( extent.x >= extent.z ) ? 0 : 2 ) : ( ( extent.y >= extent.z ) ? 1 : 2 );
+
+            // Only the indices are sorted. The points are still in their original order during construction.
+            size_t mid = begin + ( end - begin ) / 2;
+            std::nth_element( m_indices.begin() + begin, m_indices.begin() + mid, m_indices.begin() + end,
+                [ this, axis ]( size_t a, size_t b )
+                {
+                    return m_points[ a ][ axis ] < m_points[ b ][ axis ];
+                }
+            );
+            m_axes[ mid ] = axis;
+
+            // Both halves are independent.
+            if( ( depth < m_parallelDepth ) && ( end - begin >= kdTreeMinParallelSize ) )
+            {
+                auto left = std::async( std::launch::async, &KdTree::build, this, begin, mid, depth + 1 );
+                build( mid + 1, end, depth + 1 );
+                left.get();
+            }
+            else
+            {
+                build( begin, mid, depth + 1 );
+                build( mid + 1, end, depth + 1 );
+            }
+        }
+
+        void KdTree::search( const glm::vec3& point, size_t begin, size_t end, size_t k, Candidates* candidates ) const
+        {
+            if( begin >= end )
+            {
+                return;
+            }
+
+            size_t mid = begin + ( end - begin ) / 2;
+            auto delta = point - m_points[ mid ];
+            auto distance = glm::dot( delta, delta );
+
+            // Insert sorted. k is small, so this is faster than a heap.
+            if( ( candidates->size() < k ) || ( distance < candidates->back().first ) )
+            {
+                auto candidate = std::make_pair( distance, m_indices[ mid ] );
+                candidates->insert( std::upper_bound( candidates->begin(), candidates->end(), candidate ), candidate );
+                if( candidates->size() > k )
+                {
+                    candidates->pop_back();
+                }
+            }
+
+            // Visit the side of the query point first. The other side can only contain better points if the split plane is closer than the worst.
+            auto split = delta[ m_axes[ mid ] ];
+            bool left = split < 0.0f;
+            search( point, left ? begin : mid + 1, left ? mid : end, k, candidates );
+            if( ( candidates->size() < k ) || ( split * split < candidates->back().first ) )
+            {
+                search( point, left ? mid + 1 : begin, left ? end : mid, k, candidates );
+            }
+        }
+
+        size_t KdTree::nearest( const glm::vec3& point ) const
+        {
+            Candidates candidates;
+            candidates.reserve( 2 );
+            search( point, 0, m_points.size(), 1, &candidates );
+            return candidates.empty() ? m_points.size() : candidates.front().second;
+        }
+
+        void KdTree::nearest( const glm::vec3& point, size_t k, std::vector< size_t >* indices, std::vector< float >* squaredDistances ) const
+        {
+            Candidates candidates;
+            candidates.reserve( k + 1 );
+            search( point, 0, m_points.size(), k, &candidates );
+
+            indices->clear();
+            if( squaredDistances )
+            {
+                squaredDistances->clear();
+            }
+            for( const auto& candidate : candidates )
+            {
+                indices->push_back( candidate.second );
+                if( squaredDistances )
+                {
+                    squaredDistances->push_back( candidate.first );
+                }
+            }
+        }
+
+        void KdTree::nearest( const Vec3Array& points, size_t k, std::vector< size_t >* indices, std::vector< float >* squaredDistances ) const
+        {
+            indices->assign( points.size() * k, m_points.size() );
+            if( squaredDistances )
+            {
+                squaredDistances->assign( points.size() * k, 0.0f );
+            }
+
+            // Each worker queries a block of points and writes its own part of the result.
+            parallelFor( 0, points.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    Candidates candidates;
+                    candidates.reserve( k + 1 );
+                    for( size_t i = from; i < to; ++i )
+                    {
+                        candidates.clear();
+                        search( points[ i ], 0, m_points.size(), k, &candidates );
+                        for( size_t c = 0; c < candidates.size(); ++c )
+                        {
+                            ( *indices )[ i * k + c ] = candidates[ c ].second;
+                            if( squaredDistances )
+                            {
+                                ( *squaredDistances )[ i * k + c ] = candidates[ c ].first;
+                            }
+                        }
+                    }
+                },
+                256
+            );
+        }
+    }
+}
@@ -0,0 +1,143 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_KDTREE_H
+#define DI_KDTREE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <di/GfxTypes.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * A k-d tree over a set of points for nearest neighbour queries. The tree is stored implicitly: each range of the sorted points has its
+         * median as node and the halves left and right of it as children. Built once, it is immutable and can be queried by many threads.
+         */
+        class KdTree
+        {
+        public:
+            /**
+             * Build the tree. Large subtrees are built in parallel.
+             *
+             * \param points the points. Copied.
+             */
+            explicit KdTree( const Vec3Array& points );
+
+            /**
+             * Destructor.
+             */
+            virtual ~KdTree();
+
+            /**
+             * The number of points.
+             *
+             * \return the number of points.
+             */
+            size_t size() const;
+
+            /**
+             * Find the nearest point.
+             *
+             * \param point the query point
+             *
+             * \return the index of the nearest point in the points the tree was built from. If the tree is empty, size() is returned.
+             */
+            size_t nearest( const glm::vec3& point ) const;
+
+            /**
+             * Find the k nearest points.
+             *
+             * \param point the query point
+             * \param k the number of points to find
+             * \param indices the indices of the points found, nearest first. Fewer than k if there are fewer points.
+             * \param squaredDistances the squared distances of the points found. Can be nullptr.
+             */
+            void nearest( const glm::vec3& point, size_t k, std::vector< size_t >* indices, std::vector< float >* squaredDistances ) const;
+
+            /**
+             * Find the k nearest points of many query points in parallel.
+             *
+             * \param points the query points
+             * \param k the number of points to find for each query point
+             * \param indices k indices per query point, nearest first. Queries with fewer results are padded with size().
+             * \param squaredDistances k squared distances per query point. Can be nullptr.
+             */
+            void nearest( const Vec3Array& points, size_t k, std::vector< size_t >* indices, std::vector< float >* squaredDistances ) const;
+
+        protected:
+        private:
+            /**
+             * The candidates of a query, sorted by distance, nearest first.
+             */
+            typedef std::vector< std::pair< float, size_t > > Candidates;
+
+            /**
+             * Build the subtree of the given range.
+             *
+             * \param begin the first point
+             * \param end the point after the last
+             * \param depth the depth of the subtree. Subtrees near the root are built in parallel.
+             */
+            void build( size_t begin, size_t end, size_t depth );
+
+            /**
+             * Search the subtree of the given range.
+             *
+             * \param point the query point
+             * \param begin the first point
+             * \param end the point after the last
+             * \param k the number of points to find
+             * \param candidates the best points so far
+             */
+            void search( const glm::vec3& point, size_t begin, size_t end, size_t k, Candidates* candidates ) const;
+
+            /**
+             * The points, sorted into the tree.
+             */
+            Vec3Array m_points;
+
+            /**
+             * The original index of each point.
+             */
+            std::vector< size_t > m_indices;
+
+            /**
+             * The axis each node splits.
+             */
+            std::vector< uint8_t > m_axes;
+
+            /**
+             * Subtrees up to this depth are built in parallel.
+             */
+            size_t m_parallelDepth = 0;
+        };
+    }
+}
+
+#endif  // DI_KDTREE_H
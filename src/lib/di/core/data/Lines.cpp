@@ -25,6 +25,8 @@
 #include <vector>
 #include <map>
 
+#include <di/core/data/MemoryFootprint.h>
+
 #include "Lines.h"
 
 namespace di
@@ -125,6 +127,11 @@ namespace di
             return m_boundingBox;
         }
 
+        size_t Lines::getMemoryFootprint() const
+        {
+            return sizeof( *this ) + getHeapFootprint( m_vertices ) + getHeapFootprint( m_lines );
+        }
+
         Lines::Line Lines::getVertices( size_t lineID ) const
         {
             auto vertexIDs = m_lines[ lineID ];
@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "MemoryFootprint.h"
+
+namespace di
+{
+    namespace core
+    {
+        std::string formatMemorySize( size_t bytes )
+        {
+            static const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+
+            double value = static_cast< double >( bytes );
+            size_t unit = 0;
+            while( ( value >= 1024.0 ) && ( unit < 4 ) )
+            {
+                value /= 1024.0;
+                ++unit;
+            }
+
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision( unit == 0 ? 0 : 1 ) << value << " " << units[ unit ];
+            return ss.str();
+        }
+    }
+}
+
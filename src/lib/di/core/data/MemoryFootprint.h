@@ -0,0 +1,264 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_MEMORYFOOTPRINT_H
+#define DI_MEMORYFOOTPRINT_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Maps the address of a memory owning object to its footprint in bytes. Used to avoid counting shared data multiple times.
+         */
+        typedef std::map< const void*, size_t > MemoryFootprintParts;
+
+        /**
+         * Approximate per-element overhead of a node in std::set and std::map (color, parent, left, right).
+         */
+        const size_t MemoryFootprintTreeNodeOverhead = 4 * sizeof( void* );
+
+        namespace detail
+        {
+            /**
+             * Calculates the footprint of an object. The default assumes that the object does not own heap memory.
+             *
+             * \tparam T the type
+             */
+            template< typename T, typename Enable = void >
+            struct MemoryFootprint
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const T& /* object */ )
+                {
+                    return sizeof( T );
+                }
+            };
+        }
+
+        /**
+         * Get the footprint of an object in bytes. This includes the object itself and all the heap memory it owns. Containers report their
+         * capacity, not their size. Types can provide their own accounting by implementing a "size_t getMemoryFootprint() const" member.
+         *
+         * \tparam T the type of the object
+         * \param object the object
+         *
+         * \return the footprint in bytes
+         */
+        template< typename T >
+        size_t getMemoryFootprint( const T& object )
+        {
+            return detail::MemoryFootprint< T >::get( object );
+        }
+
+        /**
+         * Get the heap memory owned by an object. This is the footprint without the object itself. Use this to sum up the members of a class.
+         *
+         * \tparam T the type of the object
+         * \param object the object
+         *
+         * \return the heap footprint in bytes
+         */
+        template< typename T >
+        size_t getHeapFootprint( const T& object )
+        {
+            return getMemoryFootprint( object ) - sizeof( T );
+        }
+
+        /**
+         * Format a byte count for humans, like "12.3 MB".
+         *
+         * \param bytes the byte count
+         *
+         * \return the string
+         */
+        std::string formatMemorySize( size_t bytes );
+
+        namespace detail
+        {
+            /**
+             * Types implementing their own accounting.
+             *
+             * \tparam T the type
+             */
+            template< typename T >
+            struct MemoryFootprint< T, typename std::enable_if< std::is_same< decltype( std::declval< const T& >().getMemoryFootprint() ),
+                                                                              size_t >::value >::type >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const T& object )
+                {
+                    return object.getMemoryFootprint();
+                }
+            };
+
+            /**
+             * Strings.
+             */
+            template<>
+            struct MemoryFootprint< std::string >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes. Small strings might be stored inline. This is ignored.
+                 */
+                static size_t get( const std::string& object )
+                {
+                    return sizeof( std::string ) + object.capacity();
+                }
+            };
+
+            /**
+             * Bool vectors are bit fields.
+             */
+            template<>
+            struct MemoryFootprint< std::vector< bool > >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const std::vector< bool >& object )
+                {
+                    return sizeof( std::vector< bool > ) + ( object.capacity() + 7 ) / 8;
+                }
+            };
+
+            /**
+             * Vectors. Elements owning heap memory get iterated.
+             *
+             * \tparam T the element type
+             */
+            template< typename T >
+            struct MemoryFootprint< std::vector< T > >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const std::vector< T >& object )
+                {
+                    size_t result = sizeof( std::vector< T > ) + object.capacity() * sizeof( T );
+                    if( !std::is_trivially_destructible< T >::value )
+                    {
+                        for( const auto& element : object )
+                        {
+                            result += getHeapFootprint( element );
+                        }
+                    }
+                    return result;
+                }
+            };
+
+            /**
+             * Sets.
+             *
+             * \tparam T the element type
+             */
+            template< typename T >
+            struct MemoryFootprint< std::set< T > >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const std::set< T >& object )
+                {
+                    size_t result = sizeof( std::set< T > ) + object.size() * ( sizeof( T ) + MemoryFootprintTreeNodeOverhead );
+                    if( !std::is_trivially_destructible< T >::value )
+                    {
+                        for( const auto& element : object )
+                        {
+                            result += getHeapFootprint( element );
+                        }
+                    }
+                    return result;
+                }
+            };
+
+            /**
+             * Maps.
+             *
+             * \tparam KeyT the key type
+             * \tparam ValueT the value type
+             */
+            template< typename KeyT, typename ValueT >
+            struct MemoryFootprint< std::map< KeyT, ValueT > >
+            {
+                /**
+                 * Footprint of the object.
+                 *
+                 * \param object the object
+                 *
+                 * \return the size in bytes
+                 */
+                static size_t get( const std::map< KeyT, ValueT >& object )
+                {
+                    size_t result = sizeof( std::map< KeyT, ValueT > ) +
+                                    object.size() * ( sizeof( std::pair< const KeyT, ValueT > ) + MemoryFootprintTreeNodeOverhead );
+                    if( !std::is_trivially_destructible< KeyT >::value || !std::is_trivially_destructible< ValueT >::value )
+                    {
+                        for( const auto& element : object )
+                        {
+                            result += getHeapFootprint( element.first ) + getHeapFootprint( element.second );
+                        }
+                    }
+                    return result;
+                }
+            };
+        }
+    }
+}
+
+#endif  // DI_MEMORYFOOTPRINT_H
+
@@ -25,6 +25,8 @@
 #include <vector>
 #include <map>
 
+#include <di/core/data/MemoryFootprint.h>
+
 #include "Points.h"
 
 namespace di
@@ -72,6 +74,11 @@ namespace di
             return m_boundingBox;
         }
 
+        size_t Points::getMemoryFootprint() const
+        {
+            return sizeof( *this ) + getHeapFootprint( m_vertices );
+        }
+
         const Points::Point& Points::getVertex( size_t pointID ) const
         {
             return m_vertices[ pointID ];
@@ -130,6 +130,13 @@ namespace di
              */
             const BoundingBox& getBoundingBox() const;
 
+            /**
+             * Get the memory footprint of this point set in bytes.
+             *
+             * \return the size in bytes
+             */
+            size_t getMemoryFootprint() const;
+
         protected:
         private:
             /**
@@ -0,0 +1,265 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "Submesh.h"
+
+#include <di/core/Logger.h>
+#define LogTag "core/data/Submesh"
+
+namespace di
+{
+    namespace core
+    {
+        size_t compactIndices( const std::vector< uint8_t >& keep, std::vector< size_t >* newIndex, std::vector< size_t >* oldIndex )
+        {
+            // Count per block, then let each block write from its offset. The blocks keep the order of the elements.
+            const size_t blockSize = 65536;
+            size_t numBlocks = ( keep.size() + blockSize - 1 ) / blockSize;
+            std::vector< size_t > offsets( numBlocks + 1, 0 );
+            parallelFor( 0, numBlocks,
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t block = from; block < to; ++block )
+                    {
+                        auto begin = keep.begin() + block * blockSize;
+                        auto end = keep.begin() + std::min( keep.size(), ( block + 1 ) * blockSize );
+                        offsets[ block + 1 ] = static_cast< size_t >( std::count_if( begin, end,
+                            []( uint8_t flag )
+                            {
+                                return flag != 0;
+                            }
+                        ) );
+                    }
+                },
+                1
+            );
+
+            for( size_t block = 0; block < numBlocks; ++block )
+            {
+                offsets[ block + 1 ] += offsets[ block ];
+            }
+
+            newIndex->resize( keep.size() );
+            if( oldIndex )
+            {
+                oldIndex->resize( offsets.back() );
+            }
+            parallelFor( 0, numBlocks,
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t block = from; block < to; ++block )
+                    {
+                        size_t next = offsets[ block ];
+                        for( size_t i = block * blockSize; i < std::min( keep.size(), ( block + 1 ) * blockSize ); ++i )
+                        {
+                            if( keep[ i ] )
+                            {
+                                ( *newIndex )[ i ] = next;
+                                if( oldIndex )
+                                {
+                                    ( *oldIndex )[ next ] = i;
+                                }
+                                ++next;
+                            }
+                        }
+                    }
+                },
+                1
+            );
+            return offsets.back();
+        }
+
+        Submesh extractSubmesh( const TriangleMesh& mesh, const std::vector< uint8_t >& keepTriangle )
+        {
+            const auto& triangles = mesh.getTriangles();
+
+            Submesh result;
+            std::vector< size_t > newTriangle;
+            compactIndices( keepTriangle, &newTriangle, &result.m_triangles );
+
+            // Triangles share vertices. Marking them from several threads needs atomic flags.
+            std::vector< std::atomic< uint8_t > > used( mesh.getNumVertices() );
+            parallelFor( 0, result.m_triangles.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t i = from; i < to; ++i )
+                    {
+                        const auto& triangle = triangles[ result.m_triangles[ i ] ];
+                        used[ triangle.x ].store( 1, std::memory_order_relaxed );
+                        used[ triangle.y ].store( 1, std::memory_order_relaxed );
+                        used[ triangle.z ].store( 1, std::memory_order_relaxed );
+                    }
+                }
+            );
+
+            std::vector< uint8_t > keepVertex( used.size() );
+            parallelFor( 0, used.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t i = from; i < to; ++i )
+                    {
+                        keepVertex[ i ] = used[ i ].load( std::memory_order_relaxed );
+                    }
+                }
+            );
+            std::vector< size_t > newVertex;
+            compactIndices( keepVertex, &newVertex, &result.m_vertices );
+
+            IndexVec3Array subTriangles( result.m_triangles.size() );
+            parallelFor( 0, subTriangles.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t i = from; i < to; ++i )
+                    {
+                        const auto& triangle = triangles[ result.m_triangles[ i ] ];
+                        subTriangles[ i ] = glm::ivec3( newVertex[ triangle.x ], newVertex[ triangle.y ], newVertex[ triangle.z ] );
+                    }
+                }
+            );
+
+            result.m_mesh = std::make_shared< TriangleMesh >();
+            result.m_mesh->setVertices( *remapAttribute( mesh.getVertices(), result.m_vertices ) );
+            result.m_mesh->setTriangles( subTriangles );
+            if( mesh.getNumNormals() == mesh.getNumVertices() )
+            {
+                result.m_mesh->setNormals( *remapAttribute( mesh.getNormals(), result.m_vertices ) );
+            }
+            return result;
+        }
+
+        size_t connectedComponents( const TriangleMesh& mesh, std::vector< size_t >* component )
+        {
+            // Union-find with path halving. Always link to the smaller root, so each root is the first vertex of its component.
+            std::vector< size_t > parent( mesh.getNumVertices() );
+            for( size_t i = 0; i < parent.size(); ++i )
+            {
+                parent[ i ] = i;
+            }
+
+            auto find = [ &parent ]( size_t v )
+            {
+                while( parent[ v ] != v )
+                {
+                    parent[ v ] = parent[ parent[ v ] ];
+                    v = parent[ v ];
+                }
+                return v;
+            };
+
+            auto unite = [ &parent, &find ]( size_t a, size_t b )
+            {
+                a = find( a );
+                b = find( b );
+                if( a != b )
+                {
+                    parent[ std::max( a, b ) ] = std::min( a, b );
+                }
+            };
+
+            for( const auto& triangle : mesh.getTriangles() )
+            {
+                unite( triangle.x, triangle.y );
+                unite( triangle.x, triangle.z );
+            }
+
+            // Roots come before the vertices linked to them. Number them in order.
+            component->resize( parent.size() );
+            size_t numComponents = 0;
+            for( size_t v = 0; v < parent.size(); ++v )
+            {
+                auto root = find( v );
+                ( *component )[ v ] = ( root == v ) ? numComponents++ : ( *component )[ root ];
+            }
+            return numComponents;
+        }
+
+        std::vector< Submesh > splitComponents( const TriangleMesh& mesh )
+        {
+            std::vector< size_t > component;
+            auto numComponents = connectedComponents( mesh, &component );
+            const auto& triangles = mesh.getTriangles();
+
+            // Sort vertices and triangles into their components. They keep their relative order.
+            std::vector< Submesh > result( numComponents );
+            std::vector< size_t > localIndex( mesh.getNumVertices() );
+            for( size_t v = 0; v < component.size(); ++v )
+            {
+                auto& vertices = result[ component[ v ] ].m_vertices;
+                localIndex[ v ] = vertices.size();
+                vertices.push_back( v );
+            }
+            for( size_t t = 0; t < triangles.size(); ++t )
+            {
+                result[ component[ triangles[ t ].x ] ].m_triangles.push_back( t );
+            }
+
+            // Isolated vertices have nothing to process.
+            result.erase( std::remove_if( result.begin(), result.end(),
+                []( const Submesh& submesh )
+                {
+                    return submesh.m_triangles.empty();
+                }
+            ), result.end() );
+
+            // One component per worker. Each is copied serially.
+            bool copyNormals = ( mesh.getNumNormals() == mesh.getNumVertices() );
+            parallelFor( 0, result.size(),
+                [ & ]( size_t from, size_t to )
+                {
+                    for( size_t c = from; c < to; ++c )
+                    {
+                        auto& submesh = result[ c ];
+                        IndexVec3Array subTriangles( submesh.m_triangles.size() );
+                        for( size_t i = 0; i < subTriangles.size(); ++i )
+                        {
+                            const auto& triangle = triangles[ submesh.m_triangles[ i ] ];
+                            subTriangles[ i ] = glm::ivec3( localIndex[ triangle.x ], localIndex[ triangle.y ], localIndex[ triangle.z ] );
+                        }
+
+                        submesh.m_mesh = std::make_shared< TriangleMesh >();
+                        submesh.m_mesh->setVertices( *remapAttribute( mesh.getVertices(), submesh.m_vertices, false ) );
+                        submesh.m_mesh->setTriangles( subTriangles );
+                        if( copyNormals )
+                        {
+                            submesh.m_mesh->setNormals( *remapAttribute( mesh.getNormals(), submesh.m_vertices, false ) );
+                        }
+                    }
+                },
+                1
+            );
+
+            std::stable_sort( result.begin(), result.end(),
+                []( const Submesh& a, const Submesh& b )
+                {
+                    return a.m_vertices.size() > b.m_vertices.size();
+                }
+            );
+            return result;
+        }
+    }
+}
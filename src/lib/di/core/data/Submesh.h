@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_SUBMESH_H
+#define DI_SUBMESH_H
+
+#include <cstdint>
+#include <vector>
+
+#include <di/core/ParallelFor.h>
+#include <di/core/data/TriangleMesh.h>
+
+#include <di/Types.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * A part of a triangle mesh and where its vertices and triangles come from.
+         */
+        struct Submesh
+        {
+            /**
+             * The mesh. Vertices and triangles keep their relative order.
+             */
+            SPtr< TriangleMesh > m_mesh;
+
+            /**
+             * The original index of each vertex.
+             */
+            std::vector< size_t > m_vertices;
+
+            /**
+             * The original index of each triangle.
+             */
+            std::vector< size_t > m_triangles;
+        };
+
+        /**
+         * Compute the new index of each element that is kept, in parallel.
+         *
+         * \param keep one flag per element. Non-zero to keep the element.
+         * \param newIndex the new index of each kept element. Undefined for the others.
+         * \param oldIndex the original index of each kept element. Can be nullptr.
+         *
+         * \return the number of kept elements
+         */
+        size_t compactIndices( const std::vector< uint8_t >& keep, std::vector< size_t >* newIndex, std::vector< size_t >* oldIndex );
+
+        /**
+         * Extract the given triangles and the vertices they use. Normals are copied if the mesh has them.
+         *
+         * \param mesh the mesh
+         * \param keepTriangle one flag per triangle. Non-zero to keep the triangle.
+         *
+         * \return the submesh
+         */
+        Submesh extractSubmesh( const TriangleMesh& mesh, const std::vector< uint8_t >& keepTriangle );
+
+        /**
+         * Find the connected components of a mesh. Vertices are connected if they share a triangle.
+         *
+         * \param mesh the mesh
+         * \param component the component of each vertex. Components are numbered by their first vertex.
+         *
+         * \return the number of components. Vertices without triangles are components of their own.
+         */
+        size_t connectedComponents( const TriangleMesh& mesh, std::vector< size_t >* component );
+
+        /**
+         * Split a mesh into its connected components. The components are built in parallel.
+         *
+         * \param mesh the mesh
+         *
+         * \return the components, largest first. Vertices without triangles are omitted.
+         */
+        std::vector< Submesh > splitComponents( const TriangleMesh& mesh );
+
+        /**
+         * Gather the attribute values of the submesh vertices.
+         *
+         * \tparam AttributeType the attribute vector type
+         * \param attribute the attribute of the original vertices
+         * \param vertices the original index of each vertex, like \ref Submesh::m_vertices
+         * \param inParallel use \ref parallelFor. Set to false if called from within a \ref parallelFor, to avoid spawning threads per worker.
+         *
+         * \return the attribute of the submesh vertices
+         */
+        template< typename AttributeType >
+        SPtr< AttributeType > remapAttribute( const AttributeType& attribute, const std::vector< size_t >& vertices, bool inParallel = true )
+        {
+            auto result = std::make_shared< AttributeType >( vertices.size() );
+            auto remap = [ & ]( size_t from, size_t to )
+            {
+                for( size_t i = from; i < to; ++i )
+                {
+                    ( *result )[ i ] = attribute[ vertices[ i ] ];
+                }
+            };
+
+            if( inParallel )
+            {
+                parallelFor( 0, vertices.size(), remap );
+            }
+            else
+            {
+                remap( 0, vertices.size() );
+            }
+            return result;
+        }
+
+        /**
+         * Scatter the attribute values of submesh vertices back to the original vertices. The inverse of \ref remapAttribute.
+         *
+         * \tparam AttributeType the attribute vector type
+         * \param part the attribute of the submesh vertices
+         * \param vertices the original index of each vertex, like \ref Submesh::m_vertices
+         * \param whole the attribute of the original vertices. Values of vertices not in the submesh are kept.
+         * \param inParallel use \ref parallelFor. Set to false if called from within a \ref parallelFor, to avoid spawning threads per worker.
+         */
+        template< typename AttributeType >
+        void stitchAttribute( const AttributeType& part, const std::vector< size_t >& vertices, AttributeType* whole, bool inParallel = true )
+        {
+            auto stitch = [ & ]( size_t from, size_t to )
+            {
+                for( size_t i = from; i < to; ++i )
+                {
+                    ( *whole )[ vertices[ i ] ] = part[ i ];
+                }
+            };
+
+            if( inParallel )
+            {
+                parallelFor( 0, vertices.size(), stitch );
+            }
+            else
+            {
+                stitch( 0, vertices.size() );
+            }
+        }
+    }
+}
+
+#endif  // DI_SUBMESH_H
@@ -25,6 +25,9 @@
 #include <algorithm>
 #include <vector>
 #include <map>
+#include <utility>
+
+#include <di/core/data/MemoryFootprint.h>
 
 #include "TriangleMesh.h"
 
@@ -44,6 +47,7 @@ namespace di
 
         size_t TriangleMesh::addVertex( const glm::vec3& vertex )
         {
+            ++m_version;
             m_boundingBox.include( vertex );
             m_vertices.push_back( vertex );
             return m_vertices.size() - 1;
@@ -69,12 +73,14 @@ namespace di
 
         size_t TriangleMesh::addNormal( const glm::vec3& normal )
         {
+            ++m_version;
             m_normals.push_back( normal );
             return m_normals.size() - 1;
         }
 
         size_t TriangleMesh::addTriangle( glm::ivec3 indices )
         {
+            ++m_version;
             m_triangles.push_back( indices );
             return m_triangles.size() - 1;
         }
@@ -116,7 +122,7 @@ namespace di
         bool TriangleMesh::sanityCheck() const
         {
             bool enoughTris = ( getNumTriangles() >= 1 );
-            bool enoughNormals = ( getNumNormals() == 0 ) || ( getNumNormals() == getNumTriangles() );  // either a normal for every vertex or none.
+            bool enoughNormals = ( getNumNormals() == 0 ) || ( getNumNormals() == getNumVertices() );  // either a normal for every vertex or none.
             return enoughTris && enoughNormals;
         }
 
@@ -125,6 +131,17 @@ namespace di
             return m_boundingBox;
         }
 
+        uint64_t TriangleMesh::getVersion() const
+        {
+            return m_version;
+        }
+
+        size_t TriangleMesh::getMemoryFootprint() const
+        {
+            return sizeof( *this ) + getHeapFootprint( m_vertices ) + getHeapFootprint( m_triangles ) + getHeapFootprint( m_normals ) +
+                   getHeapFootprint( m_inverseIndex );
+        }
+
         const NormalArray& TriangleMesh::getNormals() const
         {
             return m_normals;
@@ -147,17 +164,44 @@ namespace di
 
         void TriangleMesh::setTriangles( const IndexVec3Array& triangles )
         {
-            m_triangles = triangles;
+            setTriangles( IndexVec3Array( triangles ) );
+        }
+
+        void TriangleMesh::setTriangles( IndexVec3Array&& triangles )
+        {
+            ++m_version;
+            m_triangles = std::move( triangles );
+
+            // The inverse index refers to the old triangles.
+            m_inverseIndex.clear();
         }
 
         void TriangleMesh::setVertices( const Vec3Array& vertices )
         {
-            m_vertices = vertices;
+            setVertices( Vec3Array( vertices ) );
+        }
+
+        void TriangleMesh::setVertices( Vec3Array&& vertices )
+        {
+            ++m_version;
+            m_vertices = std::move( vertices );
+
+            m_boundingBox = BoundingBox();
+            for( const auto& vertex : m_vertices )
+            {
+                m_boundingBox.include( vertex );
+            }
         }
 
         void TriangleMesh::setNormals( const NormalArray& normals )
         {
-            m_normals = normals;
+            setNormals( NormalArray( normals ) );
+        }
+
+        void TriangleMesh::setNormals( NormalArray&& normals )
+        {
+            ++m_version;
+            m_normals = std::move( normals );
         }
 
         glm::vec3 TriangleMesh::getNormal( size_t vertexID ) const
@@ -250,6 +294,7 @@ namespace di
 
         void TriangleMesh::calculateNormals()
         {
+            ++m_version;
             m_normals.clear();
 
             // we want to keep track of the triangles that share a vertex
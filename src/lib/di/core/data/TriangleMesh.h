@@ -25,6 +25,7 @@
 #ifndef DI_TRIANGLEMESH_H
 #define DI_TRIANGLEMESH_H
 
+#include <cstdint>
 #include <vector>
 #include <tuple>
 
@@ -131,6 +132,13 @@ namespace di
              */
             void setVertices( const Vec3Array& vertices );
 
+            /**
+             * Set the vertex array without copying it. Previously added vertices will be overwritten.
+             *
+             * \param vertices the vertex array. Moved into the mesh.
+             */
+            void setVertices( Vec3Array&& vertices );
+
             /**
              * Abbreviation for 3 vertices of a triangle.
              */
@@ -211,6 +219,13 @@ namespace di
              */
             void setNormals( const NormalArray& normals );
 
+            /**
+             * Set the given normals without copying them. Overwrites previously defined normals
+             *
+             * \param normals the normals to set. Moved into the mesh.
+             */
+            void setNormals( NormalArray&& normals );
+
             /**
              * Get the amount of normals for this mesh. A valid mesh will contain either 0 or exactly 1 for each vertex.
              *
@@ -232,6 +247,13 @@ namespace di
              */
             void setTriangles( const IndexVec3Array& triangles );
 
+            /**
+             * Set the triangle index array without copying it. Overwrites previously set triangles.
+             *
+             * \param triangles the index array. Moved into the mesh.
+             */
+            void setTriangles( IndexVec3Array&& triangles );
+
             /**
              * The number of triangles currently defined.
              *
@@ -261,6 +283,21 @@ namespace di
              */
             const BoundingBox& getBoundingBox() const;
 
+            /**
+             * Get the number of modifications of the arrays so far. Every change of vertices, normals or triangles increments it. Used to detect
+             * changes of arrays that stay at the same address, like by \ref BufferCache.
+             *
+             * \return the version
+             */
+            uint64_t getVersion() const;
+
+            /**
+             * Get the memory footprint of this triangle mesh in bytes, including the inverse index if it was calculated.
+             *
+             * \return the size in bytes
+             */
+            size_t getMemoryFootprint() const;
+
             /**
              * This is a useful function to calculate smooth normals. To have it create semi-per-triangle-normals, do not share vertices for the
              * triangles. The normals are only smooth for triangles with shared vertices.
@@ -299,6 +336,11 @@ namespace di
              * The bounding box.
              */
             BoundingBox m_boundingBox;
+
+            /**
+             * Number of modifications of the arrays.
+             */
+            uint64_t m_version = 0;
         };
     }
 }
@@ -22,11 +22,14 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <di/core/Trace.h>
+
 #include "Buffer.h"
 
+#include <di/gfx/GLError.h>
+
 #include <di/core/Logger.h>
 #define LogTag "gfx/Buffer"
-#include <di/gfx/GLError.h>
 
 namespace di
 {
@@ -79,6 +82,9 @@ namespace di
 
         void Buffer::data( size_t size, const void* ptr )
         {
+            TraceSpan span( LogTag, "Buffer::data" );
+            span.setArgument( "bytes", static_cast< double >( size ) );
+
             // feed the buffer, and let OpenGL know that we don't plan to
             // change it (STATIC) and that it will be used for drawing (DRAW)
             glBufferData( toGLType( m_bufferType ), size, ptr, GL_STATIC_DRAW );
@@ -93,6 +99,8 @@ namespace di
                     return GL_ARRAY_BUFFER;
                 case BufferType::ElementArray:
                     return GL_ELEMENT_ARRAY_BUFFER;
+                case BufferType::Uniform:
+                    return GL_UNIFORM_BUFFER;
                 default:
                     return -1;
             }
@@ -48,8 +48,9 @@ namespace di
              */
             enum class BufferType
             {
-                Array,       // OpenGL: GL_ARRAY_BUFFER
-                ElementArray // OpenGL: GL_ELEMENT_ARRAY_BUFFER
+                Array,        // OpenGL: GL_ARRAY_BUFFER
+                ElementArray, // OpenGL: GL_ELEMENT_ARRAY_BUFFER
+                Uniform       // OpenGL: GL_UNIFORM_BUFFER
             };
 
             /**
@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include <di/core/Trace.h>
+
+#include "BufferCache.h"
+
+#include <di/gfx/GLError.h>
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/BufferCache"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * A cached buffer. Neither the owner nor the buffer are kept alive by the cache.
+             */
+            struct CacheEntry
+            {
+                /**
+                 * The owner of the array. The entry is stale once it expired.
+                 */
+                std::weak_ptr< const void > m_owner;
+
+                /**
+                 * The buffer.
+                 */
+                std::weak_ptr< Buffer > m_buffer;
+            };
+
+            /**
+             * The buffers by array address, size, type and version.
+             */
+            typedef std::map< std::tuple< const void*, size_t, Buffer::BufferType, uint64_t >, CacheEntry > CacheMap;
+
+            /**
+             * The cache of this thread and thus context.
+             */
+            thread_local CacheMap cache;
+
+            /**
+             * Number of hits in this thread.
+             */
+            thread_local size_t hits = 0;
+
+            /**
+             * Number of misses in this thread.
+             */
+            thread_local size_t misses = 0;
+        }
+
+        SPtr< Buffer > BufferCache::get( ConstSPtr< void > owner, const void* ptr, size_t size, Buffer::BufferType bufferType, uint64_t version )
+        {
+            auto key = std::make_tuple( ptr, size, bufferType, version );
+            auto found = cache.find( key );
+            if( found != cache.end() )
+            {
+                auto buffer = found->second.m_buffer.lock();
+                if( buffer && !found->second.m_owner.expired() )
+                {
+                    ++hits;
+                    return buffer;
+                }
+            }
+
+            // Drop stale entries. There are only a few arrays per visualization, so iterating is cheap.
+            for( auto it = cache.begin(); it != cache.end(); )
+            {
+                if( it->second.m_owner.expired() || it->second.m_buffer.expired() )
+                {
+                    it = cache.erase( it );
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            TraceSpan span( LogTag, "BufferCache::get" );
+            ++misses;
+            LogD << "Uploading " << size << " bytes at " << ptr << "." << LogEnd;
+
+            auto buffer = std::make_shared< Buffer >( bufferType );
+            buffer->realize();
+            buffer->bind();
+            buffer->data( size, ptr );
+            logGLError();
+
+            cache[ key ] = CacheEntry{ owner, buffer };
+            return buffer;
+        }
+
+        size_t BufferCache::getHits()
+        {
+            return hits;
+        }
+
+        size_t BufferCache::getMisses()
+        {
+            return misses;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#ifndef DI_BUFFERCACHE_H
+#define DI_BUFFERCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <di/Types.h>
+
+#include <di/gfx/Buffer.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Shares the buffers of arrays between visualizations. Visualizations of the same mesh otherwise upload the same vertices, normals, colors
+         * and triangles each. Buffers are keyed by the address, size and version of the array. The owner of the array, usually the mesh or the
+         * attribute array itself, must still live for a hit. A new array at the address of a released one thus gets a new buffer.
+         *
+         * Owners that can change their arrays in place pass a version that changes with each modification, like \ref
+         * TriangleMesh::getVersion. Arrays without version, like the attributes of datasets, must not be modified while they have a buffer.
+         * The network only shares such arrays as const.
+         *
+         * The buffers are reference counted. The cache does not keep them alive, so they get deleted once the last visualization releases
+         * them. Buffers cannot be used in other contexts. There is one cache per thread, assuming one OpenGL context per thread like the
+         * application and di_headless. All calls require the context to be current.
+         *
+         * \code
+         * glBindVertexArray( m_VAO );
+         * m_vertexBuffer = core::BufferCache::get( mesh, mesh->getVertices(), core::Buffer::BufferType::Array, mesh->getVersion() );
+         * m_vertexBuffer->bind();
+         * glVertexAttribPointer( vertexLoc, 3, GL_FLOAT, 0, 0, 0 );
+         * \endcode
+         */
+        class BufferCache
+        {
+        public:
+            /**
+             * Get the buffer of an array. Uploads the array if it has no buffer yet.
+             *
+             * \tparam Container a container providing data() and size(), like std::vector
+             * \param owner the object owning the array
+             * \param array the array
+             * \param bufferType the type of buffer to use
+             * \param version the version of the array. Has to change whenever the owner modifies the array.
+             *
+             * \return the buffer. Might be unbound.
+             */
+            template< typename Container >
+            static SPtr< Buffer > get( ConstSPtr< void > owner, const Container& array, Buffer::BufferType bufferType = Buffer::BufferType::Array,
+                                       uint64_t version = 0 )
+            {
+                return get( owner, array.data(), sizeof( typename Container::value_type ) * array.size(), bufferType, version );
+            }
+
+            /**
+             * Get the buffer of an array owned by itself, like the attributes of a dataset. Uploads the array if it has no buffer yet. The array must
+             * not be modified while it has a buffer.
+             *
+             * \tparam Container a container providing data() and size(), like std::vector
+             * \param array the array
+             * \param bufferType the type of buffer to use
+             *
+             * \return the buffer. Might be unbound.
+             */
+            template< typename Container >
+            static SPtr< Buffer > get( ConstSPtr< Container > array, Buffer::BufferType bufferType = Buffer::BufferType::Array )
+            {
+                return get( array, *array, bufferType );
+            }
+
+            /**
+             * Get the buffer of some memory. Uploads the memory if it has no buffer yet.
+             *
+             * \param owner the object owning the memory
+             * \param ptr the memory
+             * \param size the size in bytes
+             * \param bufferType the type of buffer to use
+             * \param version the version of the memory. Has to change whenever the owner modifies the memory.
+             *
+             * \return the buffer. Might be unbound.
+             */
+            static SPtr< Buffer > get( ConstSPtr< void > owner, const void* ptr, size_t size, Buffer::BufferType bufferType, uint64_t version = 0 );
+
+            /**
+             * The number of arrays that already had a buffer, in this thread.
+             *
+             * \return the number of hits
+             */
+            static size_t getHits();
+
+            /**
+             * The number of arrays uploaded, in this thread.
+             *
+             * \return the number of misses
+             */
+            static size_t getMisses();
+
+        protected:
+        private:
+            /**
+             * No instances.
+             */
+            BufferCache() = delete;
+        };
+    }
+}
+
+#endif  // DI_BUFFERCACHE_H
@@ -22,6 +22,11 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cmath>
+
+#include <di/MathTypes.h>
+
 #include "Camera.h"
 
 namespace di
@@ -57,6 +62,42 @@ namespace di
         {
             m_projection = matrix;
         }
+
+        glm::mat4 buildViewMatrix( const BoundingBox& sceneBB, const glm::mat4& orientation, float zoom, const glm::vec2& drag )
+        {
+            double near = 0.3; // the near plane
+            if( sceneBB.isValid() )
+            {
+                // Calculate scene
+                double maxExtend = sqrt( 3.0 ) *
+                                   std::max( sceneBB.getSize().x,
+                                             std::max( sceneBB.getSize().y,
+                                                       sceneBB.getSize().z ) );
+
+                // Move scene to rotation point
+                glm::mat4 rotationPointTranslate = glm::translate( -sceneBB.getCenter() );
+                // Scale scene down to match screen size. The scene is now inside a unit sized cube
+                glm::mat4 scaleToFit = glm::scale( glm::vec3( 1.0 / ( 1.0 * maxExtend ) ) );
+                // Zoom
+                glm::mat4 zoomMatrix = glm::scale( glm::vec3( zoom ) );
+
+                // move scene into the visible area
+                glm::mat4 moveToVisibleArea = glm::translate( glm::vec3( 0.0, 0.0, -( zoom * 0.5 + near ) ) );
+
+                glm::mat4 dragMatrix = glm::translate( static_cast< float >( maxExtend ) *
+                                                       ( 1.0f / static_cast< float >( zoom ) ) *
+                                                       glm::vec3( drag.x, drag.y, 0.0 ) );
+
+                return moveToVisibleArea * scaleToFit * zoomMatrix * dragMatrix * orientation * rotationPointTranslate;
+            }
+
+            return glm::mat4();
+        }
+
+        glm::mat4 buildProjectionMatrix( float near, float far, float aspect )
+        {
+            return glm::ortho( -0.5f * aspect, 0.5f * aspect, -0.5f, 0.5f, near, far );
+        }
     }
 }
 
@@ -25,6 +25,7 @@
 #ifndef DI_CAMERA_H
 #define DI_CAMERA_H
 
+#include <di/core/BoundingBox.h>
 #include <di/GfxTypes.h>
 
 namespace di
@@ -89,6 +90,31 @@ namespace di
              */
             glm::mat4 m_projection;
         };
+
+        /**
+         * Build a view matrix that shows the given scene. The scene is scaled to fit into a unit sized cube in front of the camera. If the
+         * scene changes, this matrix might not be useful anymore.
+         *
+         * \param sceneBB the bounding box of the scene to view.
+         * \param orientation orientation
+         * \param zoom a zoom factor. Default = 1.0.
+         * \param drag a drag offset. Defaults to glm::vec2( 0.0 ).
+         *
+         * \return the matrix. Identity if the bounding box is invalid.
+         */
+        glm::mat4 buildViewMatrix( const BoundingBox& sceneBB, const glm::mat4& orientation, float zoom = 1.0,
+                                   const glm::vec2& drag = glm::vec2( 0.0 ) );
+
+        /**
+         * Build an orthographic projection matrix matching \ref buildViewMatrix.
+         *
+         * \param near the near value
+         * \param far the far value
+         * \param aspect the aspect ratio
+         *
+         * \return the projection matrix.
+         */
+        glm::mat4 buildProjectionMatrix( float near, float far, float aspect );
     }
 }
 
@@ -0,0 +1,68 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <utility>
+
+#include "DoubleBuffer.h"
+
+namespace di
+{
+    namespace core
+    {
+        DoubleBuffer::DoubleBuffer( Buffer::BufferType bufferType ):
+            m_front( std::make_shared< Buffer >( bufferType ) ),
+            m_back( std::make_shared< Buffer >( bufferType ) )
+        {
+        }
+
+        DoubleBuffer::~DoubleBuffer()
+        {
+            // The buffers release themselves.
+        }
+
+        void DoubleBuffer::data( size_t size, const void* ptr )
+        {
+            m_back->realize();
+            m_back->bind();
+            m_back->data( size, ptr );
+            std::swap( m_front, m_back );
+        }
+
+        void DoubleBuffer::bind()
+        {
+            m_front->bind();
+        }
+
+        SPtr< Buffer > DoubleBuffer::getFront() const
+        {
+            return m_front;
+        }
+
+        void DoubleBuffer::finalize()
+        {
+            m_front->finalize();
+            m_back->finalize();
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_DOUBLEBUFFER_H
+#define DI_DOUBLEBUFFER_H
+
+#include <di/Types.h>
+
+#include <di/gfx/Buffer.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * A pair of buffers for data that changes often, like the per-frame attributes of a time series. New data is written to the back buffer,
+         * which is not used by the frames still in flight. Writing to a buffer used by a pending draw call would make the driver wait or copy.
+         * After writing, the buffers are swapped. Draw from the front buffer.
+         */
+        class DoubleBuffer
+        {
+        public:
+            /**
+             * Create the two buffers. They are realized on first use.
+             *
+             * \param bufferType the type of both buffers
+             */
+            explicit DoubleBuffer( Buffer::BufferType bufferType = Buffer::BufferType::Array );
+
+            /**
+             * Destructor. Releases the buffers.
+             */
+            virtual ~DoubleBuffer();
+
+            /**
+             * Write the data of the given container to the back buffer and swap. The new front buffer stays bound.
+             *
+             * \tparam Container a container providing data() and size(), like std::vector
+             * \param container the data
+             */
+            template< typename Container >
+            void data( const Container& container )
+            {
+                data( sizeof( typename Container::value_type ) * container.size(), container.data() );
+            }
+
+            /**
+             * Write the data of the given container to the back buffer and swap. The new front buffer stays bound.
+             *
+             * \tparam Container a container providing data() and size(), like std::vector
+             * \param container the data
+             */
+            template< typename Container >
+            void data( ConstSPtr< Container > container )
+            {
+                data( sizeof( typename Container::value_type ) * container->size(), container->data() );
+            }
+
+            /**
+             * Write the data to the back buffer and swap. The new front buffer stays bound.
+             *
+             * \param size size in bytes
+             * \param ptr the data
+             */
+            void data( size_t size, const void* ptr );
+
+            /**
+             * Bind the front buffer.
+             */
+            void bind();
+
+            /**
+             * The buffer to draw from.
+             *
+             * \return the front buffer
+             */
+            SPtr< Buffer > getFront() const;
+
+            /**
+             * Release both buffers. Requires a current context.
+             */
+            void finalize();
+
+        protected:
+        private:
+            /**
+             * The buffer to draw from.
+             */
+            SPtr< Buffer > m_front;
+
+            /**
+             * The buffer to write to.
+             */
+            SPtr< Buffer > m_back;
+        };
+    }
+}
+
+#endif  // DI_DOUBLEBUFFER_H
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#include <cstring>
+#include <string>
+
+#include <di/gfx/UniformBuffer.h>
+#include <di/gfx/View.h>
+
+#include "FrameUniforms.h"
+
+namespace di
+{
+    namespace core
+    {
+        const std::string FrameUniforms::BlockName = "FrameBlock";
+
+        const std::string FrameUniforms::Declaration =
+            "layout( std140 ) uniform " + FrameUniforms::BlockName + "\n"
+            "{\n"
+            "    mat4 u_ProjectionMatrix;\n"
+            "    mat4 u_ViewMatrix;\n"
+            "    vec2 u_viewportSize;\n"
+            "};\n";
+
+        FrameUniforms::FrameUniforms()
+        {
+            static_assert( sizeof( Block ) == 144, "FrameUniforms::Block does not match the std140 layout of the GLSL block." );
+        }
+
+        FrameUniforms::~FrameUniforms()
+        {
+        }
+
+        void FrameUniforms::update( const View& view )
+        {
+            Block block;
+            block.m_projectionMatrix = view.getCamera().getProjectionMatrix();
+            block.m_viewMatrix = view.getCamera().getViewMatrix();
+            block.m_viewportSize = view.getViewportSize();
+            block.m_padding = glm::vec2( 0.0 );
+
+            bool upload = !m_buffer;
+            if( !m_buffer )
+            {
+                m_buffer = std::make_shared< UniformBuffer >( BlockName );
+                m_buffer->realize();
+            }
+
+            // Bound each frame. Uploading requires this too.
+            m_buffer->bind();
+            if( upload || ( std::memcmp( &block, &m_block, sizeof( Block ) ) != 0 ) )
+            {
+                m_block = block;
+                m_buffer->data( sizeof( Block ), &m_block );
+            }
+        }
+
+        void FrameUniforms::finalize()
+        {
+            if( m_buffer )
+            {
+                m_buffer->finalize();
+            }
+            m_buffer = nullptr;
+        }
+    }
+}
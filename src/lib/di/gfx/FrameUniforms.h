@@ -0,0 +1,123 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#ifndef DI_FRAMEUNIFORMS_H
+#define DI_FRAMEUNIFORMS_H
+
+#include <string>
+
+#include <di/Types.h>
+#include <di/GfxTypes.h>
+
+namespace di
+{
+    namespace core
+    {
+        class UniformBuffer;
+        class View;
+
+        /**
+         * The uniforms that are the same for all programs of a frame: camera and viewport. They are kept in a \ref UniformBuffer, updated once
+         * per frame by the code driving the frame, before the visualizations render. \ref Program puts \ref Declaration in front of the code of
+         * every shader, so shaders use u_ProjectionMatrix, u_ViewMatrix and u_viewportSize without declaring them.
+         *
+         * All calls require the OpenGL context of the frame to be current.
+         */
+        class FrameUniforms
+        {
+        public:
+            /**
+             * The name of the block in GLSL.
+             */
+            static const std::string BlockName;
+
+            /**
+             * The GLSL declaration of the block.
+             */
+            static const std::string Declaration;
+
+            /**
+             * Constructor. No OpenGL objects get created yet.
+             */
+            FrameUniforms();
+
+            /**
+             * Destructor. Call finalize() before, while the context is current.
+             */
+            virtual ~FrameUniforms();
+
+            /**
+             * Take the camera and viewport of the view and bind the block for all programs. Only uploads if something changed.
+             *
+             * \param view the view rendered to
+             */
+            void update( const View& view );
+
+            /**
+             * Delete the buffer.
+             */
+            void finalize();
+
+        private:
+            /**
+             * The block in std140 layout.
+             */
+            struct Block
+            {
+                /**
+                 * u_ProjectionMatrix
+                 */
+                glm::mat4 m_projectionMatrix;
+
+                /**
+                 * u_ViewMatrix
+                 */
+                glm::mat4 m_viewMatrix;
+
+                /**
+                 * u_viewportSize
+                 */
+                glm::vec2 m_viewportSize;
+
+                /**
+                 * std140 rounds the size of the block up to a multiple of vec4.
+                 */
+                glm::vec2 m_padding;
+            };
+
+            /**
+             * The values in the buffer.
+             */
+            Block m_block;
+
+            /**
+             * The buffer. Null until the first update.
+             */
+            SPtr< UniformBuffer > m_buffer;
+        };
+    }
+}
+
+#endif  // DI_FRAMEUNIFORMS_H
@@ -22,14 +22,13 @@
 //
 //---------------------------------------------------------------------------------------
 
-#include <iostream>
 #include <string>
 
 #include <di/gfx/OpenGL.h>
 
 #include "GLError.h"
 
-void logGLErrorImpl( std::ostream& to, const std::string& tag, const char* file, int line )
+void logGLErrorImpl( const char* tag, const char* file, int line )
 {
     GLenum err = glGetError();
     while( err != GL_NO_ERROR )
@@ -44,7 +43,7 @@ void logGLErrorImpl( std::ostream& to, const std::string& tag, const char* file,
             case GL_INVALID_FRAMEBUFFER_OPERATION:  error="INVALID_FRAMEBUFFER_OPERATION";  break;
         }
 
-        to << "OPENGL [" << tag << "]: << GL_" << error.c_str() << " - " << file << ":" << line << std::endl;
+        di::core::LogRecord( di::core::LogLevel::Error, tag ) << "GL_" << error << " - " << file << ":" << line << LogEnd
         err = glGetError();
     }
 }
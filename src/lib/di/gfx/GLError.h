@@ -25,9 +25,6 @@
 #ifndef DI_GLERROR_H
 #define DI_GLERROR_H
 
-#include <iostream>
-#include <string>
-
 #include <di/core/Logger.h>
 
 #ifndef LogTag
@@ -35,16 +32,15 @@
 #endif
 
 /**
- * Simply forward GL errors to a stream.
+ * Simply forward GL errors to the logger.
  *
- * \param to the stream to log to
  * \param tag as this log call uses the Logger functionality, we need the tag
  * \param file the filename of caller
  * \param line linenumber of caller
  */
-void logGLErrorImpl( std::ostream& to, const std::string& tag, const char* file, int line );
+void logGLErrorImpl( const char* tag, const char* file, int line );
 
-#define logGLError() logGLErrorImpl( LogGL, LogTag, __FILE__, __LINE__ )
+#define logGLError() logGLErrorImpl( LogTag, __FILE__, __LINE__ )
 
 #endif  // DI_GLERROR_H
 
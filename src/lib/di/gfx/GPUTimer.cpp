@@ -0,0 +1,169 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <string>
+
+#include <di/core/FrameStatistics.h>
+#include <di/gfx/GLError.h>
+
+#include "GPUTimer.h"
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/GPUTimer"
+
+namespace di
+{
+    namespace core
+    {
+        GPUTimer::GPUTimer( const std::string& name, size_t latency ):
+            m_name( name ),
+            m_sets( std::max< size_t >( latency, 1 ) )
+        {
+        }
+
+        void GPUTimer::beginFrame()
+        {
+            collect();
+
+            m_active = false;
+            if( !FrameStatistics::isEnabled() )
+            {
+                return;
+            }
+
+            m_current = ( m_current + 1 ) % m_sets.size();
+            if( m_sets[ m_current ].m_pending )
+            {
+                // The GPU is lagging behind. Waiting would distort exactly what we want to measure.
+                return;
+            }
+
+            m_sets[ m_current ].m_used = 0;
+            m_active = true;
+        }
+
+        void GPUTimer::beginPass( const std::string& pass )
+        {
+            if( !m_active )
+            {
+                return;
+            }
+            endPass();
+
+            auto& set = m_sets[ m_current ];
+            if( set.m_used == set.m_queries.size() )
+            {
+                GLuint query = 0;
+                glGenQueries( 1, &query );
+                set.m_queries.push_back( std::make_pair( pass, query ) );
+            }
+            set.m_queries[ set.m_used ].first = pass;
+
+            glBeginQuery( GL_TIME_ELAPSED, set.m_queries[ set.m_used ].second );
+            logGLError();
+            m_inPass = true;
+        }
+
+        void GPUTimer::endPass()
+        {
+            if( !m_inPass )
+            {
+                return;
+            }
+
+            glEndQuery( GL_TIME_ELAPSED );
+            logGLError();
+            m_sets[ m_current ].m_used++;
+            m_inPass = false;
+        }
+
+        void GPUTimer::endFrame()
+        {
+            endPass();
+            if( m_active && m_sets[ m_current ].m_used )
+            {
+                m_sets[ m_current ].m_pending = true;
+            }
+            m_active = false;
+        }
+
+        void GPUTimer::collect()
+        {
+            // Oldest first. The current set is the newest one.
+            for( size_t i = 1; i <= m_sets.size(); ++i )
+            {
+                auto& set = m_sets[ ( m_current + i ) % m_sets.size() ];
+                if( !set.m_pending )
+                {
+                    continue;
+                }
+
+                // Queries finish in order. If the last is available, all are.
+                GLint available = 0;
+                glGetQueryObjectiv( set.m_queries[ set.m_used - 1 ].second, GL_QUERY_RESULT_AVAILABLE, &available );
+                if( !available )
+                {
+                    break;
+                }
+
+                double total = 0.0;
+                for( size_t q = 0; q < set.m_used; ++q )
+                {
+                    GLuint64 elapsed = 0;
+                    glGetQueryObjectui64v( set.m_queries[ q ].second, GL_QUERY_RESULT, &elapsed );
+                    double milliseconds = static_cast< double >( elapsed ) * 1e-6;
+                    FrameStatistics::record( m_name + "/" + set.m_queries[ q ].first, milliseconds );
+                    total += milliseconds;
+                }
+                FrameStatistics::record( m_name + "/total", total );
+                set.m_pending = false;
+            }
+            logGLError();
+        }
+
+        void GPUTimer::finalize()
+        {
+            if( m_inPass )
+            {
+                glEndQuery( GL_TIME_ELAPSED );
+                m_inPass = false;
+            }
+
+            for( auto& set : m_sets )
+            {
+                for( const auto& query : set.m_queries )
+                {
+                    glDeleteQueries( 1, &query.second );
+                }
+                set.m_queries.clear();
+                set.m_used = 0;
+                set.m_pending = false;
+            }
+            m_active = false;
+            logGLError();
+        }
+    }
+}
+
@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_GPUTIMER_H
+#define DI_GPUTIMER_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <di/gfx/OpenGL.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Measures the GPU time of the render passes of a frame using GL_TIME_ELAPSED queries. Results are never waited for. They get read back
+         * some frames later, once available, and are recorded into \ref FrameStatistics as "<name>/<pass>" and "<name>/total". If all query
+         * sets are still in flight, the frame is not measured instead of stalling the pipeline.
+         *
+         * \code
+         * m_timer.beginFrame();
+         * m_timer.beginPass( "transform" );
+         * // ... draw
+         * m_timer.endPass();
+         * m_timer.endFrame();
+         * \endcode
+         *
+         * Passes cannot be nested. All calls require the same OpenGL context to be current.
+         */
+        class GPUTimer
+        {
+        public:
+            /**
+             * Create the timer. No OpenGL objects get created yet.
+             *
+             * \param name the name prefix of the recorded series. Usually the name of the visualization.
+             * \param latency the number of frames in flight before a frame gets skipped.
+             */
+            explicit GPUTimer( const std::string& name, size_t latency = 4 );
+
+            /**
+             * Destructor. Call \ref finalize before, while the context is current.
+             */
+            virtual ~GPUTimer() = default;
+
+            /**
+             * Begin a frame. Collects the results of earlier frames that are available.
+             */
+            void beginFrame();
+
+            /**
+             * Begin a pass. Ends the previous pass if it was not ended.
+             *
+             * \param pass the name of the pass.
+             */
+            void beginPass( const std::string& pass );
+
+            /**
+             * End the current pass.
+             */
+            void endPass();
+
+            /**
+             * End the frame. The results get collected by one of the next \ref beginFrame calls.
+             */
+            void endFrame();
+
+            /**
+             * Delete the query objects. Pending results are lost.
+             */
+            void finalize();
+
+        protected:
+        private:
+            /**
+             * The queries of a frame.
+             */
+            struct QuerySet
+            {
+                /**
+                 * Pass name and query object. Kept across frames to re-use the queries.
+                 */
+                std::vector< std::pair< std::string, GLuint > > m_queries;
+
+                /**
+                 * Number of queries used in the frame.
+                 */
+                size_t m_used = 0;
+
+                /**
+                 * True if issued but not yet read back.
+                 */
+                bool m_pending = false;
+            };
+
+            /**
+             * Read back the results of all pending query sets that are available.
+             */
+            void collect();
+
+            /**
+             * Name prefix.
+             */
+            std::string m_name;
+
+            /**
+             * A query set per frame in flight.
+             */
+            std::vector< QuerySet > m_sets;
+
+            /**
+             * The set of the current frame.
+             */
+            size_t m_current = 0;
+
+            /**
+             * True if the current frame gets measured.
+             */
+            bool m_active = false;
+
+            /**
+             * True while inside a pass.
+             */
+            bool m_inPass = false;
+        };
+    }
+}
+
+#endif  // DI_GPUTIMER_H
+
@@ -0,0 +1,437 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <di/gfx/OpenGL.h>
+
+#ifdef DI_HEADLESS_EGL
+// Keep EGL from pulling in Xlib. Its macros clash with our code.
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#ifdef DI_HEADLESS_OSMESA
+#include <GL/osmesa.h>
+#endif
+
+#include <di/core/StringUtils.h>
+
+#include "HeadlessContext.h"
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/HeadlessContext"
+
+namespace di
+{
+    namespace core
+    {
+#ifdef DI_HEADLESS_EGL
+        namespace
+        {
+            /**
+             * Append the current EGL error code to a message.
+             *
+             * \param message the message
+             *
+             * \return the message with error code.
+             */
+            std::string withEGLError( const std::string& message )
+            {
+                std::stringstream ss;
+                ss << message << " (EGL error 0x" << std::hex << eglGetError() << ")";
+                return ss.str();
+            }
+
+            /**
+             * Protects g_displayUsers.
+             */
+            std::mutex g_displayMutex;
+
+            /**
+             * The number of contexts using each initialized display. EGL returns the same display to all threads of the process. Terminating it
+             * would pull it from under the contexts of other threads.
+             */
+            std::map< EGLDisplay, size_t > g_displayUsers;
+
+            /**
+             * Initialize the display for one more context.
+             *
+             * \param display the display
+             *
+             * \return true if successful
+             */
+            bool acquireDisplay( EGLDisplay display )
+            {
+                std::lock_guard< std::mutex > lock( g_displayMutex );
+                EGLint major = 0;
+                EGLint minor = 0;
+                if( !eglInitialize( display, &major, &minor ) )
+                {
+                    return false;
+                }
+                ++g_displayUsers[ display ];
+                return true;
+            }
+
+            /**
+             * Release the display of a context. The last context terminates it.
+             *
+             * \param display the display
+             */
+            void releaseDisplay( EGLDisplay display )
+            {
+                std::lock_guard< std::mutex > lock( g_displayMutex );
+                auto users = g_displayUsers.find( display );
+                if( ( users != g_displayUsers.end() ) && ( --users->second == 0 ) )
+                {
+                    g_displayUsers.erase( users );
+                    eglTerminate( display );
+                }
+            }
+        }
+#endif
+
+        HeadlessContext::HeadlessContext()
+        {
+        }
+
+        HeadlessContext::~HeadlessContext()
+        {
+            destroy();
+        }
+
+        bool HeadlessContext::isAvailable( Backend backend )
+        {
+            switch( backend )
+            {
+                case Backend::EGL:
+#ifdef DI_HEADLESS_EGL
+                    return true;
+#else
+                    return false;
+#endif
+                case Backend::OSMesa:
+#ifdef DI_HEADLESS_OSMESA
+                    return true;
+#else
+                    return false;
+#endif
+                default:
+                    return isAvailable( Backend::EGL ) || isAvailable( Backend::OSMesa );
+            }
+        }
+
+        bool HeadlessContext::parseBackend( const std::string& name, Backend& backend )
+        {
+            auto lower = toLower( name );
+            if( lower == "auto" )
+            {
+                backend = Backend::Auto;
+            }
+            else if( lower == "egl" )
+            {
+                backend = Backend::EGL;
+            }
+            else if( lower == "osmesa" )
+            {
+                backend = Backend::OSMesa;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+
+        bool HeadlessContext::fail( const std::string& message )
+        {
+            m_error = message;
+            destroy();
+            return false;
+        }
+
+        bool HeadlessContext::create( Backend backend, bool software )
+        {
+            destroy();
+
+            if( software )
+            {
+                // Do not overwrite: the user might want to select the driver explicitly.
+                setenv( "LIBGL_ALWAYS_SOFTWARE", "1", 0 );
+            }
+
+            switch( backend )
+            {
+                case Backend::EGL:
+                    return createEGL();
+                case Backend::OSMesa:
+                    return createOSMesa();
+                default:
+                    break;
+            }
+
+            // Auto: EGL is faster as it can use llvmpipe with all threads or a GPU. OSMesa is the fallback for machines without libEGL.
+            std::string error;
+            if( isAvailable( Backend::EGL ) )
+            {
+                if( createEGL() )
+                {
+                    return true;
+                }
+                error = "EGL: " + m_error;
+                LogD << "Could not create EGL context: " << m_error << ". Trying OSMesa." << LogEnd;
+            }
+            if( isAvailable( Backend::OSMesa ) )
+            {
+                if( createOSMesa() )
+                {
+                    return true;
+                }
+                error += ( error.empty() ? "" : " " ) + std::string( "OSMesa: " ) + m_error;
+            }
+            m_error = error.empty() ? "Neither EGL nor OSMesa is available in this build." : error;
+            return false;
+        }
+
+        bool HeadlessContext::createEGL()
+        {
+#ifdef DI_HEADLESS_EGL
+            m_backend = Backend::EGL;
+
+            // Prefer the Mesa surfaceless platform. It does not need any display server.
+            EGLDisplay display = EGL_NO_DISPLAY;
+            const char* clientExtensions = eglQueryString( EGL_NO_DISPLAY, EGL_EXTENSIONS );
+            auto getPlatformDisplay = reinterpret_cast< PFNEGLGETPLATFORMDISPLAYEXTPROC >( eglGetProcAddress( "eglGetPlatformDisplayEXT" ) );
+            if( clientExtensions && strstr( clientExtensions, "EGL_MESA_platform_surfaceless" ) && getPlatformDisplay )
+            {
+                display = getPlatformDisplay( EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr );
+            }
+            if( display == EGL_NO_DISPLAY )
+            {
+                display = eglGetDisplay( EGL_DEFAULT_DISPLAY );
+            }
+            if( display == EGL_NO_DISPLAY )
+            {
+                return fail( withEGLError( "No EGL display available" ) );
+            }
+
+            if( !acquireDisplay( display ) )
+            {
+                return fail( withEGLError( "Could not initialize EGL" ) );
+            }
+            m_display = display;
+
+            if( !eglBindAPI( EGL_OPENGL_API ) )
+            {
+                return fail( withEGLError( "EGL does not support desktop OpenGL" ) );
+            }
+
+            // We use our own FBOs. A surface is only needed if the implementation cannot do without.
+            std::string extensions = eglQueryString( display, EGL_EXTENSIONS );
+            bool surfaceless = extensions.find( "EGL_KHR_surfaceless_context" ) != std::string::npos;
+
+            EGLint configAttribs[] =
+            {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_DEPTH_SIZE, 24,
+                EGL_NONE
+            };
+            EGLConfig config = nullptr;
+            EGLint numConfigs = 0;
+            if( !eglChooseConfig( display, configAttribs, &config, 1, &numConfigs ) || ( numConfigs < 1 ) )
+            {
+                return fail( withEGLError( "No suitable EGL configuration" ) );
+            }
+
+            // The same version and profile the UI requests.
+            EGLint contextAttribs[] =
+            {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 3,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+            };
+            EGLContext context = eglCreateContext( display, config, EGL_NO_CONTEXT, contextAttribs );
+            if( context == EGL_NO_CONTEXT )
+            {
+                return fail( withEGLError( "Could not create an OpenGL 3.3 core context" ) );
+            }
+            m_context = context;
+
+            if( !surfaceless )
+            {
+                EGLint surfaceAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+                EGLSurface surface = eglCreatePbufferSurface( display, config, surfaceAttribs );
+                if( surface == EGL_NO_SURFACE )
+                {
+                    return fail( withEGLError( "Could not create a pbuffer surface" ) );
+                }
+                m_surface = surface;
+            }
+
+            if( !makeCurrent() )
+            {
+                return fail( withEGLError( "Could not make the context current" ) );
+            }
+            return initGLEW();
+#else
+            return fail( "EGL is not available in this build." );
+#endif
+        }
+
+        bool HeadlessContext::createOSMesa()
+        {
+#ifdef DI_HEADLESS_OSMESA
+            m_backend = Backend::OSMesa;
+
+            const int attribs[] =
+            {
+                OSMESA_FORMAT, OSMESA_RGBA,
+                OSMESA_DEPTH_BITS, 24,
+                OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+                OSMESA_CONTEXT_MAJOR_VERSION, 3,
+                OSMESA_CONTEXT_MINOR_VERSION, 3,
+                0
+            };
+            OSMesaContext context = OSMesaCreateContextAttribs( attribs, nullptr );
+            if( !context )
+            {
+                return fail( "Could not create an OpenGL 3.3 core context" );
+            }
+            m_context = context;
+
+            m_buffer.assign( 4, 0 );
+            if( !makeCurrent() )
+            {
+                return fail( "Could not make the context current" );
+            }
+            return initGLEW();
+#else
+            return fail( "OSMesa is not available in this build." );
+#endif
+        }
+
+        bool HeadlessContext::initGLEW()
+        {
+            // Load the GL functions. GLEW needs the experimental flag for core contexts and causes an GL_INVALID_ENUM on them. Ignore it.
+            glewExperimental = true;
+            GLenum err = glewInit();
+            if( err != GLEW_OK )
+            {
+                return fail( std::string( "Could not initialize GLEW: " ) + reinterpret_cast< const char* >( glewGetErrorString( err ) ) );
+            }
+            glGetError();
+
+            m_error = "";
+            return true;
+        }
+
+        bool HeadlessContext::makeCurrent()
+        {
+            if( !m_context )
+            {
+                return false;
+            }
+
+#ifdef DI_HEADLESS_EGL
+            if( m_backend == Backend::EGL )
+            {
+                return eglMakeCurrent( m_display, m_surface, m_surface, m_context ) == EGL_TRUE;
+            }
+#endif
+#ifdef DI_HEADLESS_OSMESA
+            if( m_backend == Backend::OSMesa )
+            {
+                return OSMesaMakeCurrent( static_cast< OSMesaContext >( m_context ), m_buffer.data(), GL_UNSIGNED_BYTE, 1, 1 ) == GL_TRUE;
+            }
+#endif
+            return false;
+        }
+
+        void HeadlessContext::destroy()
+        {
+#ifdef DI_HEADLESS_EGL
+            if( ( m_backend == Backend::EGL ) && m_display )
+            {
+                eglMakeCurrent( m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+                if( m_surface )
+                {
+                    eglDestroySurface( m_display, m_surface );
+                }
+                if( m_context )
+                {
+                    eglDestroyContext( m_display, m_context );
+                }
+                releaseDisplay( m_display );
+            }
+#endif
+#ifdef DI_HEADLESS_OSMESA
+            if( ( m_backend == Backend::OSMesa ) && m_context )
+            {
+                OSMesaDestroyContext( static_cast< OSMesaContext >( m_context ) );
+            }
+#endif
+
+            m_surface = nullptr;
+            m_context = nullptr;
+            m_display = nullptr;
+            m_buffer.clear();
+            m_backend = Backend::Auto;
+        }
+
+        HeadlessContext::Backend HeadlessContext::getBackend() const
+        {
+            return m_backend;
+        }
+
+        const std::string& HeadlessContext::getError() const
+        {
+            return m_error;
+        }
+
+        std::string HeadlessContext::getRenderer() const
+        {
+            auto renderer = glGetString( GL_RENDERER );
+            return renderer ? reinterpret_cast< const char* >( renderer ) : "";
+        }
+
+        std::string HeadlessContext::getVersion() const
+        {
+            auto version = glGetString( GL_VERSION );
+            return version ? reinterpret_cast< const char* >( version ) : "";
+        }
+    }
+}
+
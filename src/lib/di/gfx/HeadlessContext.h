@@ -0,0 +1,201 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_HEADLESSCONTEXT_H
+#define DI_HEADLESSCONTEXT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * An OpenGL 3.3 core context without any window or display server. Use it to drive \ref OffscreenView and the visualizations on
+         * headless machines. Two backends are supported, if found during the build: a surfaceless EGL context, and OSMesa as fallback. By
+         * default, Mesa is told to use its software rasterizer (llvmpipe), which needs no GPU and scales with the number of processes.
+         *
+         * A context is current for one thread only. Each thread or process that renders needs its own context.
+         */
+        class HeadlessContext
+        {
+        public:
+            /**
+             * The API used to create the context.
+             */
+            enum class Backend
+            {
+                Auto,   //!< Try EGL first, then OSMesa.
+                EGL,    //!< Surfaceless EGL. Prefers the Mesa surfaceless platform, falls back to the default display.
+                OSMesa  //!< Mesa's off-screen rendering API. Always software rendering.
+            };
+
+            /**
+             * Constructor. Does not create the context. Use \ref create for this.
+             */
+            HeadlessContext();
+
+            /**
+             * Destructor. Destroys the context if it was created.
+             */
+            virtual ~HeadlessContext();
+
+            /**
+             * Check whether a backend was compiled in.
+             *
+             * \param backend the backend. Auto is available if any backend is.
+             *
+             * \return true if available.
+             */
+            static bool isAvailable( Backend backend );
+
+            /**
+             * Parse a backend name: auto, egl or osmesa.
+             *
+             * \param name the name, case insensitive
+             * \param backend the result. Unchanged if the name is unknown.
+             *
+             * \return true if the name is known.
+             */
+            static bool parseBackend( const std::string& name, Backend& backend );
+
+            /**
+             * Create the context and make it current for the calling thread.
+             *
+             * \param backend the backend to use
+             * \param software if true, force the Mesa software rasterizer. The environment variable LIBGL_ALWAYS_SOFTWARE overrides this.
+             *
+             * \return true on success. Use \ref getError to query the reason on failure.
+             */
+            bool create( Backend backend = Backend::Auto, bool software = true );
+
+            /**
+             * Make the context current for the calling thread. The context must not be current in another thread.
+             *
+             * \return true on success.
+             */
+            bool makeCurrent();
+
+            /**
+             * Release and destroy the context. Called by the destructor.
+             */
+            void destroy();
+
+            /**
+             * The backend of the created context.
+             *
+             * \return the backend. Auto if no context was created.
+             */
+            Backend getBackend() const;
+
+            /**
+             * The reason for the last failure of \ref create.
+             *
+             * \return the error message.
+             */
+            const std::string& getError() const;
+
+            /**
+             * The OpenGL renderer string. Only valid after a successful \ref create.
+             *
+             * \return the renderer, like "llvmpipe (LLVM 15.0.6, 256 bits)"
+             */
+            std::string getRenderer() const;
+
+            /**
+             * The OpenGL version string. Only valid after a successful \ref create.
+             *
+             * \return the version string.
+             */
+            std::string getVersion() const;
+
+        protected:
+        private:
+            /**
+             * Create an EGL context.
+             *
+             * \return true on success.
+             */
+            bool createEGL();
+
+            /**
+             * Create an OSMesa context.
+             *
+             * \return true on success.
+             */
+            bool createOSMesa();
+
+            /**
+             * Load the OpenGL functions of the current context.
+             *
+             * \return true on success.
+             */
+            bool initGLEW();
+
+            /**
+             * Fail with the given message. Destroys the partially created context.
+             *
+             * \param message the message
+             *
+             * \return always false.
+             */
+            bool fail( const std::string& message );
+
+            /**
+             * The backend of the created context.
+             */
+            Backend m_backend = Backend::Auto;
+
+            /**
+             * The EGL display. An EGLDisplay, kept as void pointer to avoid including EGL everywhere.
+             */
+            void* m_display = nullptr;
+
+            /**
+             * The context. An EGLContext or OSMesaContext.
+             */
+            void* m_context = nullptr;
+
+            /**
+             * The pbuffer surface used if the implementation does not support surfaceless contexts. An EGLSurface.
+             */
+            void* m_surface = nullptr;
+
+            /**
+             * OSMesa always needs a color buffer to make a context current. We render to FBOs, so a single pixel is enough.
+             */
+            std::vector< uint8_t > m_buffer;
+
+            /**
+             * Last error.
+             */
+            std::string m_error;
+        };
+    }
+}
+
+#endif  // DI_HEADLESSCONTEXT_H
+
@@ -22,21 +22,32 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <atomic>
+#include <map>
 #include <string>
 #include <vector>
 
+#include <di/gfx/FrameUniforms.h>
+#include <di/gfx/ProgramBinaryCache.h>
 #include <di/gfx/Shader.h>
+#include <di/gfx/UniformBuffer.h>
 
 #include "Program.h"
 
+#include <di/gfx/GLError.h>
+
 #include <di/core/Logger.h>
 #define LogTag "gfx/Program"
-#include <di/gfx/GLError.h>
 
 namespace di
 {
     namespace core
     {
+        /**
+         * Numbers the links of all programs. See Program::m_link.
+         */
+        static std::atomic< uint64_t > linkCount( 0 );
+
         Program::Program( std::initializer_list< SPtr< Shader > > shaders ):
             GLBindable(),
             m_shaders( shaders )
@@ -69,6 +80,18 @@ namespace di
             return found;
         }
 
+        bool Program::isVariant( GLuint object ) const
+        {
+            for( const auto& variant : m_variants )
+            {
+                if( variant.second.m_object == object )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         bool Program::compileAndLink()
         {
             if( !isRealized() )
@@ -77,7 +100,6 @@ namespace di
             }
 
             m_needCompile = false;
-            m_uniformLocationCache.clear();
 
             // Add all defines to the string:
             std::string prefixCode = "";
@@ -93,9 +115,67 @@ namespace di
                 }
             }
 
+            // All shaders share the frame uniforms. Declared here once instead of in each shader.
+            prefixCode += FrameUniforms::Declaration;
+
             // LogD << "Prefix:" << LogEnd;
             // LogD << prefixCode << LogEnd;
 
+            // Keep the uniform locations of the current define set and switch to a known one if possible. This is a plain glUseProgram then.
+            for( auto variant = m_variants.begin(); variant != m_variants.end(); ++variant )
+            {
+                if( variant->second.m_object == m_object )
+                {
+                    variant->second.m_uniformLocations = m_uniformLocationCache;
+                }
+            }
+            auto known = m_variants.find( prefixCode );
+            if( known != m_variants.end() )
+            {
+                m_object = known->second.m_object;
+                m_link = known->second.m_link;
+                m_uniformLocationCache = known->second.m_uniformLocations;
+                restoreUniforms();
+                return true;
+            }
+
+            // A new define set gets its own object. Keep the attribute locations of the first one, so that VAOs work with all of them.
+            if( isVariant( m_object ) )
+            {
+                m_object = glCreateProgram();
+                logGLError();
+            }
+            m_uniformLocationCache.clear();
+            for( auto attribLocation : m_attribLocations )
+            {
+                glBindAttribLocation( m_object, attribLocation.second, attribLocation.first.c_str() );
+            }
+            for( auto fragDataLocation : m_fragDataLocations )
+            {
+                glBindFragDataLocation( m_object, fragDataLocation.second, fragDataLocation.first.c_str() );
+            }
+            logGLError();
+
+            // Use the binary of an earlier link of the same code if there is one.
+            std::string code = prefixCode;
+            for( auto shader : m_shaders )
+            {
+                code += std::to_string( static_cast< int >( shader->getShaderType() ) ) + "\n" + shader->getCode();
+            }
+            for( auto attribLocation : m_attribLocations )
+            {
+                code += "attrib " + attribLocation.first + " " + std::to_string( attribLocation.second ) + "\n";
+            }
+            for( auto fragDataLocation : m_fragDataLocations )
+            {
+                code += "fragdata " + fragDataLocation.first + " " + std::to_string( fragDataLocation.second ) + "\n";
+            }
+            if( ProgramBinaryCache::load( m_object, code ) )
+            {
+                addVariant( prefixCode );
+                return true;
+            }
+
             // Realize all shaders and attach.
             for( auto shader : m_shaders )
             {
@@ -115,6 +195,7 @@ namespace di
 
                 glAttachShader( m_object, shader->getObjectID() );
             }
+            ProgramBinaryCache::prepareLink( m_object );
             glLinkProgram( m_object );
             logGLError();
 
@@ -132,13 +213,132 @@ namespace di
                 LogE << "Program linker failed. Log: " << LogEnd
                 LogE << errorLog.data() << LogEnd;
 
+                glDeleteProgram( m_object );
                 m_object = 0;
+                m_link = 0;
                 return false;
             }
 
+            ProgramBinaryCache::store( m_object, code );
+            addVariant( prefixCode );
             return true;
         }
 
+        void Program::addVariant( const std::string& prefixCode )
+        {
+            m_link = ++linkCount;
+            m_variants[ prefixCode ].m_object = m_object;
+            m_variants[ prefixCode ].m_link = m_link;
+
+            // Assign the uniform blocks to the points their buffers get bound to.
+            GLint blockCount = 0;
+            glGetProgramiv( m_object, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount );
+            for( GLint block = 0; block < blockCount; ++block )
+            {
+                GLint length = 0;
+                glGetActiveUniformBlockiv( m_object, block, GL_UNIFORM_BLOCK_NAME_LENGTH, &length );
+                std::vector< GLchar > name( length + 1 );
+                glGetActiveUniformBlockName( m_object, block, name.size(), &length, name.data() );
+                glUniformBlockBinding( m_object, block, UniformBuffer::getBindingPoint( std::string( name.data(), length ) ) );
+            }
+            logGLError();
+
+            // The first define set decides where the attributes are.
+            if( m_attribLocations.empty() )
+            {
+                GLint count = 0;
+                GLint maxLength = 0;
+                glGetProgramiv( m_object, GL_ACTIVE_ATTRIBUTES, &count );
+                glGetProgramiv( m_object, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength );
+                std::vector< GLchar > name( maxLength + 1 );
+                for( GLint i = 0; i < count; ++i )
+                {
+                    GLsizei length = 0;
+                    GLint size = 0;
+                    GLenum type = 0;
+                    glGetActiveAttrib( m_object, i, name.size(), &length, &size, &type, name.data() );
+                    std::string attribName( name.data(), length );
+
+                    // Built-ins like gl_VertexID have no location.
+                    GLint location = glGetAttribLocation( m_object, attribName.c_str() );
+                    if( location >= 0 )
+                    {
+                        m_attribLocations[ attribName ] = location;
+                    }
+                }
+                logGLError();
+            }
+
+            // Values set once, like sampler units, were set in the object of another define set.
+            restoreUniforms();
+        }
+
+        Program::UniformValue* Program::keptUniform( const Uniform& uniform, UniformType type )
+        {
+            for( auto kept = m_uniformValues.begin(); kept != m_uniformValues.end(); ++kept )
+            {
+                if( kept->m_name == uniform.getName() )
+                {
+                    kept->m_type = type;
+                    return &( *kept );
+                }
+            }
+
+            m_uniformValues.push_back( UniformValue() );
+            m_uniformValues.back().m_name = uniform.getName();
+            m_uniformValues.back().m_type = type;
+            return &m_uniformValues.back();
+        }
+
+        void Program::keepUniform( const Uniform& uniform, UniformType type, const GLint* values, size_t count )
+        {
+            keptUniform( uniform, type )->m_ints.assign( values, values + count );
+        }
+
+        void Program::keepUniform( const Uniform& uniform, UniformType type, const GLfloat* values, size_t count )
+        {
+            keptUniform( uniform, type )->m_floats.assign( values, values + count );
+        }
+
+        void Program::restoreUniforms()
+        {
+            if( m_uniformValues.empty() )
+            {
+                return;
+            }
+
+            glUseProgram( m_object );
+            for( auto value = m_uniformValues.begin(); value != m_uniformValues.end(); ++value )
+            {
+                GLint location = glGetUniformLocation( m_object, value->m_name.c_str() );
+                if( location < 0 )
+                {
+                    continue;
+                }
+
+                const auto& floats = value->m_floats;
+                switch( value->m_type )
+                {
+                    case UniformType::Int:
+                        glUniform1iv( location, value->m_ints.size(), value->m_ints.data() );
+                        break;
+                    case UniformType::Float:
+                        glUniform1fv( location, 1, floats.data() );
+                        break;
+                    case UniformType::Vec2:
+                        glUniform2fv( location, 1, floats.data() );
+                        break;
+                    case UniformType::Vec3:
+                        glUniform3fv( location, 1, floats.data() );
+                        break;
+                    case UniformType::Vec4:
+                        glUniform4fv( location, 1, floats.data() );
+                        break;
+                }
+            }
+            logGLError();
+        }
+
         bool Program::realize()
         {
             if( isRealized() )
@@ -154,21 +354,42 @@ namespace di
 
         void Program::finalize()
         {
-            if( isRealized() )
+            // Deleting detaches the shaders.
+            for( auto variant : m_variants )
+            {
+                glDeleteProgram( variant.second.m_object );
+            }
+            if( isRealized() && !isVariant( m_object ) )
+            {
+                glDeleteProgram( m_object );
+            }
+            logGLError();
+
+            m_variants.clear();
+            m_uniformLocationCache.clear();
+            m_object = 0;
+            m_link = 0;
+        }
+
+        void Program::bindFragDataLocation( GLuint colorNumber, const std::string& name )
+        {
+            auto found = m_fragDataLocations.find( name );
+            if( ( found != m_fragDataLocations.end() ) && ( found->second == colorNumber ) )
             {
-                // Detach first
-                for( auto shader : m_shaders )
+                return;
+            }
+            m_fragDataLocations[ name ] = colorNumber;
+
+            // All define sets were linked without. Keep the current object and relink it.
+            for( auto variant : m_variants )
+            {
+                if( variant.second.m_object != m_object )
                 {
-                    if( isAttached( shader ) )
-                    {
-                        glDetachShader( m_object, shader->getObjectID() );
-                        logGLError();
-                    }
+                    glDeleteProgram( variant.second.m_object );
                 }
-
-                glDeleteProgram( m_object );
-                m_object = 0;
             }
+            m_variants.clear();
+            m_needCompile = true;
         }
 
         void Program::bind()
@@ -205,7 +426,7 @@ namespace di
             return result;
         }
 
-        GLint Program::getUniformLocation( const std::string& name ) const
+        GLint Program::getUniformLocation( const Uniform& uniform ) const
         {
             if( !isRealized() )
             {
@@ -213,7 +434,14 @@ namespace di
                 return 0;
             }
 
+            // The handle knows the location already if it was used with this link before.
+            if( ( m_link != 0 ) && ( uniform.m_link == m_link ) )
+            {
+                return uniform.m_location;
+            }
+
             GLint loc = -1;
+            const std::string& name = uniform.getName();
 
             // Check the cache if there is a location stored already
             if( !m_uniformLocationCache.count( name ) )
@@ -225,10 +453,9 @@ namespace di
                 {
                     LogE << "Could not locate uniform \"" << name << "\". Ensure the spelling is correct and you need to use the uniform in the "
                         << "shader code." << LogEnd;
-                    return -1;
                 }
 
-                // store.
+                // store. Missing ones too, to report them once.
                 m_uniformLocationCache[ name ] = loc;
             }
             else
@@ -236,6 +463,8 @@ namespace di
                 loc = m_uniformLocationCache[ name ];
             }
 
+            uniform.m_link = m_link;
+            uniform.m_location = loc;
             return loc;
         }
 
@@ -245,7 +474,6 @@ namespace di
             if( m_defines.erase( name ) )
             {
                 m_needCompile = true;
-                m_uniformLocationCache.clear();
             }
         }
 
@@ -268,7 +496,6 @@ namespace di
                 m_defines[ name ] = std::make_pair( defineOnly, value );
                 // LogD << "Defined " << name << " as \"" << value << "\" - " << defineOnly << LogEnd;
                 m_needCompile = true;
-                m_uniformLocationCache.clear();
             }
         }
     }
@@ -25,6 +25,7 @@
 #ifndef DI_PROGRAM_H
 #define DI_PROGRAM_H
 
+#include <cstdint>
 #include <initializer_list>
 #include <string>
 #include <sstream>
@@ -34,6 +35,7 @@
 #include <di/gfx/OpenGL.h>
 #include <di/gfx/GLBindable.h>
 #include <di/gfx/GLError.h>
+#include <di/gfx/Uniform.h>
 
 #include <di/Types.h>
 #include <di/GfxTypes.h>
@@ -45,7 +47,13 @@ namespace di
         class Shader;
 
         /**
-         * This class collects shaders and links the final program.
+         * This class collects shaders and links the final program. Linked programs are kept on disk by the \ref ProgramBinaryCache.
+         *
+         * Each set of defines is linked into its own program object, once. Switching back to a known set only changes the object used by bind().
+         * Uniform values belong to the object, so set them after bind(). Values set once, like sampler units, need setPersistentUniform() to
+         * get set again in the object of another define set when switching to it. Uniforms set each frame should use a \ref Uniform handle.
+         * Uniform blocks get the binding point of their name, see \ref UniformBuffer. Every shader gets the declaration of the
+         * \ref FrameUniforms block.
          */
         class Program: public GLBindable
         {
@@ -96,144 +104,143 @@ namespace di
             GLint getAttribLocation( const std::string& name ) const;
 
             /**
-             * Get the location of the given uniform.  This basically forwards to glGetUniformLocation.
+             * Get the location of the given uniform.  This basically forwards to glGetUniformLocation. The handle keeps the location as long as the
+             * same linked object is used.
              *
-             * \param name the uniform name
+             * \param uniform the uniform
              *
              * \return the location
              */
-            GLint getUniformLocation( const std::string& name ) const;
+            GLint getUniformLocation( const Uniform& uniform ) const;
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const int& value )
+            void setUniform( const Uniform& uniform, const int& value )
             {
                 // get location
-                glUniform1i( getUniformLocation( name ), value );
+                glUniform1i( getUniformLocation( uniform ), value );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const float& value )
+            void setUniform( const Uniform& uniform, const float& value )
             {
                 // get location
-                glUniform1f( getUniformLocation( name ), value );
+                glUniform1f( getUniformLocation( uniform ), value );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const double& value )
+            void setUniform( const Uniform& uniform, const double& value )
             {
-                // get location
-                glUniform1f( getUniformLocation( name ), value );
-                logGLError();
+                setUniform( uniform, static_cast< float >( value ) );
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const glm::mat4& value )
+            void setUniform( const Uniform& uniform, const glm::mat4& value )
             {
                 // get location
-                glUniformMatrix4fv( getUniformLocation( name ), 1, GL_FALSE, glm::value_ptr( value ) );
+                glUniformMatrix4fv( getUniformLocation( uniform ), 1, GL_FALSE, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              *
              * \return true if successful
              */
-            void setUniform( const std::string name, const glm::mat3& value )
+            void setUniform( const Uniform& uniform, const glm::mat3& value )
             {
                 // get location
-                glUniformMatrix3fv( getUniformLocation( name ), 1, GL_FALSE, glm::value_ptr( value ) );
+                glUniformMatrix3fv( getUniformLocation( uniform ), 1, GL_FALSE, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const glm::mat2& value )
+            void setUniform( const Uniform& uniform, const glm::mat2& value )
             {
                 // get location
-                glUniformMatrix2fv( getUniformLocation( name ), 1, GL_FALSE, glm::value_ptr( value ) );
+                glUniformMatrix2fv( getUniformLocation( uniform ), 1, GL_FALSE, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              *
              * \return true if successful
              */
-            void setUniform( const std::string name, const glm::vec4& value )
+            void setUniform( const Uniform& uniform, const glm::vec4& value )
             {
                 // get location
-                glUniform4fv( getUniformLocation( name ), 1, glm::value_ptr( value ) );
+                glUniform4fv( getUniformLocation( uniform ), 1, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const glm::vec3& value )
+            void setUniform( const Uniform& uniform, const glm::vec3& value )
             {
                 // get location
-                glUniform3fv( getUniformLocation( name ), 1, glm::value_ptr( value ) );
+                glUniform3fv( getUniformLocation( uniform ), 1, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const glm::vec2& value )
+            void setUniform( const Uniform& uniform, const glm::vec2& value )
             {
                 // get location
-                glUniform2fv( getUniformLocation( name ), 1, glm::value_ptr( value ) );
+                glUniform2fv( getUniformLocation( uniform ), 1, glm::value_ptr( value ) );
                 logGLError();
             }
 
             /**
              * Set the given value to the specified uniform. This version expects the vector to be adequately sized.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param value the value to set
              */
-            void setUniform( const std::string name, const std::vector< int >& values )
+            void setUniform( const Uniform& uniform, const std::vector< int >& values )
             {
-                glUniform1iv( getUniformLocation( name ), values.size(), values.data() );
+                glUniform1iv( getUniformLocation( uniform ), values.size(), values.data() );
                 logGLError();
             }
 
@@ -241,12 +248,12 @@ namespace di
              * Set the given value to the specified uniform. This version expects an arbitrary sized vector and automatically takes the desired number
              * of elements and fills missing elements with a default value.
              *
-             * \param name the name of the uniform
+             * \param uniform the uniform
              * \param values the value array
              * \param size the array size of the GLSL uniform
              * \param defaultValue if to few items where specified, use this default
              */
-            void setUniform( const std::string name, const std::vector< int >& values, size_t size, int defaultValue )
+            void setUniform( const Uniform& uniform, const std::vector< int >& values, size_t size, int defaultValue )
             {
                 // ensure a proper sized vector first:
                 std::vector< int > correct( size, defaultValue );
@@ -261,7 +268,68 @@ namespace di
                 }
 
                 // Forward
-                setUniform( name, correct );
+                setUniform( uniform, correct );
+            }
+
+            /**
+             * Set the given value to the specified uniform and keep it. Objects of other define sets get it when switching to them. Use this for
+             * values set once, outside of rendering, like sampler units. Values set every frame do not need it.
+             *
+             * \param uniform the uniform
+             * \param value the value to set
+             */
+            void setPersistentUniform( const Uniform& uniform, int value )
+            {
+                setUniform( uniform, value );
+                keepUniform( uniform, UniformType::Int, &value, 1 );
+            }
+
+            /**
+             * Set the given value to the specified uniform and keep it. See setPersistentUniform( const Uniform&, int ).
+             *
+             * \param uniform the uniform
+             * \param value the value to set
+             */
+            void setPersistentUniform( const Uniform& uniform, float value )
+            {
+                setUniform( uniform, value );
+                keepUniform( uniform, UniformType::Float, &value, 1 );
+            }
+
+            /**
+             * Set the given value to the specified uniform and keep it. See setPersistentUniform( const Uniform&, int ).
+             *
+             * \param uniform the uniform
+             * \param value the value to set
+             */
+            void setPersistentUniform( const Uniform& uniform, const glm::vec2& value )
+            {
+                setUniform( uniform, value );
+                keepUniform( uniform, UniformType::Vec2, glm::value_ptr( value ), 2 );
+            }
+
+            /**
+             * Set the given value to the specified uniform and keep it. See setPersistentUniform( const Uniform&, int ).
+             *
+             * \param uniform the uniform
+             * \param value the value to set
+             */
+            void setPersistentUniform( const Uniform& uniform, const glm::vec3& value )
+            {
+                setUniform( uniform, value );
+                keepUniform( uniform, UniformType::Vec3, glm::value_ptr( value ), 3 );
+            }
+
+            /**
+             * Set the given value to the specified uniform and keep it. See setPersistentUniform( const Uniform&, int ).
+             *
+             * \param uniform the uniform
+             * \param value the value to set
+             */
+            void setPersistentUniform( const Uniform& uniform, const glm::vec4& value )
+            {
+                setUniform( uniform, value );
+                keepUniform( uniform, UniformType::Vec4, glm::value_ptr( value ), 4 );
             }
 
             /**
@@ -294,6 +362,15 @@ namespace di
              */
             void unsetDefine( const std::string& name );
 
+            /**
+             * Bind a fragment shader output to a color number, like glBindFragDataLocation. Applies to all define sets. The next bind() relinks the
+             * program.
+             *
+             * \param colorNumber the color number, as used by glDrawBuffers
+             * \param name the name of the output
+             */
+            void bindFragDataLocation( GLuint colorNumber, const std::string& name );
+
         protected:
 
             /**
@@ -313,6 +390,59 @@ namespace di
              */
             virtual bool compileAndLink();
 
+            /**
+             * Register the linked object as the program of the given define set.
+             *
+             * \param prefixCode the defines as code
+             */
+            void addVariant( const std::string& prefixCode );
+
+            /**
+             * The function used to set a kept uniform value.
+             */
+            enum class UniformType
+            {
+                Int,
+                Float,
+                Vec2,
+                Vec3,
+                Vec4
+            };
+
+            /**
+             * Keep a value set by setPersistentUniform(), to set it again in the objects of other define sets.
+             *
+             * \param uniform the uniform
+             * \param type the function to set the value with
+             * \param values the values
+             * \param count the number of values
+             */
+            void keepUniform( const Uniform& uniform, UniformType type, const GLint* values, size_t count );
+
+            /**
+             * Keep a value set by setPersistentUniform(), to set it again in the objects of other define sets.
+             *
+             * \param uniform the uniform
+             * \param type the function to set the value with
+             * \param values the values
+             * \param count the number of values
+             */
+            void keepUniform( const Uniform& uniform, UniformType type, const GLfloat* values, size_t count );
+
+            /**
+             * Set all kept uniform values in the current object. Uniforms the object does not use are skipped.
+             */
+            void restoreUniforms();
+
+            /**
+             * Check whether the object belongs to a define set.
+             *
+             * \param object the program object
+             *
+             * \return true if it does
+             */
+            bool isVariant( GLuint object ) const;
+
             /**
              * The shader is attached to this program?
              *
@@ -323,6 +453,63 @@ namespace di
             bool isAttached( SPtr< Shader > shader );
 
         private:
+            /**
+             * The program of a define set.
+             */
+            struct Variant
+            {
+                /**
+                 * The linked program object.
+                 */
+                GLuint m_object = 0;
+
+                /**
+                 * The link number of the object. See m_link.
+                 */
+                uint64_t m_link = 0;
+
+                /**
+                 * The uniform locations queried so far.
+                 */
+                std::map< std::string, GLint > m_uniformLocations;
+            };
+
+            /**
+             * A value set by setPersistentUniform().
+             */
+            struct UniformValue
+            {
+                /**
+                 * The name of the uniform.
+                 */
+                std::string m_name;
+
+                /**
+                 * The function to set it with.
+                 */
+                UniformType m_type = UniformType::Int;
+
+                /**
+                 * The values of int uniforms.
+                 */
+                std::vector< GLint > m_ints;
+
+                /**
+                 * The values of float and vector uniforms.
+                 */
+                std::vector< GLfloat > m_floats;
+            };
+
+            /**
+             * Get the kept value of the given uniform. Adds it if not yet kept.
+             *
+             * \param uniform the uniform
+             * \param type the function to set the value with
+             *
+             * \return the kept value
+             */
+            UniformValue* keptUniform( const Uniform& uniform, UniformType type );
+
             /**
              * The shaders to attach.
              */
@@ -333,6 +520,11 @@ namespace di
              */
             bool m_needCompile = true;
 
+            /**
+             * The number of the link of m_object. Unique in the process, so that \ref Uniform handles notice a different object. 0 if not linked.
+             */
+            uint64_t m_link = 0;
+
             /**
              * Keep track of queried uniform locations to avoid this every frame.
              */
@@ -342,6 +534,27 @@ namespace di
              * Collect all definitions that need to be applied when compiling. Similar to the -D flag of compilers.
              */
             std::map< std::string, std::pair< bool, std::string > > m_defines;
+
+            /**
+             * The linked programs by defines as code. Switching between known define sets only switches the object.
+             */
+            std::map< std::string, Variant > m_variants;
+
+            /**
+             * The attribute locations of the first define set. Applied to all others.
+             */
+            std::map< std::string, GLint > m_attribLocations;
+
+            /**
+             * The fragment output locations set by bindFragDataLocation().
+             */
+            std::map< std::string, GLuint > m_fragDataLocations;
+
+            /**
+             * The last value set by setPersistentUniform() for each uniform. Objects linked later, or switched to, get them too. Only a few, so a
+             * vector.
+             */
+            std::vector< UniformValue > m_uniformValues;
         };
     }
 }
@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #include <process.h>
+    #define getpid _getpid
+#else
+    #include <unistd.h>
+#endif
+
+#include <di/core/Filesystem.h>
+#include <di/core/Trace.h>
+
+#include "ProgramBinaryCache.h"
+
+#include <di/gfx/GLError.h>
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/ProgramBinaryCache"
+
+namespace di
+{
+    namespace core
+    {
+        namespace
+        {
+            /**
+             * The cache directory. Set on first use.
+             */
+            std::string directory;
+
+            /**
+             * True once the directory was set.
+             */
+            bool directorySet = false;
+
+            /**
+             * Protects the directory.
+             */
+            std::mutex directoryMutex;
+
+            /**
+             * Number of programs loaded.
+             */
+            std::atomic< size_t > hits( 0 );
+
+            /**
+             * Number of programs stored.
+             */
+            std::atomic< size_t > misses( 0 );
+
+            /**
+             * Number of temporary files written by this process. Makes their names unique among the threads.
+             */
+            std::atomic< size_t > temporaries( 0 );
+
+            /**
+             * Check whether the context can provide program binaries at all.
+             *
+             * \return true if supported.
+             */
+            bool isSupported()
+            {
+                if( !( GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary ) )
+                {
+                    return false;
+                }
+
+                GLint formats = 0;
+                glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &formats );
+                logGLError();
+                return formats > 0;
+            }
+
+            /**
+             * Get the file of the binary of the given code. Binaries of different drivers are kept apart.
+             *
+             * \param code the code of the program
+             *
+             * \return the filename. Empty if the cache is disabled.
+             */
+            std::string getFilename( const std::string& code )
+            {
+                auto cacheDirectory = ProgramBinaryCache::getDirectory();
+                if( cacheDirectory.empty() )
+                {
+                    return "";
+                }
+
+                std::string key;
+                GLenum names[ 3 ] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+                for( size_t i = 0; i < 3; ++i )
+                {
+                    auto value = glGetString( names[ i ] );
+                    key += std::string( value ? reinterpret_cast< const char* >( value ) : "" ) + "\n";
+                }
+                key += code;
+
+                // 64 bit FNV-1a, like hashFile().
+                uint64_t hash = 14695981039346656037ull;
+                for( char c : key )
+                {
+                    hash ^= static_cast< uint8_t >( c );
+                    hash *= 1099511628211ull;
+                }
+
+                std::stringstream filename;
+                filename << cacheDirectory << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash << ".bin";
+                return filename.str();
+            }
+        }
+
+        void ProgramBinaryCache::setDirectory( const std::string& newDirectory )
+        {
+            std::lock_guard< std::mutex > lock( directoryMutex );
+            directory = newDirectory;
+            if( !directory.empty() && ( directory.back() != '/' ) && ( directory.back() != '\\' ) )
+            {
+                directory += "/";
+            }
+            directorySet = true;
+        }
+
+        std::string ProgramBinaryCache::getDirectory()
+        {
+            std::lock_guard< std::mutex > lock( directoryMutex );
+            if( !directorySet )
+            {
+                directory = getCachePath();
+                if( !directory.empty() )
+                {
+                    directory += "programs/";
+                }
+                directorySet = true;
+            }
+            return directory;
+        }
+
+        bool ProgramBinaryCache::load( GLuint program, const std::string& code )
+        {
+            if( !isSupported() )
+            {
+                return false;
+            }
+
+            auto filename = getFilename( code );
+            std::ifstream file( filename, std::ios::binary );
+            if( filename.empty() || !file.good() )
+            {
+                return false;
+            }
+
+            TraceSpan span( LogTag, "ProgramBinaryCache::load" );
+
+            GLenum format = 0;
+            file.read( reinterpret_cast< char* >( &format ), sizeof( format ) );
+            std::vector< char > binary;
+            if( file.good() )
+            {
+                binary.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+            }
+            if( binary.empty() )
+            {
+                LogW << "Program binary \"" << filename << "\" could not be read." << LogEnd;
+                return false;
+            }
+
+            glProgramBinary( program, format, binary.data(), binary.size() );
+            logGLError();
+
+            GLint success = GL_FALSE;
+            glGetProgramiv( program, GL_LINK_STATUS, &success );
+            if( success == GL_FALSE )
+            {
+                // Usually after driver updates.
+                LogD << "Program binary \"" << filename << "\" was rejected by the driver." << LogEnd;
+                return false;
+            }
+
+            ++hits;
+            return true;
+        }
+
+        void ProgramBinaryCache::prepareLink( GLuint program )
+        {
+            if( !isSupported() || getDirectory().empty() )
+            {
+                return;
+            }
+
+            glProgramParameteri( program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+            logGLError();
+        }
+
+        void ProgramBinaryCache::store( GLuint program, const std::string& code )
+        {
+            if( !isSupported() )
+            {
+                return;
+            }
+
+            auto filename = getFilename( code );
+            if( filename.empty() )
+            {
+                return;
+            }
+
+            GLint length = 0;
+            glGetProgramiv( program, GL_PROGRAM_BINARY_LENGTH, &length );
+            if( length <= 0 )
+            {
+                return;
+            }
+
+            GLenum format = 0;
+            std::vector< char > binary( length );
+            glGetProgramBinary( program, length, nullptr, &format, binary.data() );
+            logGLError();
+
+            if( !makeDirectories( getDirectory() ) )
+            {
+                LogW << "Could not create the program cache directory \"" << getDirectory() << "\"." << LogEnd;
+                return;
+            }
+
+            // Write and rename to avoid other processes reading incomplete binaries. Each writer needs its own temporary file for that.
+            std::string temporary = filename + "." + std::to_string( getpid() ) + "." + std::to_string( temporaries++ ) + ".tmp";
+            {
+                std::ofstream file( temporary, std::ios::binary );
+                file.write( reinterpret_cast< const char* >( &format ), sizeof( format ) );
+                file.write( binary.data(), binary.size() );
+                if( !file.good() )
+                {
+                    LogW << "Could not write the program binary \"" << temporary << "\"." << LogEnd;
+                    return;
+                }
+            }
+            // Renaming onto existing files fails on some platforms. Hence the second try.
+            if( ( std::rename( temporary.c_str(), filename.c_str() ) != 0 ) &&
+                ( ( std::remove( filename.c_str() ) != 0 ) || ( std::rename( temporary.c_str(), filename.c_str() ) != 0 ) ) )
+            {
+                LogW << "Could not write the program binary \"" << filename << "\"." << LogEnd;
+                std::remove( temporary.c_str() );
+                return;
+            }
+
+            ++misses;
+        }
+
+        size_t ProgramBinaryCache::getHits()
+        {
+            return hits;
+        }
+
+        size_t ProgramBinaryCache::getMisses()
+        {
+            return misses;
+        }
+    }
+}
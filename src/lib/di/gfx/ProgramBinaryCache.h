@@ -0,0 +1,111 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_PROGRAMBINARYCACHE_H
+#define DI_PROGRAMBINARYCACHE_H
+
+#include <cstddef>
+#include <string>
+
+#include <di/gfx/OpenGL.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Keeps linked programs on disk to skip compiling and linking them on the next start. A program is keyed by the driver and its code,
+         * including the defines. So each set of defines of a program gets its own binary. The driver rejects binaries it cannot use anymore.
+         * These are replaced after linking from source again.
+         *
+         * Used by Program. Requires OpenGL 4.1 or ARB_get_program_binary. Without, the cache does nothing. All calls require a current context.
+         */
+        class ProgramBinaryCache
+        {
+        public:
+            /**
+             * Set the directory to keep the binaries in. The default is "programs/" in \ref getCachePath.
+             *
+             * \param directory the directory. Empty to disable the cache.
+             */
+            static void setDirectory( const std::string& directory );
+
+            /**
+             * The directory to keep the binaries in.
+             *
+             * \return the directory. Empty if disabled.
+             */
+            static std::string getDirectory();
+
+            /**
+             * Load the binary of a program with the given code. On success, the program is linked and ready to use.
+             *
+             * \param program the program object
+             * \param code the code of all shaders and defines of the program
+             *
+             * \return true if the binary was loaded.
+             */
+            static bool load( GLuint program, const std::string& code );
+
+            /**
+             * Call before linking the program to be stored. Allows the driver to keep the binary.
+             *
+             * \param program the program object
+             */
+            static void prepareLink( GLuint program );
+
+            /**
+             * Store the binary of a linked program with the given code.
+             *
+             * \param program the program object
+             * \param code the code of all shaders and defines of the program
+             */
+            static void store( GLuint program, const std::string& code );
+
+            /**
+             * The number of programs loaded from binary.
+             *
+             * \return the number of hits
+             */
+            static size_t getHits();
+
+            /**
+             * The number of programs linked from source and stored.
+             *
+             * \return the number of misses
+             */
+            static size_t getMisses();
+
+        protected:
+        private:
+            /**
+             * No instances.
+             */
+            ProgramBinaryCache() = delete;
+        };
+    }
+}
+
+#endif  // DI_PROGRAMBINARYCACHE_H
+
@@ -31,9 +31,10 @@
 
 #include <di/core/StringUtils.h>
 
+#include <di/gfx/GLError.h>
+
 #include <di/core/Logger.h>
 #define LogTag "gfx/Shader"
-#include <di/gfx/GLError.h>
 
 namespace di
 {
@@ -62,6 +63,16 @@ namespace di
             }
         }
 
+        Shader::ShaderType Shader::getShaderType() const
+        {
+            return m_shaderType;
+        }
+
+        const std::string& Shader::getCode() const
+        {
+            return m_code;
+        }
+
         bool Shader::compile()
         {
             if( !isRealized() )
@@ -86,6 +86,20 @@ namespace di
              */
             void setPrefixCode( const std::string& code );
 
+            /**
+             * The type of this shader.
+             *
+             * \return the type
+             */
+            ShaderType getShaderType() const;
+
+            /**
+             * The code of the shader, without prefix code.
+             *
+             * \return the code
+             */
+            const std::string& getCode() const;
+
         protected:
             /**
              * Compile the shader.
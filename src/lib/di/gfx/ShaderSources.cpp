@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <di/core/Filesystem.h>
+
+#include "ShaderSources.h"
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/ShaderSources"
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * The shaders embedded by the build system, by name. See GENERATE_EMBEDDED_SHADERS.
+         *
+         * \return the shaders
+         */
+        const std::map< std::string, std::string >& getEmbeddedShaders();
+
+        namespace
+        {
+            /**
+             * The code of all shaders requested so far, by name.
+             */
+            std::map< std::string, std::string > sources;
+
+            /**
+             * Protects the sources.
+             */
+            std::mutex sourcesMutex;
+        }
+
+        std::string ShaderSources::get( const std::string& name )
+        {
+            std::lock_guard< std::mutex > lock( sourcesMutex );
+
+            auto found = sources.find( name );
+            if( found != sources.end() )
+            {
+                return found->second;
+            }
+
+            auto embedded = getEmbeddedShaders().find( name );
+            if( embedded != getEmbeddedShaders().end() )
+            {
+                sources[ name ] = embedded->second;
+                return embedded->second;
+            }
+
+            LogD << "Shader \"" << name << "\" is not embedded. Reading it from the resource directory." << LogEnd;
+            auto code = readTextFile( getResourcePath() + name );
+            sources[ name ] = code;
+            return code;
+        }
+
+        void ShaderSources::reload()
+        {
+            std::lock_guard< std::mutex > lock( sourcesMutex );
+
+            for( auto source = sources.begin(); source != sources.end(); ++source )
+            {
+                try
+                {
+                    source->second = readTextFile( getResourcePath() + source->first );
+                }
+                catch( const std::invalid_argument& e )
+                {
+                    LogD << "Keeping the code of shader \"" << source->first << "\". " << e.what() << LogEnd;
+                }
+            }
+            LogI << "Reloaded " << sources.size() << " shaders." << LogEnd;
+        }
+    }
+}
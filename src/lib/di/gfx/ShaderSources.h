@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_SHADERSOURCES_H
+#define DI_SHADERSOURCES_H
+
+#include <string>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * Provides the code of shaders by name. The name is the path of the shader relative to the resource directory, like
+         * "algorithms/shaders/Shading.glsl". The build system embeds all shaders of the library, so they are available without reading any file.
+         * Other shaders are read from the resource directory once and kept in memory.
+         *
+         * To edit shaders while the application runs, call reload() and build the programs again. All calls are thread-safe.
+         *
+         * \code
+         * auto shader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
+         *                                                 core::ShaderSources::get( "algorithms/shaders/Shading.glsl" ) );
+         * \endcode
+         */
+        class ShaderSources
+        {
+        public:
+            /**
+             * Get the code of a shader.
+             *
+             * \param name the name of the shader. Its path relative to the resource directory.
+             *
+             * \return the code
+             *
+             * \throw std::invalid_argument if the shader is neither embedded nor in the resource directory.
+             */
+            static std::string get( const std::string& name );
+
+            /**
+             * Replace the code of all shaders by the files in the resource directory, where they exist. The embedded code is kept for the others.
+             */
+            static void reload();
+
+        protected:
+        private:
+            /**
+             * No instances.
+             */
+            ShaderSources() = delete;
+        };
+    }
+}
+
+#endif  // DI_SHADERSOURCES_H
+
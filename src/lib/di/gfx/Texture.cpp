@@ -24,9 +24,10 @@
 
 #include "Texture.h"
 
+#include <di/gfx/GLError.h>
+
 #include <di/core/Logger.h>
 #define LogTag "gfx/Texture"
-#include <di/gfx/GLError.h>
 
 namespace di
 {
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#ifndef DI_UNIFORM_H
+#define DI_UNIFORM_H
+
+#include <cstdint>
+#include <string>
+
+#include <di/gfx/OpenGL.h>
+
+namespace di
+{
+    namespace core
+    {
+        class Program;
+
+        /**
+         * A handle to a uniform, used with \ref Program::setUniform. It remembers the location of the uniform in the program it was last used
+         * with. Keep a handle per uniform that is set each frame to avoid looking it up by name, like:
+         *
+         * \code
+         * core::Uniform m_uSpecularity = "u_specularity";
+         * ...
+         * m_program->bind();
+         * m_program->setUniform( m_uSpecularity, 0.5f );
+         * \endcode
+         *
+         * Names convert implicitly, so a plain string works too. It is looked up in the uniform location cache of the program then.
+         */
+        class Uniform
+        {
+            friend class Program;
+        public:
+            /**
+             * Create a handle to the uniform with the given name.
+             *
+             * \param name the name of the uniform
+             */
+            Uniform( const char* name ):  // NOLINT: implicit on purpose
+                m_name( name )
+            {
+            }
+
+            /**
+             * Create a handle to the uniform with the given name.
+             *
+             * \param name the name of the uniform
+             */
+            Uniform( const std::string& name ):  // NOLINT: implicit on purpose
+                m_name( name )
+            {
+            }
+
+            /**
+             * The name of the uniform.
+             *
+             * \return the name
+             */
+            const std::string& getName() const
+            {
+                return m_name;
+            }
+
+        private:
+            /**
+             * The name of the uniform.
+             */
+            std::string m_name;
+
+            /**
+             * The link of the program m_location belongs to. Each link of a \ref Program gets its own number. 0 if not yet located.
+             */
+            mutable uint64_t m_link = 0;
+
+            /**
+             * The location in the program of m_link.
+             */
+            mutable GLint m_location = -1;
+        };
+    }
+}
+
+#endif  // DI_UNIFORM_H
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <di/core/Trace.h>
+
+#include "UniformBuffer.h"
+
+#include <di/gfx/GLError.h>
+
+#include <di/core/Logger.h>
+#define LogTag "gfx/UniformBuffer"
+
+namespace di
+{
+    namespace core
+    {
+        UniformBuffer::UniformBuffer( const std::string& blockName ):
+            Buffer( BufferType::Uniform ),
+            m_blockName( blockName ),
+            m_bindingPoint( getBindingPoint( blockName ) )
+        {
+        }
+
+        UniformBuffer::~UniformBuffer()
+        {
+            // Buffer cleans up.
+        }
+
+        void UniformBuffer::bind()
+        {
+            // Binds to the generic target too. This is what data() uses.
+            glBindBufferBase( GL_UNIFORM_BUFFER, m_bindingPoint, m_object );
+            logGLError();
+        }
+
+        void UniformBuffer::data( size_t size, const void* ptr )
+        {
+            TraceSpan span( LogTag, "UniformBuffer::data" );
+            span.setArgument( "bytes", static_cast< double >( size ) );
+
+            glBufferData( GL_UNIFORM_BUFFER, size, ptr, GL_DYNAMIC_DRAW );
+            logGLError();
+        }
+
+        const std::string& UniformBuffer::getBlockName() const
+        {
+            return m_blockName;
+        }
+
+        GLuint UniformBuffer::getBindingPoint( const std::string& blockName )
+        {
+            static std::mutex mutex;
+            static std::map< std::string, GLuint > bindingPoints;
+
+            std::lock_guard< std::mutex > lock( mutex );
+            auto found = bindingPoints.find( blockName );
+            if( found != bindingPoints.end() )
+            {
+                return found->second;
+            }
+
+            // OpenGL guarantees at least 36 of them.
+            GLuint point = bindingPoints.size();
+            if( point >= 36 )
+            {
+                LogW << "Uniform block \"" << blockName << "\" gets binding point " << point << ". This might exceed the limit of the driver."
+                     << LogEnd;
+            }
+            bindingPoints[ blockName ] = point;
+            return point;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#ifndef DI_UNIFORMBUFFER_H
+#define DI_UNIFORMBUFFER_H
+
+#include <string>
+
+#include <di/gfx/OpenGL.h>
+#include <di/gfx/Buffer.h>
+
+namespace di
+{
+    namespace core
+    {
+        /**
+         * A buffer providing the values of a uniform block, declared as "layout( std140 ) uniform <name> { ... };" in GLSL. Each block name gets
+         * its own binding point. Programs get their blocks assigned to these points when linked, so binding the buffer once makes it available
+         * to all programs.
+         */
+        class UniformBuffer: public Buffer
+        {
+        public:
+            /**
+             * Create the buffer of the given block. Not yet filled with anything.
+             *
+             * \param blockName the name of the uniform block in GLSL
+             */
+            explicit UniformBuffer( const std::string& blockName );
+
+            /**
+             * Destructor.
+             */
+            virtual ~UniformBuffer();
+
+            /**
+             * Bind the buffer to the binding point of its block.
+             */
+            void bind() override;
+
+            // Keep the container versions of Buffer.
+            using Buffer::data;
+
+            /**
+             * Commit data to this buffer. Expects the std140 layout of the block. The buffer is meant to be updated often.
+             *
+             * \param size the size of the buffer
+             * \param ptr the data pointer.
+             */
+            void data( size_t size, const void* ptr ) override;
+
+            /**
+             * The name of the block.
+             *
+             * \return the name
+             */
+            const std::string& getBlockName() const;
+
+            /**
+             * Get the binding point of a block. Known names keep their point, new ones get the next one. The same in all contexts.
+             *
+             * \param blockName the name of the uniform block in GLSL
+             *
+             * \return the binding point
+             */
+            static GLuint getBindingPoint( const std::string& blockName );
+
+        private:
+            /**
+             * The name of the block.
+             */
+            std::string m_blockName;
+
+            /**
+             * The binding point of the block.
+             */
+            GLuint m_bindingPoint;
+        };
+    }
+}
+
+#endif  // DI_UNIFORMBUFFER_H
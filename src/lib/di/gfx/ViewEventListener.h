@@ -25,6 +25,7 @@
 #ifndef DI_VIEWEVENTLISTENER_H
 #define DI_VIEWEVENTLISTENER_H
 
+#include <functional>
 #include <utility>
 #include <vector>
 #include <mutex>
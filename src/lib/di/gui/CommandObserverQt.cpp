@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <string>
 
 #include <QCoreApplication>
 
@@ -92,6 +93,13 @@ namespace di
             QCoreApplication::postEvent( m_receiver, new CommandObserverEvent( shared_from_this(), command, CommandObserverEvent::FAIL ) );
         }
 
+        void CommandObserverQt::progress( SPtr< di::core::Command > command, const std::string& stage, double fraction, double remaining )
+        {
+            // the shared_from_this creates a shared_ptr of this instance. This ensures that the observer is valid as long as the event is in the Qt
+            // queue ...
+            QCoreApplication::postEvent( m_receiver, new CommandObserverEvent( shared_from_this(), command, stage, fraction, remaining ) );
+        }
+
         void CommandObserverQt::notify()
         {
             // the shared_from_this creates a shared_ptr of this instance. This ensures that the observer is valid as long as the event is in the Qt
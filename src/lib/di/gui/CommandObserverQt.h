@@ -28,6 +28,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <string>
 
 #include <QWidget>
 
@@ -103,6 +104,16 @@ namespace di
              */
             virtual void fail( SPtr< di::core::Command > command );
 
+            /**
+             * Called while the command is busy to report its progress.
+             *
+             * \param command the command that issued this notification.
+             * \param stage a human readable description of what is going on right now.
+             * \param fraction the progress of the stage in [0,1].
+             * \param remaining the estimated remaining time of the stage in seconds. Negative if unknown.
+             */
+            virtual void progress( SPtr< di::core::Command > command, const std::string& stage, double fraction, double remaining );
+
             /**
              * Notification. Implemented using QEvents
              */
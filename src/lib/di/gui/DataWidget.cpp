@@ -80,6 +80,11 @@ namespace di
             m_contentLayout->addWidget( widget );
         }
 
+        void DataWidget::addWidget( QWidget* widget )
+        {
+            m_contentLayout->addWidget( widget );
+        }
+
         void DataWidget::prepareProcessingNetwork()
         {
             // forward
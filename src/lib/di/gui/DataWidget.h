@@ -71,6 +71,13 @@ namespace di
              */
             void addFileWidget( FileWidget* widget );
 
+            /**
+             * Add a widget below the file widgets, like a \ref LabelSeriesWidget.
+             *
+             * \param widget the widget to add
+             */
+            void addWidget( QWidget* widget );
+
             /**
              * Allows this widget to prepare everything in the network. This is only a temporary solution.
              */
@@ -22,11 +22,14 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <string>
+
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QToolButton>
 #include <QFileDialog>
 #include <QDir>
+#include <QFileInfo>
 
 #include <di/gui/Application.h>
 #include <di/gui/ScaleLabel.h>
@@ -254,6 +257,13 @@ namespace di
         {
             load( QString::fromStdString( filename ) );
         }
+
+        void FileWidget::inject( ConstSPtr< di::core::ConnectorTransferable > data, const std::string& filename )
+        {
+            m_currentFile = QString::fromStdString( filename );
+            m_fileLoadLabel->setText( QFileInfo( m_currentFile ).fileName() );
+            m_dataInject->inject( data );
+        }
     }
 }
 
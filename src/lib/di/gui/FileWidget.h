@@ -149,6 +149,15 @@ namespace di
              */
             virtual void load( const std::string& filename );
 
+            /**
+             * Inject data that was loaded elsewhere, like a frame of a \ref di::io::LabelSeries. It replaces the data of this widget and is
+             * stored as its file.
+             *
+             * \param data the data
+             * \param filename the file the data comes from
+             */
+            virtual void inject( ConstSPtr< di::core::ConnectorTransferable > data, const std::string& filename );
+
         protected:
             /**
              * Event handler. We use it to handle \ref CommandObserverQt updates.
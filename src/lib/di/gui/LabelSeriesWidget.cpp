@@ -0,0 +1,215 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#include <exception>
+#include <string>
+#include <vector>
+
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include <di/gui/Application.h>
+#include <di/gui/FileWidget.h>
+#include <di/gui/ScaleLabel.h>
+
+#include <di/core/Trace.h>
+
+#include "LabelSeriesWidget.h"
+
+#include <di/core/Logger.h>
+#define LogTag "gui/LabelSeriesWidget"
+
+namespace di
+{
+    namespace gui
+    {
+        LabelSeriesWidget::LabelSeriesWidget( FileWidget* labels, size_t prefetch, QWidget* parent ):
+            QWidget( parent ),
+            m_labels( labels ),
+            m_prefetch( prefetch )
+        {
+            QVBoxLayout* layout( new QVBoxLayout );
+            setLayout( layout );
+            layout->setMargin( 5 );
+
+            auto titleLabel = new ScaleLabel;
+            titleLabel->setText( tr( "Label Series" ) );
+            titleLabel->setStyleSheet( "font-weight:bold;" );
+            layout->addWidget( titleLabel );
+
+            QHBoxLayout* controls( new QHBoxLayout );
+            layout->addLayout( controls );
+
+            m_loadBtn = new QToolButton;
+            m_loadBtn->setText( tr( "Load" ) );
+            m_loadBtn->setToolTip( "Load a list of label files, one per line. Each file is a frame." );
+            controls->addWidget( m_loadBtn );
+
+            m_playBtn = new QToolButton;
+            m_playBtn->setText( tr( "Play" ) );
+            m_playBtn->setEnabled( false );
+            controls->addWidget( m_playBtn );
+
+            m_timeline = new QSlider( Qt::Horizontal );
+            m_timeline->setEnabled( false );
+            m_timeline->setRange( 0, 0 );
+            controls->addWidget( m_timeline );
+
+            m_frameLabel = new ScaleLabel;
+            m_frameLabel->setText( tr( "No Series Loaded" ) );
+            layout->addWidget( m_frameLabel );
+
+            // At most 10 frames per second. Slower if the network takes longer.
+            m_playTimer = new QTimer( this );
+            m_playTimer->setInterval( 100 );
+
+            connect( m_loadBtn, SIGNAL( clicked( bool ) ), this, SLOT( loadList() ) );
+            connect( m_playBtn, SIGNAL( clicked( bool ) ), this, SLOT( togglePlayback() ) );
+            connect( m_timeline, SIGNAL( valueChanged( int ) ), this, SLOT( frameSelected( int ) ) );
+            connect( m_playTimer, SIGNAL( timeout() ), this, SLOT( nextFrame() ) );
+        }
+
+        LabelSeriesWidget::~LabelSeriesWidget()
+        {
+        }
+
+        void LabelSeriesWidget::loadList()
+        {
+            QString lastPath = Application::getSettings()->value( "LastFilePath", "" ).toString();
+            QString selected = QFileDialog::getOpenFileName( this, "Load Label Series", lastPath, "Label Series (*.txt *.series);;All Files (*.*)" );
+            if( selected == "" )
+            {
+                return;
+            }
+            Application::getSettings()->setValue( "LastFilePath", QFileInfo( selected ).path() );
+
+            load( selected.toStdString() );
+        }
+
+        void LabelSeriesWidget::load( const std::string& filename )
+        {
+            stop();
+
+            std::vector< std::string > files;
+            try
+            {
+                files = di::io::LabelSeries::readList( filename );
+            }
+            catch( const std::exception& e )
+            {
+                LogE << e.what() << LogEnd;
+                m_frameLabel->setText( "Failed: " + QString::fromStdString( e.what() ) );
+                return;
+            }
+            if( files.empty() )
+            {
+                m_frameLabel->setText( tr( "The series is empty" ) );
+                return;
+            }
+
+            m_series = std::make_shared< di::io::LabelSeries >( files, m_prefetch );
+            m_playBtn->setEnabled( files.size() > 1 );
+            m_timeline->setEnabled( files.size() > 1 );
+
+            // Does not emit valueChanged if already 0.
+            m_timeline->blockSignals( true );
+            m_timeline->setRange( 0, files.size() - 1 );
+            m_timeline->setValue( 0 );
+            m_timeline->blockSignals( false );
+            showFrame( 0 );
+        }
+
+        void LabelSeriesWidget::showFrame( size_t frame )
+        {
+            if( !m_series )
+            {
+                return;
+            }
+
+            core::TraceSpan span( LogTag, "Frame " + std::to_string( frame ) );
+            ConstSPtr< di::io::RegionLabelReader::DataSetType > labels;
+            try
+            {
+                // Blocks if the frame was not prefetched.
+                labels = m_series->getFrame( frame );
+            }
+            catch( const std::exception& e )
+            {
+                LogE << "Could not load frame " << frame << " from \"" << m_series->getFile( frame ) << "\": " << e.what() << LogEnd;
+                m_frameLabel->setText( "Failed: " + QString::fromStdString( e.what() ) );
+                stop();
+                return;
+            }
+
+            m_frameLabel->setText( tr( "Frame %1 of %2" ).arg( frame + 1 ).arg( m_series->getNumFrames() ) );
+            m_labels->inject( labels, m_series->getFile( frame ) );
+
+            // Commands run in order. The callback thus comes after the network run caused by the injection.
+            m_frameInFlight = true;
+            Application::getProcessingNetwork()->callback( Application::getInstance()->runInUIThread(
+                [ this ]()
+                {
+                    m_frameInFlight = false;
+                }
+            ) );
+        }
+
+        void LabelSeriesWidget::frameSelected( int frame )
+        {
+            showFrame( frame );
+        }
+
+        void LabelSeriesWidget::togglePlayback()
+        {
+            if( m_playTimer->isActive() )
+            {
+                stop();
+                return;
+            }
+
+            m_playBtn->setText( tr( "Pause" ) );
+            m_playTimer->start();
+        }
+
+        void LabelSeriesWidget::stop()
+        {
+            m_playTimer->stop();
+            m_playBtn->setText( tr( "Play" ) );
+        }
+
+        void LabelSeriesWidget::nextFrame()
+        {
+            if( !m_series || m_frameInFlight )
+            {
+                return;
+            }
+
+            // Emits valueChanged and thus shows the frame.
+            m_timeline->setValue( ( m_timeline->value() + 1 ) % m_series->getNumFrames() );
+        }
+    }
+}
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+
+#ifndef DI_LABELSERIESWIDGET_H
+#define DI_LABELSERIESWIDGET_H
+
+#include <string>
+
+#include <QSlider>
+#include <QTimer>
+#include <QToolButton>
+#include <QWidget>
+
+#include <di/io/LabelSeries.h>
+
+#include <di/Types.h>
+
+namespace di
+{
+    namespace gui
+    {
+        class FileWidget;
+        class ScaleLabel;
+
+        /**
+         * Plays a time series of label files, like longitudinal or dynamic parcellations. The frames are loaded ahead by a \ref
+         * di::io::LabelSeries and injected into the network through the file widget of the labels. The timeline selects a frame. Playback only
+         * advances once the network processed the previous frame, so slow frames are shown instead of skipped.
+         */
+        class LabelSeriesWidget: public QWidget
+        {
+            Q_OBJECT
+        public:
+            /**
+             * Create the widget.
+             *
+             * \param labels the file widget whose data gets replaced by the frames
+             * \param prefetch the number of frames to load ahead
+             * \param parent the parent widget
+             */
+            explicit LabelSeriesWidget( FileWidget* labels, size_t prefetch = 2, QWidget* parent = nullptr );
+
+            /**
+             * Destroy and clean up.
+             */
+            virtual ~LabelSeriesWidget();
+
+            /**
+             * Load a series and show its first frame.
+             *
+             * \param filename the list of label files, see \ref di::io::LabelSeries::readList.
+             */
+            void load( const std::string& filename );
+
+            /**
+             * Inject the given frame into the network.
+             *
+             * \param frame the frame
+             */
+            void showFrame( size_t frame );
+
+        private slots:
+            /**
+             * Ask for a series file and load it.
+             */
+            void loadList();
+
+            /**
+             * Start or stop playback.
+             */
+            void togglePlayback();
+
+            /**
+             * The timeline was moved.
+             *
+             * \param frame the selected frame
+             */
+            void frameSelected( int frame );
+
+            /**
+             * Advance to the next frame if the network processed the current one. Wraps around at the end.
+             */
+            void nextFrame();
+
+        private:
+            /**
+             * Stop playback.
+             */
+            void stop();
+
+            /**
+             * The file widget of the labels.
+             */
+            FileWidget* m_labels = nullptr;
+
+            /**
+             * Number of frames to load ahead.
+             */
+            size_t m_prefetch;
+
+            /**
+             * The series. Null if none was loaded.
+             */
+            SPtr< di::io::LabelSeries > m_series = nullptr;
+
+            /**
+             * Loads a series.
+             */
+            QToolButton* m_loadBtn = nullptr;
+
+            /**
+             * Starts and stops playback.
+             */
+            QToolButton* m_playBtn = nullptr;
+
+            /**
+             * The timeline.
+             */
+            QSlider* m_timeline = nullptr;
+
+            /**
+             * Shows the current frame.
+             */
+            ScaleLabel* m_frameLabel = nullptr;
+
+            /**
+             * Triggers the next frame during playback.
+             */
+            QTimer* m_playTimer = nullptr;
+
+            /**
+             * True while the network did not yet process the injected frame.
+             */
+            bool m_frameInFlight = false;
+        };
+    }
+}
+
+#endif  // DI_LABELSERIESWIDGET_H
@@ -22,14 +22,18 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <cmath>
+
 #include <QMainWindow>
 #include <QMenuBar>
 #include <QAction>
 #include <QFileDialog>
 #include <QDir>
 #include <QMessageBox>
+#include <QStatusBar>
 
 #include <di/gui/events/CallbackEvent.h>
+#include <di/gui/events/Events.h>
 
 #include <di/gui/Application.h>
 
@@ -207,6 +211,36 @@ namespace di
                 ce->call();
                 return true;
             }
+
+            // Show the progress of network runs in the status bar.
+            if( event->type() == QT_COMMANDOBSERVER_EVENT )
+            {
+                CommandObserverEvent* coe = dynamic_cast< CommandObserverEvent* >( event );
+                switch( coe->getObserverStatus() )
+                {
+                    case CommandObserverEvent::PROGRESS:
+                    {
+                        QString message = QString::fromStdString( coe->getProgressStage() ) +
+                                          QString( " - %1%" ).arg( static_cast< int >( coe->getProgressFraction() * 100.0 ) );
+                        if( coe->getProgressRemaining() >= 0.0 )
+                        {
+                            message += QString( " - about %1s left" ).arg( std::ceil( coe->getProgressRemaining() ) );
+                        }
+                        statusBar()->showMessage( message );
+                        break;
+                    }
+                    case CommandObserverEvent::BUSY:
+                        statusBar()->showMessage( QString::fromStdString( coe->getIssuer()->getName() ) );
+                        break;
+                    case CommandObserverEvent::FAIL:
+                        statusBar()->showMessage( "Failed: " + QString::fromStdString( coe->getIssuer()->getFailureReason() ) );
+                        break;
+                    default:
+                        statusBar()->clearMessage();
+                        break;
+                }
+                return true;
+            }
             return QMainWindow::event( event );
         }
     }
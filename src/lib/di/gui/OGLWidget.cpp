@@ -29,11 +29,15 @@
 
 #include <QMouseEvent>
 
-#include <di/core/Filesystem.h>
 #include <di/core/BoundingBox.h>
 #include <di/core/State.h>
+#include <di/core/Algorithm.h>
+#include <di/core/AllocationTracker.h>
+#include <di/core/Trace.h>
+#include <di/core/FrameStatistics.h>
 #include <di/gfx/GL.h>
 #include <di/gfx/OffscreenView.h>
+#include <di/gfx/ShaderSources.h>
 #include <di/MathTypes.h>
 #include <di/GfxTypes.h>
 #include <di/gfx/ViewEvent.h>
@@ -50,6 +54,28 @@ namespace di
 {
     namespace gui
     {
+        namespace
+        {
+            /**
+             * Build the name of a trace span for a visualization call. Returns an empty string if tracing is disabled to keep the frame cheap.
+             *
+             * \param vis the visualization
+             * \param call the called method
+             *
+             * \return the name
+             */
+            std::string getTraceName( SPtr< di::core::Visualization > vis, const std::string& call )
+            {
+                if( !core::Trace::isEnabled() )
+                {
+                    return "";
+                }
+
+                auto algorithm = std::dynamic_pointer_cast< core::Algorithm >( vis );
+                return ( algorithm ? algorithm->getName() : std::string( "Visualization" ) ) + "::" + call;
+            }
+        }
+
         OGLWidget::OGLWidget( QWidget* parent ):
             QGLWidget( getDefaultFormat(), parent ),
             core::View()
@@ -126,11 +152,11 @@ namespace di
             // Set the data
             glBufferData( GL_ARRAY_BUFFER, 2 * 9 * sizeof( float ), points, GL_STATIC_DRAW );
 
-            std::string localShaderPath = core::getResourcePath() + "/gfx/shaders/";
+            std::string localShaderPath = "gfx/shaders/";
             m_bgVertexShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Vertex,
-                                                               core::readTextFile( localShaderPath + "CameraEffectHorizon-vertex.glsl" ) );
+                                                               core::ShaderSources::get( localShaderPath + "CameraEffectHorizon-vertex.glsl" ) );
             m_bgFragmentShader = std::make_shared< core::Shader >( core::Shader::ShaderType::Fragment,
-                                                                 core::readTextFile( localShaderPath + "CameraEffectHorizon-fragment.glsl" ) );
+                                                                 core::ShaderSources::get( localShaderPath + "CameraEffectHorizon-fragment.glsl" ) );
 
             // Link them to build the program itself
             // m_bgShaderProgram = std::make_shared< di::core::Program >( { m_bgVertexShader, m_bgFragmentShader } );
@@ -189,6 +215,9 @@ namespace di
                 {
                     if( vis->isRenderingActive() )
                     {
+                        auto name = getTraceName( vis, "update" );
+                        core::TraceSpan span( LogTag, name );
+                        core::AllocationScope allocations( name );
                         view->bind();
                         vis->update( *view, m_forceReload );
                     }
@@ -251,12 +280,14 @@ namespace di
             glEnable( GL_BLEND );
             glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
             glEnable( GL_DEPTH_TEST );
+            m_frameUniforms.update( *view );
 
             Application::getProcessingNetwork()->visitVisualizations(
                 [ view ]( SPtr< di::core::Visualization > vis )
                 {
                     if( vis->isRenderingActive() )
                     {
+                        core::TraceSpan span( LogTag, getTraceName( vis, "render" ) );
                         view->bind();
                         vis->render( *view );
                     }
@@ -266,17 +297,26 @@ namespace di
 
         void OGLWidget::paintGL()
         {
+            core::TraceSpan frameSpan( LogTag, "Frame" );
+
             auto now = std::chrono::system_clock::now();
-            auto duration = std::chrono::duration_cast< std::chrono::milliseconds >( now - m_fpsLastTime );
+            auto duration = std::chrono::duration< double, std::milli >( now - m_fpsLastTime );
             auto durationLastShow = std::chrono::duration_cast< std::chrono::milliseconds >( now - m_fpsLastShowTime );
-            m_fpsLastTime = now;
 
-            float fps = 1000.0 / static_cast< float >( duration.count() );
+            // The interval includes the idle time between redraws. The CPU time of the frame itself gets recorded at the end.
+            if( m_fpsLastTime.time_since_epoch().count() != 0 )
+            {
+                core::FrameStatistics::record( "Frame/interval", duration.count() );
+            }
+            m_fpsLastTime = now;
 
             if( durationLastShow.count() >= 2000 )
             {
                 m_fpsLastShowTime = now;
-                LogI << "FPS " << fps << LogEnd;
+                auto interval = core::FrameStatistics::get( "Frame/interval" );
+                auto cpu = core::FrameStatistics::get( "Frame/cpu" );
+                LogI << "FPS " << ( interval.m_p50 > 0.0 ? 1000.0 / interval.m_p50 : 0.0 )
+                     << " - Frame time p50: " << cpu.m_p50 << " ms, p99: " << cpu.m_p99 << " ms." << LogEnd;
             }
 
             /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -447,6 +487,9 @@ namespace di
             {
                 renderToView( this );
             }
+
+            core::FrameStatistics::record( "Frame/cpu",
+                                           std::chrono::duration< double, std::milli >( std::chrono::system_clock::now() - now ).count() );
         }
 
         void OGLWidget::bind() const
@@ -470,6 +513,7 @@ namespace di
             );
 
             // Clean up properly
+            m_frameUniforms.finalize();
             glDeleteBuffers( 1, &m_backgroundVBO );
             // glDeleteVertexArrays( 1, &m_backgroundVAO );
             // glDeleteProgram( m_backgroundShaderProgram );
@@ -573,7 +617,8 @@ namespace di
             switch( event->key() )
             {
                 case Qt::Key_Period:
-                    // forced reload
+                    // forced reload. Use the shader files to allow editing them.
+                    core::ShaderSources::reload();
                     m_forceReload = true;
                     break;
                 case Qt::Key_F12:
@@ -713,39 +758,12 @@ namespace di
 
         glm::mat4 OGLWidget::buildViewMatrix( const core::BoundingBox& sceneBB, const glm::mat4& orientation, float zoom, const glm::vec2& drag )
         {
-            double near = 0.3; // the near plane
-            // double far = zoom * sqrt( 3.0 ) + near;    // the diagonal of the cube needs to fit (sqrt(3))
-            if( sceneBB.isValid() )
-            {
-                // Calculate scene
-                double maxExtend = sqrt( 3.0 ) *
-                                   std::max( sceneBB.getSize().x,
-                                             std::max( sceneBB.getSize().y,
-                                                       sceneBB.getSize().z ) );
-
-                // Move scene to rotation point
-                glm::mat4 rotationPointTranslate = glm::translate( -sceneBB.getCenter() );
-                // Scale scene down to match screen size. The scene is now inside a unit sized cube
-                glm::mat4 scaleToFit = glm::scale( glm::vec3( 1.0 / ( 1.0 * maxExtend ) ) );
-                // Zoom
-                glm::mat4 zoomMatrix = glm::scale( glm::vec3( zoom ) );
-
-                // move scene into the visible area
-                glm::mat4 moveToVisibleArea = glm::translate( glm::vec3( 0.0, 0.0, -( zoom * 0.5 + near ) ) );
-
-                glm::mat4 dragMatrix = glm::translate( static_cast< float >( maxExtend ) *
-                                                       ( 1.0f / static_cast< float >( zoom ) ) *
-                                                       glm::vec3( drag.x, drag.y, 0.0 ) );
-
-                return moveToVisibleArea * scaleToFit * zoomMatrix * dragMatrix * orientation * rotationPointTranslate;
-            }
-
-            return glm::mat4();
+            return core::buildViewMatrix( sceneBB, orientation, zoom, drag );
         }
 
         glm::mat4 OGLWidget::buildProjectionMatrix( float near, float far, float aspect )
         {
-            return glm::ortho( -0.5f * aspect, 0.5f * aspect, -0.5f, 0.5f, near, far );
+            return core::buildProjectionMatrix( near, far, aspect );
         }
 
         di::core::State OGLWidget::getState() const
@@ -38,6 +38,7 @@
 
 #include <di/core/State.h>
 #include <di/core/BoundingBox.h>
+#include <di/gfx/FrameUniforms.h>
 #include <di/gfx/PixelData.h>
 #include <di/GfxTypes.h>
 
@@ -321,6 +322,11 @@ namespace di
              */
             bool m_forceReload = false;
 
+            /**
+             * Camera and viewport of the frame for all programs.
+             */
+            core::FrameUniforms m_frameUniforms;
+
             /**
              * Last time used for FPS counting.
              */
@@ -22,6 +22,8 @@
 //
 //---------------------------------------------------------------------------------------
 
+#include <string>
+
 #include <di/gui/events/Events.h>
 
 #include "CommandObserverEvent.h"
@@ -39,6 +41,15 @@ namespace di
         {
         }
 
+        CommandObserverEvent::CommandObserverEvent( SPtr< CommandObserverQt > observer, SPtr< di::core::Command > issuer, const std::string& stage,
+                                                    double fraction, double remaining ):
+            CommandObserverEvent( observer, issuer, PROGRESS )
+        {
+            m_progressStage = stage;
+            m_progressFraction = fraction;
+            m_progressRemaining = remaining;
+        }
+
         CommandObserverEvent::~CommandObserverEvent()
         {
             // do nothing
@@ -53,6 +64,21 @@ namespace di
         {
             return m_status;
         }
+
+        const std::string& CommandObserverEvent::getProgressStage() const
+        {
+            return m_progressStage;
+        }
+
+        double CommandObserverEvent::getProgressFraction() const
+        {
+            return m_progressFraction;
+        }
+
+        double CommandObserverEvent::getProgressRemaining() const
+        {
+            return m_progressRemaining;
+        }
     }
 }
 
@@ -25,6 +25,8 @@
 #ifndef DI_COMMANDOBSERVEREVENT_H
 #define DI_COMMANDOBSERVEREVENT_H
 
+#include <string>
+
 #include <QEvent>
 
 #include <di/core/Command.h>
@@ -53,7 +55,8 @@ namespace di
                 SUCCESS,
                 ABORT,
                 FAIL,
-                GENERIC
+                GENERIC,
+                PROGRESS
             };
 
             /**
@@ -65,6 +68,18 @@ namespace di
              */
             CommandObserverEvent( SPtr< CommandObserverQt > observer, SPtr< di::core::Command > issuer, CommandObserverStatus status );
 
+            /**
+             * Constructor for PROGRESS events.
+             *
+             * \param observer the observer that has sent the event.
+             * \param issuer the command that issued this event.
+             * \param stage the stage description
+             * \param fraction the progress of the stage in [0,1]
+             * \param remaining the estimated remaining time in seconds. Negative if unknown.
+             */
+            CommandObserverEvent( SPtr< CommandObserverQt > observer, SPtr< di::core::Command > issuer, const std::string& stage, double fraction,
+                                  double remaining );
+
             /**
              * Destructor. Does nothing.
              */
@@ -96,6 +111,27 @@ namespace di
              * \return the status
              */
             CommandObserverStatus getObserverStatus() const;
+
+            /**
+             * The stage description of a PROGRESS event.
+             *
+             * \return the stage
+             */
+            const std::string& getProgressStage() const;
+
+            /**
+             * The progress of a PROGRESS event in [0,1].
+             *
+             * \return the fraction
+             */
+            double getProgressFraction() const;
+
+            /**
+             * The estimated remaining time of a PROGRESS event.
+             *
+             * \return the time in seconds. Negative if unknown.
+             */
+            double getProgressRemaining() const;
         protected:
         private:
             /**
@@ -112,6 +148,21 @@ namespace di
              * The command that caused this notification.
              */
             SPtr< di::core::Command > m_issuer = nullptr;
+
+            /**
+             * Progress stage.
+             */
+            std::string m_progressStage = "";
+
+            /**
+             * Progress fraction.
+             */
+            double m_progressFraction = 0.0;
+
+            /**
+             * Estimated remaining time.
+             */
+            double m_progressRemaining = -1.0;
         };
     }
 }
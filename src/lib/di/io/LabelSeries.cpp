@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <di/core/Filesystem.h>
+
+#include "LabelSeries.h"
+
+#include <di/core/Logger.h>
+#define LogTag "io/LabelSeries"
+
+namespace di
+{
+    namespace io
+    {
+        LabelSeries::LabelSeries( const std::vector< std::string >& files, size_t prefetch ):
+            m_files( files ),
+            m_prefetch( prefetch )
+        {
+        }
+
+        LabelSeries::~LabelSeries()
+        {
+            // The futures of std::async wait for their task on destruction.
+        }
+
+        std::vector< std::string > LabelSeries::readList( const std::string& filename )
+        {
+            auto separator = filename.find_last_of( "/\\" );
+            auto directory = ( separator == std::string::npos ) ? std::string() : filename.substr( 0, separator + 1 );
+
+            std::vector< std::string > files;
+            std::istringstream list( di::core::readTextFile( filename ) );
+            std::string line;
+            while( std::getline( list, line ) )
+            {
+                // Allow Windows line endings and surrounding white space. Filenames may contain spaces.
+                auto first = line.find_first_not_of( " \t\r" );
+                if( ( first == std::string::npos ) || ( line[ first ] == '#' ) )
+                {
+                    continue;
+                }
+                auto file = line.substr( first, line.find_last_not_of( " \t\r" ) - first + 1 );
+                files.push_back( ( file[ 0 ] == '/' ) ? file : directory + file );
+            }
+            return files;
+        }
+
+        size_t LabelSeries::getNumFrames() const
+        {
+            return m_files.size();
+        }
+
+        const std::string& LabelSeries::getFile( size_t frame ) const
+        {
+            return m_files.at( frame );
+        }
+
+        void LabelSeries::load( size_t frame )
+        {
+            if( m_frames.count( frame ) )
+            {
+                return;
+            }
+
+            auto filename = m_files[ frame ];
+            m_frames[ frame ] = std::async( std::launch::async,
+                [ filename ]()
+                {
+                    // Readers are const and have no side-effects. Each load can use its own.
+                    auto data = RegionLabelReader().load( filename );
+                    return ConstSPtr< RegionLabelReader::DataSetType >( std::dynamic_pointer_cast< RegionLabelReader::DataSetType >( data ) );
+                }
+            ).share();
+        }
+
+        ConstSPtr< RegionLabelReader::DataSetType > LabelSeries::getFrame( size_t frame )
+        {
+            if( frame >= m_files.size() )
+            {
+                throw std::out_of_range( "There is no frame " + std::to_string( frame ) + " in a series of " +
+                                         std::to_string( m_files.size() ) + " frames." );
+            }
+
+            // Keep the requested frame and the next ones. Everything else is not needed anymore.
+            std::map< size_t, std::shared_future< ConstSPtr< RegionLabelReader::DataSetType > > > keep;
+            for( size_t ahead = 0; ahead <= std::min( m_prefetch, m_files.size() - 1 ); ++ahead )
+            {
+                auto next = ( frame + ahead ) % m_files.size();
+                load( next );
+                keep[ next ] = m_frames[ next ];
+            }
+            m_frames.swap( keep );
+
+            auto future = m_frames[ frame ];
+            if( future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+            {
+                ++m_prefetchHits;
+            }
+            else
+            {
+                LogD << "Waiting for frame " << frame << "." << LogEnd;
+            }
+            return future.get();
+        }
+
+        size_t LabelSeries::getPrefetchHits() const
+        {
+            return m_prefetchHits;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_LABELSERIES_H
+#define DI_LABELSERIES_H
+
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <di/Types.h>
+
+#include <di/io/RegionLabelReader.h>
+
+namespace di
+{
+    namespace io
+    {
+        /**
+         * A time series of label files, one per frame, like longitudinal or dynamic parcellations. Frames are loaded by background threads ahead
+         * of time, so playback does not wait for the disk. Only the requested frame and the prefetched frames are kept in memory. Not thread-safe.
+         * Use it from one thread, like the thread injecting the frames into the network.
+         */
+        class LabelSeries
+        {
+        public:
+            /**
+             * Create a series.
+             *
+             * \param files the label files, one per frame
+             * \param prefetch the number of frames to load ahead. Playback wraps around at the end.
+             */
+            explicit LabelSeries( const std::vector< std::string >& files, size_t prefetch = 2 );
+
+            /**
+             * Destructor. Waits for running loads.
+             */
+            virtual ~LabelSeries();
+
+            /**
+             * Read a list of label files. One file per line. Relative paths are relative to the list. Empty lines and lines starting with # are
+             * ignored.
+             *
+             * \param filename the list
+             *
+             * \return the files
+             *
+             * \throw std::invalid_argument if the list cannot be read.
+             */
+            static std::vector< std::string > readList( const std::string& filename );
+
+            /**
+             * The number of frames.
+             *
+             * \return the number of frames
+             */
+            size_t getNumFrames() const;
+
+            /**
+             * The file of a frame.
+             *
+             * \param frame the frame
+             *
+             * \return the filename
+             */
+            const std::string& getFile( size_t frame ) const;
+
+            /**
+             * Get the labels of a frame. Blocks if the frame is not loaded yet. Starts loading the following frames.
+             *
+             * \param frame the frame
+             *
+             * \return the labels
+             *
+             * \throw std::out_of_range if there is no such frame. Exceptions of the reader are forwarded.
+             */
+            ConstSPtr< RegionLabelReader::DataSetType > getFrame( size_t frame );
+
+            /**
+             * The number of frames that were already loaded when requested.
+             *
+             * \return the number of prefetch hits
+             */
+            size_t getPrefetchHits() const;
+
+        protected:
+        private:
+            /**
+             * Start loading a frame in the background, if not yet done.
+             *
+             * \param frame the frame
+             */
+            void load( size_t frame );
+
+            /**
+             * The files.
+             */
+            std::vector< std::string > m_files;
+
+            /**
+             * Number of frames to load ahead.
+             */
+            size_t m_prefetch;
+
+            /**
+             * The frames loaded or being loaded.
+             */
+            std::map< size_t, std::shared_future< ConstSPtr< RegionLabelReader::DataSetType > > > m_frames;
+
+            /**
+             * Number of prefetch hits.
+             */
+            size_t m_prefetchHits = 0;
+        };
+    }
+}
+
+#endif  // DI_LABELSERIES_H
@@ -0,0 +1,502 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <di/algorithms/DataInject.h>
+#include <di/core/Algorithm.h>
+#include <di/core/Visualization.h>
+#include <di/core/data/DataSetTypes.h>
+#include <di/io/RegionLabelReader.h>
+
+#include "Snapshot.h"
+
+#include <di/core/Logger.h>
+#define LogTag "io/Snapshot"
+
+namespace di
+{
+    namespace io
+    {
+        /**
+         * File magic including the format version.
+         */
+        static const char snapshotMagic[ 8 ] = { 'D', 'I', 'S', 'N', 'A', 'P', '0', '1' };
+
+        /**
+         * Written after the magic. Reads differently on machines with another byte order.
+         */
+        static const uint32_t snapshotByteOrder = 0x01020304;
+
+        /**
+         * Marks datasets without mesh.
+         */
+        static const uint64_t snapshotNoMesh = ~uint64_t( 0 );
+
+        /**
+         * The dataset types a snapshot can store.
+         */
+        enum class SnapshotDataType: uint32_t
+        {
+            TriangleDataSet = 1,
+            Labels = 2,
+            TriangleVectorField = 3
+        };
+
+        /**
+         * Write a value as raw bytes.
+         *
+         * \param stream the stream
+         * \param value the value
+         */
+        template< typename ValueType >
+        static void writeRaw( std::ostream& stream, const ValueType& value )  // NOLINT - streams are passed as non-const reference
+        {
+            static_assert( std::is_standard_layout< ValueType >::value, "Only plain data can be written as bytes." );
+            stream.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+        }
+
+        /**
+         * Write an array as size and raw bytes.
+         *
+         * \param stream the stream
+         * \param values the values
+         */
+        template< typename ValueType >
+        static void writeArray( std::ostream& stream, const std::vector< ValueType >& values )  // NOLINT - streams are passed as non-const reference
+        {
+            static_assert( std::is_standard_layout< ValueType >::value, "Only plain data can be written as bytes." );
+            writeRaw( stream, static_cast< uint64_t >( values.size() ) );
+            stream.write( reinterpret_cast< const char* >( values.data() ), values.size() * sizeof( ValueType ) );
+        }
+
+        /**
+         * Write a string as size and characters.
+         *
+         * \param stream the stream
+         * \param value the string
+         */
+        static void writeString( std::ostream& stream, const std::string& value )  // NOLINT - streams are passed as non-const reference
+        {
+            writeRaw( stream, static_cast< uint64_t >( value.size() ) );
+            stream.write( value.data(), value.size() );
+        }
+
+        /**
+         * Read a value written by \ref writeRaw.
+         *
+         * \param stream the stream
+         *
+         * \return the value
+         */
+        template< typename ValueType >
+        static ValueType readRaw( std::istream& stream )  // NOLINT - streams are passed as non-const reference
+        {
+            ValueType value;
+            stream.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) );
+            return value;
+        }
+
+        /**
+         * Number of bytes between the read position and the end of the stream.
+         *
+         * \param stream the stream
+         *
+         * \return the number of bytes. 0 if the stream failed.
+         */
+        static uint64_t remainingBytes( std::istream& stream )  // NOLINT - streams are passed as non-const reference
+        {
+            auto position = stream.tellg();
+            stream.seekg( 0, std::ios::end );
+            auto end = stream.tellg();
+            stream.seekg( position );
+            return ( stream && ( end > position ) ) ? static_cast< uint64_t >( end - position ) : 0;
+        }
+
+        /**
+         * Read a count of elements and check that the rest of the stream can hold them. Avoids huge allocations for corrupt files.
+         *
+         * \param stream the stream
+         * \param elementSize the minimal number of bytes per element in the stream
+         *
+         * \return the count
+         *
+         * \throw std::runtime_error if the count exceeds the rest of the stream.
+         */
+        static uint64_t readCount( std::istream& stream, uint64_t elementSize )  // NOLINT - streams are passed as non-const reference
+        {
+            auto count = readRaw< uint64_t >( stream );
+            if( !stream || ( count > remainingBytes( stream ) / elementSize ) )
+            {
+                throw std::runtime_error( "The snapshot is corrupt." );
+            }
+            return count;
+        }
+
+        /**
+         * Read an array written by \ref writeArray directly into its memory. The datasets and meshes own their arrays as std::vector. Mapping the
+         * file would thus not avoid this one read, as the vectors cannot use the mapped memory.
+         *
+         * \param stream the stream
+         *
+         * \return the values
+         *
+         * \throw std::runtime_error if the file is corrupt or ends early.
+         */
+        template< typename ValueType >
+        static SPtr< std::vector< ValueType > > readArray( std::istream& stream )  // NOLINT - streams are passed as non-const reference
+        {
+            auto values = std::make_shared< std::vector< ValueType > >( readCount( stream, sizeof( ValueType ) ) );
+            stream.read( reinterpret_cast< char* >( values->data() ), values->size() * sizeof( ValueType ) );
+            if( !stream )
+            {
+                throw std::runtime_error( "The snapshot is truncated." );
+            }
+            return values;
+        }
+
+        /**
+         * Read a string written by \ref writeString.
+         *
+         * \param stream the stream
+         *
+         * \return the string
+         */
+        static std::string readString( std::istream& stream )  // NOLINT - streams are passed as non-const reference
+        {
+            auto characters = readArray< char >( stream );
+            return std::string( characters->begin(), characters->end() );
+        }
+
+        void Snapshot::write( const std::string& filename, const di::core::State& state, const di::core::ProcessingNetwork& network )
+        {
+            // Collect the data of all connectors. Each dataset and mesh once.
+            std::vector< ConstSPtr< di::core::TriangleMesh > > meshes;
+            std::map< const di::core::TriangleMesh*, uint64_t > meshIndex;
+            std::vector< ConstSPtr< di::core::DataSetBase > > dataSets;
+            std::map< const di::core::ConnectorTransferable*, uint64_t > dataSetIndex;
+
+            auto addMesh = [ & ]( ConstSPtr< di::core::TriangleMesh > mesh )
+            {
+                if( !meshIndex.count( mesh.get() ) )
+                {
+                    meshIndex[ mesh.get() ] = meshes.size();
+                    meshes.push_back( mesh );
+                }
+            };
+
+            // Returns false for unsupported data.
+            auto addDataSet = [ & ]( ConstSPtr< di::core::ConnectorTransferable > data )
+            {
+                if( dataSetIndex.count( data.get() ) )
+                {
+                    return true;
+                }
+
+                auto triangles = std::dynamic_pointer_cast< const di::core::TriangleDataSet >( data );
+                auto vectors = std::dynamic_pointer_cast< const di::core::TriangleVectorField >( data );
+                auto labels = std::dynamic_pointer_cast< const RegionLabelReader::DataSetType >( data );
+                if( triangles )
+                {
+                    addMesh( triangles->getGrid() );
+                }
+                else if( vectors )
+                {
+                    addMesh( vectors->getGrid() );
+                }
+                else if( !labels )
+                {
+                    return false;
+                }
+
+                dataSetIndex[ data.get() ] = dataSets.size();
+                dataSets.push_back( std::dynamic_pointer_cast< const di::core::DataSetBase >( data ) );
+                return true;
+            };
+
+            std::vector< std::pair< std::string, std::vector< std::pair< bool, std::pair< std::string, uint64_t > > > > > algorithms;
+            network.visitAlgorithms(
+                [ & ]( ConstSPtr< di::core::Algorithm > algorithm )
+                {
+                    std::vector< std::pair< bool, std::pair< std::string, uint64_t > > > bindings;
+                    bool complete = true;
+                    auto bind = [ & ]( bool output, ConstSPtr< di::core::ConnectorBase > connector )
+                    {
+                        auto data = connector->getTransferable();
+                        if( !data )
+                        {
+                            return;
+                        }
+                        if( !addDataSet( data ) )
+                        {
+                            complete = false;
+                            return;
+                        }
+                        bindings.push_back( std::make_pair( output, std::make_pair( connector->getName(), dataSetIndex[ data.get() ] ) ) );
+                    };
+
+                    for( auto input : algorithm->getInputs() )
+                    {
+                        bind( false, input );
+                    }
+                    for( auto output : algorithm->getOutputs() )
+                    {
+                        bind( true, output );
+                    }
+
+                    // Algorithms with unsupported data run again after restoring. Restoring only parts of them would mix old and new data.
+                    if( complete )
+                    {
+                        algorithms.push_back( std::make_pair( algorithm->getRuntimeName(), bindings ) );
+                    }
+                    else
+                    {
+                        LogW << "Cannot store the data of \"" << algorithm->getRuntimeName() << "\". It will run again when restoring." << LogEnd;
+                    }
+                }
+            );
+
+            std::ofstream stream( filename, std::ios::binary );
+            if( !stream )
+            {
+                throw std::runtime_error( "Could not open \"" + filename + "\" for writing." );
+            }
+
+            stream.write( snapshotMagic, sizeof( snapshotMagic ) );
+            writeRaw( stream, snapshotByteOrder );
+            writeString( stream, state.toString() );
+
+            writeRaw( stream, static_cast< uint64_t >( meshes.size() ) );
+            for( const auto& mesh : meshes )
+            {
+                writeArray( stream, mesh->getVertices() );
+                writeArray( stream, mesh->getNormals() );
+                writeArray( stream, mesh->getTriangles() );
+            }
+
+            writeRaw( stream, static_cast< uint64_t >( dataSets.size() ) );
+            for( const auto& dataSet : dataSets )
+            {
+                auto triangles = std::dynamic_pointer_cast< const di::core::TriangleDataSet >( dataSet );
+                auto vectors = std::dynamic_pointer_cast< const di::core::TriangleVectorField >( dataSet );
+                auto labels = std::dynamic_pointer_cast< const RegionLabelReader::DataSetType >( dataSet );
+                if( triangles )
+                {
+                    writeRaw( stream, SnapshotDataType::TriangleDataSet );
+                    writeString( stream, dataSet->getName() );
+                    writeRaw( stream, meshIndex[ triangles->getGrid().get() ] );
+                    writeArray( stream, *triangles->getAttributes< 0 >() );
+                }
+                else if( vectors )
+                {
+                    writeRaw( stream, SnapshotDataType::TriangleVectorField );
+                    writeString( stream, dataSet->getName() );
+                    writeRaw( stream, meshIndex[ vectors->getGrid().get() ] );
+                    writeArray( stream, *vectors->getAttributes< 0 >() );
+                }
+                else
+                {
+                    writeRaw( stream, SnapshotDataType::Labels );
+                    writeString( stream, dataSet->getName() );
+                    writeRaw( stream, snapshotNoMesh );
+                    writeArray( stream, *labels->getAttributes< 0 >() );
+                }
+            }
+
+            writeRaw( stream, static_cast< uint64_t >( algorithms.size() ) );
+            for( const auto& algorithm : algorithms )
+            {
+                writeString( stream, algorithm.first );
+                writeRaw( stream, static_cast< uint64_t >( algorithm.second.size() ) );
+                for( const auto& binding : algorithm.second )
+                {
+                    writeRaw( stream, static_cast< uint8_t >( binding.first ) );
+                    writeString( stream, binding.second.first );
+                    writeRaw( stream, binding.second.second );
+                }
+            }
+
+            if( !stream )
+            {
+                throw std::runtime_error( "Could not write \"" + filename + "\"." );
+            }
+            LogI << "Wrote snapshot with " << meshes.size() << " meshes and " << dataSets.size() << " datasets." << LogEnd;
+        }
+
+        Snapshot::Snapshot( const std::string& filename )
+        {
+            std::ifstream stream( filename, std::ios::binary );
+            if( !stream )
+            {
+                throw std::runtime_error( "Could not open \"" + filename + "\" for reading." );
+            }
+
+            char magic[ sizeof( snapshotMagic ) ];
+            stream.read( magic, sizeof( magic ) );
+            if( !stream || ( std::memcmp( magic, snapshotMagic, sizeof( magic ) ) != 0 ) )
+            {
+                throw std::runtime_error( "\"" + filename + "\" is no snapshot or was written by another version." );
+            }
+            if( readRaw< uint32_t >( stream ) != snapshotByteOrder )
+            {
+                throw std::runtime_error( "\"" + filename + "\" was written on a machine with another byte order." );
+            }
+            m_state = di::core::State::fromString( readString( stream ) );
+
+            // Each mesh has at least three array sizes, each dataset at least its type, name size, mesh and array size.
+            std::vector< SPtr< di::core::TriangleMesh > > meshes( readCount( stream, 3 * sizeof( uint64_t ) ) );
+            for( auto& mesh : meshes )
+            {
+                // The arrays are read into their final memory and moved into the mesh.
+                mesh = std::make_shared< di::core::TriangleMesh >();
+                mesh->setVertices( std::move( *readArray< glm::vec3 >( stream ) ) );
+                mesh->setNormals( std::move( *readArray< glm::vec3 >( stream ) ) );
+                mesh->setTriangles( std::move( *readArray< glm::ivec3 >( stream ) ) );
+            }
+
+            std::vector< ConstSPtr< di::core::ConnectorTransferable > > dataSets(
+                readCount( stream, sizeof( SnapshotDataType ) + 3 * sizeof( uint64_t ) ) );
+            for( auto& dataSet : dataSets )
+            {
+                auto type = readRaw< SnapshotDataType >( stream );
+                auto name = readString( stream );
+                auto mesh = readRaw< uint64_t >( stream );
+                if( ( type != SnapshotDataType::Labels ) && ( mesh >= meshes.size() ) )
+                {
+                    throw std::runtime_error( "The snapshot \"" + filename + "\" is corrupt." );
+                }
+
+                switch( type )
+                {
+                    case SnapshotDataType::TriangleDataSet:
+                        dataSet = std::make_shared< di::core::TriangleDataSet >( name, meshes[ mesh ], readArray< glm::vec4 >( stream ) );
+                        break;
+                    case SnapshotDataType::TriangleVectorField:
+                        dataSet = std::make_shared< di::core::TriangleVectorField >( name, meshes[ mesh ], readArray< glm::vec3 >( stream ) );
+                        break;
+                    case SnapshotDataType::Labels:
+                        dataSet = std::make_shared< RegionLabelReader::DataSetType >( name, readArray< RegionLabelReader::value_type >( stream ) );
+                        break;
+                    default:
+                        throw std::runtime_error( "The snapshot \"" + filename + "\" is corrupt." );
+                }
+            }
+
+            auto numAlgorithms = readRaw< uint64_t >( stream );
+            for( uint64_t a = 0; stream && ( a < numAlgorithms ); ++a )
+            {
+                auto& bindings = m_algorithms[ readString( stream ) ];
+                auto numBindings = readRaw< uint64_t >( stream );
+                for( uint64_t b = 0; stream && ( b < numBindings ); ++b )
+                {
+                    Binding binding;
+                    binding.m_output = readRaw< uint8_t >( stream ) != 0;
+                    binding.m_connector = readString( stream );
+                    auto index = readRaw< uint64_t >( stream );
+                    if( index >= dataSets.size() )
+                    {
+                        throw std::runtime_error( "The snapshot \"" + filename + "\" is corrupt." );
+                    }
+                    binding.m_data = dataSets[ index ];
+                    bindings.push_back( binding );
+                }
+            }
+
+            if( !stream )
+            {
+                throw std::runtime_error( "The snapshot \"" + filename + "\" is truncated." );
+            }
+        }
+
+        Snapshot::~Snapshot()
+        {
+            // nothing to clean up so far
+        }
+
+        const di::core::State& Snapshot::getState() const
+        {
+            return m_state;
+        }
+
+        size_t Snapshot::restore( const di::core::ProcessingNetwork& network ) const
+        {
+            size_t restored = 0;
+            network.visitAlgorithms(
+                [ this, &restored ]( ConstSPtr< di::core::Algorithm > constAlgorithm )
+                {
+                    auto found = m_algorithms.find( constAlgorithm->getRuntimeName() );
+                    if( found == m_algorithms.end() )
+                    {
+                        return;
+                    }
+
+                    // Visiting is const. Restoring changes the connectors, which are not shared with other threads while the network is idle.
+                    auto algorithm = std::const_pointer_cast< di::core::Algorithm >( constAlgorithm );
+                    bool visualization = ( std::dynamic_pointer_cast< di::core::Visualization >( algorithm ) != nullptr );
+                    try
+                    {
+                        for( const auto& binding : found->second )
+                        {
+                            if( binding.m_output )
+                            {
+                                algorithm->restoreOutput( binding.m_connector, binding.m_data );
+
+                                // Injects keep their data to compare it against new data. Injecting again would otherwise update everything.
+                                auto inject = std::dynamic_pointer_cast< di::algorithms::DataInject >( algorithm );
+                                if( inject )
+                                {
+                                    inject->inject( binding.m_data );
+                                }
+                            }
+                            else if( !visualization )
+                            {
+                                algorithm->getInput( binding.m_connector )->setTransferable( binding.m_data );
+                            }
+                        }
+                    }
+                    catch( const std::invalid_argument& e )
+                    {
+                        LogW << "Cannot restore \"" << algorithm->getRuntimeName() << "\": " << e.what() << LogEnd;
+                        return;
+                    }
+
+                    if( !visualization )
+                    {
+                        algorithm->resetUpdateRequest();
+                    }
+                    ++restored;
+                }
+            );
+            return restored;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------------------
+//
+// Project: DirectionalityIndicator
+//
+// Copyright 2014-2015 Sebastian Eichelbaum (http://www.sebastian-eichelbaum.de)
+//           2014-2015 Max Planck Research Group "Neuroanatomy and Connectivity"
+//
+// This file is part of DirectionalityIndicator.
+//
+// DirectionalityIndicator is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectionalityIndicator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DirectionalityIndicator. If not, see <http://www.gnu.org/licenses/>.
+//
+//---------------------------------------------------------------------------------------
+
+#ifndef DI_SNAPSHOT_H
+#define DI_SNAPSHOT_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <di/core/ConnectorTransferable.h>
+#include <di/core/ProcessingNetwork.h>
+#include <di/core/State.h>
+
+#include <di/Types.h>
+
+namespace di
+{
+    namespace io
+    {
+        /**
+         * A binary snapshot of a session: the data at all inputs and outputs of the algorithms of a network and a state, like the project state with
+         * parameters and files. Restoring it sets the data directly, so nothing is parsed or computed again. Data shared between connectors is
+         * stored once and shared again after restoring.
+         *
+         * Supported are triangle meshes with colors, label arrays and vector fields on meshes. Algorithms with other data are not restored and thus
+         * run again. The file stores arrays in the byte order of the machine and is not meant for exchange between machines.
+         */
+        class Snapshot
+        {
+        public:
+            /**
+             * Write a snapshot of an idle network.
+             *
+             * \param filename the file
+             * \param state the state to store along the data
+             * \param network the network
+             *
+             * \throw std::runtime_error if the file cannot be written.
+             */
+            static void write( const std::string& filename, const di::core::State& state, const di::core::ProcessingNetwork& network );
+
+            /**
+             * Read a snapshot.
+             *
+             * \param filename the file
+             *
+             * \throw std::runtime_error if the file cannot be read or is no snapshot.
+             */
+            explicit Snapshot( const std::string& filename );
+
+            /**
+             * Destructor.
+             */
+            virtual ~Snapshot();
+
+            /**
+             * The state stored along the data.
+             *
+             * \return the state
+             */
+            const di::core::State& getState() const;
+
+            /**
+             * Restore the data of the algorithms with the same runtime names. Apply the parameters before. Restored algorithms are considered up
+             * to date and do not run until their parameters or inputs change. Visualizations only get their outputs restored. Their inputs get
+             * the data when the network runs, so they prepare it for rendering. The network must be idle.
+             *
+             * \param network the network
+             *
+             * \return the number of algorithms restored
+             */
+            size_t restore( const di::core::ProcessingNetwork& network ) const;
+
+        protected:
+        private:
+            /**
+             * A connector and its data.
+             */
+            struct Binding
+            {
+                /**
+                 * True for outputs.
+                 */
+                bool m_output;
+
+                /**
+                 * The connector name.
+                 */
+                std::string m_connector;
+
+                /**
+                 * The data.
+                 */
+                ConstSPtr< di::core::ConnectorTransferable > m_data;
+            };
+
+            /**
+             * The stored state.
+             */
+            di::core::State m_state;
+
+            /**
+             * The connectors of each algorithm, by runtime name. Only algorithms whose data could be stored completely.
+             */
+            std::map< std::string, std::vector< Binding > > m_algorithms;
+        };
+    }
+}
+
+#endif  // DI_SNAPSHOT_H